@@ -25,6 +25,7 @@ SOFTWARE.
 #include <Arduino.h>
 
 #include <clip.h>
+#include <clip_arduino.h>
 
 #include "cli.h"
 
@@ -41,10 +42,13 @@ SOFTWARE.
  *              Number of arguments passed by command line.
  * @param[in]   argv
  *              List or already parsed arguments.
+ * @param[in]   out
+ *              Buffered response writer.
  * @param[in]   context
  *              Generic context pointer passed to "clip_cmd_parse_line" function.
+ * @return      Command status (0 - success).
 */
-void cli_gpio_set_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+int cli_gpio_set_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
   // get argument 0 as uint
   uint8_t pin = argv[0].val_uint;
@@ -56,11 +60,14 @@ void cli_gpio_set_callback(const struct clip *self, const struct clip_command *c
   // write pin state
   digitalWrite(pin, state);
 
-  // print message
-  Serial.print("SET pin[");
-  Serial.print(pin);
-  Serial.print("] = ");
-  Serial.println(state);
+  // put response into buffer (it will be sent in one write)
+  clip_out_put_str(out, "SET pin[");
+  clip_out_put_u32(out, pin);
+  clip_out_put_str(out, "] = ");
+  clip_out_put_u32(out, state);
+  clip_out_put_str(out, "\r\n");
+
+  return 0;
 }
 
 /**
@@ -75,10 +82,13 @@ void cli_gpio_set_callback(const struct clip *self, const struct clip_command *c
  *              Number of arguments passed by command line.
  * @param[in]   argv
  *              List or already parsed arguments.
+ * @param[in]   out
+ *              Buffered response writer.
  * @param[in]   context
  *              Generic context pointer passed to "clip_cmd_parse_line" function.
+ * @return      Command status (0 - success).
 */
-void cli_gpio_get_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+int cli_gpio_get_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
   // get argument 0 as uint
   uint8_t pin = argv[0].val_uint;
@@ -88,11 +98,80 @@ void cli_gpio_get_callback(const struct clip *self, const struct clip_command *c
   // read pin state
   uint8_t state = digitalRead(pin);
 
-  // print message
-  Serial.print("GET pin[");
-  Serial.print(pin);
-  Serial.print("] = ");
-  Serial.println(state);
+  // put response into buffer (it will be sent in one write)
+  clip_out_put_str(out, "GET pin[");
+  clip_out_put_u32(out, pin);
+  clip_out_put_str(out, "] = ");
+  clip_out_put_u32(out, state);
+  clip_out_put_str(out, "\r\n");
+
+  return 0;
+}
+
+///< maximum time of waiting for pin state (in milliseconds)
+#define GPIO_WAIT_TIMEOUT_MS  5000
+
+///< completion token of pending "gpio wait" command
+static struct clip_pending g_gpio_wait_pending;
+///< pin watched by pending "gpio wait" command
+static uint8_t g_gpio_wait_pin;
+///< pin state expected by pending "gpio wait" command
+static uint8_t g_gpio_wait_state;
+///< start time of pending "gpio wait" command
+static unsigned long g_gpio_wait_start;
+
+/**
+ * @brief       Command handler for "gpio wait" command.
+ *              It doesn't block the loop, command is pending until pin state is reached (see gpio_wait_process).
+ *              It receive 2 arguments:
+ *              argv[0] is uint pin number
+ *              argv[1] is uint expected pin state
+ * @param[in]   self
+ *              Pointer to root clip handler descriptor.
+ * @param[in]   cmd
+ *              Pointer to command which invoked this callback.
+ * @param[in]   argc
+ *              Number of arguments passed by command line.
+ * @param[in]   argv
+ *              List or already parsed arguments.
+ * @param[in]   out
+ *              Buffered response writer.
+ * @param[in]   context
+ *              Generic context pointer passed to "clip_cmd_parse_line" function.
+ * @return      Command status (CLIP_COMMAND_PENDING - completed later).
+*/
+int cli_gpio_wait_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+  // only one wait at once
+  if (clip_cmd_is_pending(&g_gpio_wait_pending)) {
+    clip_out_put_str(out, "busy!\r\n");
+    return -1;
+  }
+
+  g_gpio_wait_pin = argv[0].val_uint;
+  g_gpio_wait_state = argv[1].val_uint;
+  g_gpio_wait_start = millis();
+  pinMode(g_gpio_wait_pin, INPUT);
+
+  // remember the command, response will be sent by gpio_wait_process
+  return clip_cmd_pend(&g_gpio_wait_pending, self, cmd, out, context);
+}
+
+/**
+ * @brief       Function used to complete pending "gpio wait" command (called from loop).
+*/
+void gpio_wait_process() {
+  if (!clip_cmd_is_pending(&g_gpio_wait_pending))
+    return;
+
+  if (digitalRead(g_gpio_wait_pin) == g_gpio_wait_state) {
+    clip_out_put_str(g_gpio_wait_pending.out, "WAIT pin[");
+    clip_out_put_u32(g_gpio_wait_pending.out, g_gpio_wait_pin);
+    clip_out_put_str(g_gpio_wait_pending.out, "] done\r\n");
+    clip_cmd_complete(&g_gpio_wait_pending, 0);
+  } else if (millis() - g_gpio_wait_start >= GPIO_WAIT_TIMEOUT_MS) {
+    clip_cmd_complete(&g_gpio_wait_pending, -1);
+  }
 }
 
 /**
@@ -107,16 +186,22 @@ void cli_gpio_get_callback(const struct clip *self, const struct clip_command *c
  *              Number of arguments passed by command line.
  * @param[in]   argv
  *              List or already parsed arguments.
+ * @param[in]   out
+ *              Buffered response writer.
  * @param[in]   context
  *              Generic context pointer passed to "clip_cmd_parse_line" function.
+ * @return      Command status (0 - success).
 */
-void cli_echo_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+int cli_echo_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
   // get argument 0 as string
   char *text = argv[0].val_str;
 
-  // print echo message
-  Serial.println(text);
+  // put echo message into response buffer
+  clip_out_put_str(out, text);
+  clip_out_put_str(out, "\r\n");
+
+  return 0;
 }
 
 /**
@@ -133,14 +218,14 @@ void cli_echo_callback(const struct clip *self, const struct clip_command *cmd,
 void cli_event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context)
 {
   switch (event) {
-  case CLIP_EVENT_HELP:
-    // print help message. here its just list of supported commands
+  case CLIP_EVENT_HELP: {
+    // print help message. here its list of supported commands with usage hints (streamed directly to Serial)
+    struct clip_out out;
+    clip_out_init(&out, NULL, 0, serial_sink, NULL);
     Serial.println("supported commands:");
-    while (*event_arg->help.commands != NULL) {
-      Serial.println((*(event_arg->help.commands))->name);
-      event_arg->help.commands++;
-    }
+    clip_help_put_commands(&out, event_arg->help.commands, 1);
     break;
+  }
 
   case CLIP_EVENT_COMMAND_NOT_FOUND:
     // print error when command was not found
@@ -155,10 +240,12 @@ void cli_event_callback(const struct clip *self, clip_event_t event, union clip_
     }
     break;
   
-  case CLIP_EVENT_CALL_COMMAND_CALLBACK:
-    // generic call command callback. not used in this implementation.
+  case CLIP_EVENT_COMMAND_COMPLETE:
+    // pending command finished. e.g. print error on timeout.
+    if (event_arg->command_complete.code != 0)
+      Serial.println("timeout!");
     break;
-  
+
   case CLIP_EVENT_ARGUMENTS_ERROR: {
     // error during parsing arguments. e.g. print command usage hint.
     static char usage[64];
@@ -176,41 +263,57 @@ void cli_event_callback(const struct clip *self, clip_event_t event, union clip_
 }
 
 /**
- * @brief       Function used to print prompt
+ * @brief       Response writer sink, sends whole buffered response to Serial.
+ * @param[in]   self
+ *              Pointer to response writer.
+ * @param[in]   data
+ *              Pointer to response data.
+ * @param[in]   size
+ *              Number of bytes.
 */
-void show_prompt() {
-  Serial.print("> ");
+void serial_sink(struct clip_out *self, const char *data, size_t size)
+{
+  Serial.write((const uint8_t*)data, size);
 }
 
+///< buffer for commands responses
+static char g_out_buf[64];
+///< buffered commands responses writer
+static struct clip_out g_out;
+
 /**
- * @brief       Function used to read line (until new line char) from Serial.
- * @param[in]   on_read_line
- *              Pointer to function which will be called on new line.
+ * @brief       Function used to print prompt
 */
-void read_line(void (*on_read_line)(char*)) {
-  static String buf;
-  char* ret = nullptr;
-  if (Serial.available() > 0) {
-    char ch = Serial.read();
-    if (ch == '\n' || ch == '\r') {
-      Serial.println();
-      if (buf.length() != 0) {
-        on_read_line(buf.c_str());
-        buf = "";
-      }
-      show_prompt();
-    } else {
-      Serial.print(ch);
-      buf += ch;
-    }
-  }
+void show_prompt() {
+  Serial.print("> ");
 }
 
+///< command line buffer (up to 63 chars)
+static char g_line_buf[64];
+///< unbuffered writer for echo of typed chars
+static struct clip_out g_echo;
+///< fixed-buffer line reader (no String concatenation, no heap)
+static struct clip_reader g_reader;
+
+#if CLIP_CONFIG_EDITOR_ENABLED
+///< ring buffer for lines history (recalled with up/down arrow keys)
+static char g_history_buf[128];
+///< lines history of line editor (library built with -DCLIP_CONFIG_EDITOR_ENABLED=1)
+static struct clip_history g_history;
+#endif
+
 /**
  * @brief       Setup function.
 */
 void setup() {
   Serial.begin(9600);
+  clip_out_init(&g_out, g_out_buf, sizeof(g_out_buf), serial_sink, NULL);
+  clip_out_init(&g_echo, NULL, 0, serial_sink, NULL);
+  clip_reader_init(&g_reader, g_line_buf, sizeof(g_line_buf), &g_echo);
+#if CLIP_CONFIG_EDITOR_ENABLED
+  clip_history_init(&g_history, g_history_buf, sizeof(g_history_buf));
+  clip_reader_set_history(&g_reader, &g_history);
+#endif
   show_prompt();
 }
 
@@ -218,9 +321,10 @@ void setup() {
  * @brief       Main loop function.
 */
 void loop() {
-  // async read line from Serial 
-  read_line([](char *cmd_line) {
-    // feed CLIP with command line
-    clip_cmd_parse_line(&g_cli_clip, NULL, cmd_line, NULL);
-  });
+  // drain all received chars (with echo and backspace), dispatch complete lines.
+  // response is flushed once after every command
+  if (clip_reader_poll_stream(&g_reader, Serial, &g_cli_clip, &g_out, NULL) > 0)
+    show_prompt();
+  // complete pending commands (loop is never blocked by them)
+  gpio_wait_process();
 }
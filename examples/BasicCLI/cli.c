@@ -25,20 +25,24 @@ SOFTWARE.
 #include "cli.h"
 
 CLIP_DEF_ROOT_COMMAND(g_cli_gpio_cmd, "gpio", "control gpio", NULL)
-  CLIP_DEF_COMMAND("get", "get pin state", cli_gpio_get_callback) CLIP_DEF_WITH_ARGS()
+  CLIP_DEF_COMMAND_WITH_USAGE("get", "get pin state", cli_gpio_get_callback, CLIP_USAGE_ARG("pin", UINT)) CLIP_DEF_WITH_ARGS()
     CLIP_DEF_ARGUMENT("pin", "pin number", CLIP_ARG_TYPE_UINT)
   CLIP_DEF_COMMAND_END_WITH_ARGS()
-  CLIP_DEF_COMMAND("set", "set pin state", cli_gpio_set_callback) CLIP_DEF_WITH_ARGS()
+  CLIP_DEF_COMMAND_WITH_USAGE("set", "set pin state", cli_gpio_set_callback, CLIP_USAGE_ARG("pin", UINT) CLIP_USAGE_ARG("state", UINT)) CLIP_DEF_WITH_ARGS()
     CLIP_DEF_ARGUMENT("pin", "pin number", CLIP_ARG_TYPE_UINT)
     CLIP_DEF_ARGUMENT("state", "pin state", CLIP_ARG_TYPE_UINT)
   CLIP_DEF_COMMAND_END_WITH_ARGS()
+  CLIP_DEF_COMMAND_WITH_USAGE("wait", "wait for pin state", cli_gpio_wait_callback, CLIP_USAGE_ARG("pin", UINT) CLIP_USAGE_ARG("state", UINT)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("pin", "pin number", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_ARGUMENT("state", "expected pin state", CLIP_ARG_TYPE_UINT)
+  CLIP_DEF_COMMAND_END_WITH_ARGS()
 CLIP_DEF_ROOT_COMMAND_END()
 
-CLIP_DEF_ROOT_COMMAND(g_cli_echo_cmd, "echo", "echo command", cli_echo_callback) CLIP_DEF_WITH_ARGS()
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_cli_echo_cmd, "echo", "echo command", cli_echo_callback, CLIP_USAGE_ARG("text", STRING)) CLIP_DEF_WITH_ARGS()
   CLIP_DEF_ARGUMENT("text", "text to print", CLIP_ARG_TYPE_STRING)
 CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
 
-CLIP_DEF_ROOT(g_cli_clip, NULL, cli_event_callback)
+CLIP_DEF_ROOT_EX(g_cli_clip, NULL, cli_event_callback, NULL, CLIP_EVENT_MASK(CLIP_EVENT_CALL_COMMAND_CALLBACK))
   CLIP_DEF_ADD_ROOT_COMMAND(&g_cli_gpio_cmd)
   CLIP_DEF_ADD_ROOT_COMMAND(&g_cli_echo_cmd)
 CLIP_DEF_ROOT_END()
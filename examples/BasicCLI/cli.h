@@ -33,10 +33,11 @@ extern "C" {
 ///< root clip handler descriptor
 extern const struct clip g_cli_clip;
 
-void cli_gpio_set_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context);
-void cli_gpio_get_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context);
+int cli_gpio_set_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
+int cli_gpio_get_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
+int cli_gpio_wait_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
 
-void cli_echo_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context);
+int cli_echo_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
 
 void cli_event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context);
 
@@ -35,8 +35,14 @@ SOFTWARE.
 #define COLOR_YELLOW    "\x1B[33m"
 #define COLOR_RED       "\x1B[31m"
 
-void print_args(const char *tag, size_t argc, struct clip_arg_value argv[]);
-void print_mem_dump(uint32_t addr, size_t size, uint8_t *data);
+void out_printf(struct clip_out *out, const char *fmt, ...);
+void stdout_sink(struct clip_out *self, const char *data, size_t size);
+void print_args(struct clip_out *out, const char *tag, size_t argc, struct clip_arg_value argv[]);
+void print_mem_dump(struct clip_out *out, uint32_t addr, size_t size, uint8_t *data);
+bool adc_process(void);
+bool trace_init(const struct clip *clip);
+bool schema_init(const struct clip *clip);
+bool complete_init(const struct clip *clip, struct clip_reader *reader);
 
 struct app_context {
     bool exit_app;
@@ -28,43 +28,89 @@ SOFTWARE.
 #include <time.h>
 #include <stdlib.h>
 
-static void adc_read_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+#define ADC_CONVERSION_TIME_MS  300
+
+static struct clip_pending g_adc_pending;
+static uint32_t g_adc_channel;
+static struct timespec g_adc_start;
+
+static int adc_read_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
+
+    if (clip_cmd_is_pending(&g_adc_pending)) {
+        clip_out_put_str(out, "busy...\n");
+        return -1;
+    }
+
+    /* start slow conversion and return immediately, result is reported by adc_process */
+    g_adc_channel = argv[0].val_uint;
+    timespec_get(&g_adc_start, TIME_UTC);
+
+    clip_out_put_str(out, "converting...\n");
+
+    return clip_cmd_pend(&g_adc_pending, self, cmd, out, context);
+}
+
+bool adc_process(void)
+{
+    if (clip_cmd_is_pending(&g_adc_pending) == false)
+        return false;
+
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    long elapsed_ms = (now.tv_sec - g_adc_start.tv_sec) * 1000L + (now.tv_nsec - g_adc_start.tv_nsec) / 1000000L;
+    if (elapsed_ms < ADC_CONVERSION_TIME_MS)
+        return false;
 
     uint32_t val = rand() % 4096;
+    struct clip_out *out = g_adc_pending.out;
+
+    clip_out_put_str(out, "adc[");
+    clip_out_put_u32(out, g_adc_channel);
+    clip_out_put_str(out, "] = ");
+    clip_out_put_u32(out, val);
+    clip_out_put_str(out, "\n");
+
+    clip_cmd_complete(&g_adc_pending, 0);
 
-    printf("adc[%u] = %u\n", argv[0].val_uint, val);
+    return true;
 }
 
-static void adc_set_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int adc_set_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
 
-    printf("vref = %.03f\n", argv[0].val_float);
+    out_printf(out, "vref = %.03f\n", argv[0].val_float);
+
+    return 0;
 }
 
-static void adc_start_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int adc_start_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
+
+    clip_out_put_str(out, "started...\n");
 
-    printf("started...\n");
+    return 0;
 }
 
-static void adc_stop_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int adc_stop_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
+
+    clip_out_put_str(out, "stopped...\n");
 
-    printf("stopped...\n");
+    return 0;
 }
 
 CLIP_DEF_ROOT_COMMAND(g_adc_cmd, "adc", "control adc driver", NULL)
 
-    CLIP_DEF_COMMAND("read", "read input", adc_read_callback) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_COMMAND_WITH_USAGE("read", "read input", adc_read_callback, CLIP_USAGE_ARG("channel", UINT)) CLIP_DEF_WITH_ARGS()
         CLIP_DEF_ARGUMENT("channel", "channel number", CLIP_ARG_TYPE_UINT)
     CLIP_DEF_COMMAND_END_WITH_ARGS()
 
-    CLIP_DEF_COMMAND("set", "set reference", adc_set_callback) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_COMMAND_WITH_USAGE("set", "set reference", adc_set_callback, CLIP_USAGE_ARG("vref", FLOAT)) CLIP_DEF_WITH_ARGS()
         CLIP_DEF_ARGUMENT("vref", "voltage reference", CLIP_ARG_TYPE_FLOAT)
     CLIP_DEF_COMMAND_END_WITH_ARGS()
 
@@ -72,3 +118,4 @@ CLIP_DEF_ROOT_COMMAND(g_adc_cmd, "adc", "control adc driver", NULL)
     CLIP_DEF_COMMAND("stop", "stop sampling", adc_stop_callback) CLIP_DEF_COMMAND_END()
 
 CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_adc_cmd)
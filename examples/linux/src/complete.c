@@ -0,0 +1,48 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+#include "main.h"
+
+#define COMPLETE_INDEX_SIZE     64
+#define COMPLETE_NAMES_SIZE     64
+
+static struct clip_index_entry g_complete_index_entries[COMPLETE_INDEX_SIZE];
+static struct clip_index g_complete_index;
+static const struct clip_command *g_complete_names[COMPLETE_NAMES_SIZE];
+static struct clip_complete_range g_complete_ranges[COMPLETE_INDEX_SIZE];
+static struct clip_complete g_complete;
+
+bool complete_init(const struct clip *clip, struct clip_reader *reader)
+{
+    if (clip_index_init(&g_complete_index, clip, g_complete_index_entries, COMPLETE_INDEX_SIZE) == false)
+        return false;
+
+    /* subcommands lists are sorted once, tab key finds candidates with binary search */
+    if (clip_complete_init(&g_complete, &g_complete_index, g_complete_names, COMPLETE_NAMES_SIZE, g_complete_ranges, COMPLETE_INDEX_SIZE) == false)
+        return false;
+
+    clip_reader_set_complete(reader, &g_complete);
+    return true;
+}
@@ -25,13 +25,16 @@ SOFTWARE.
 #include "clip.h"
 #include "main.h"
 
-static void exit_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int exit_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
 
     struct app_context *ctx = (struct app_context *)self->context;
     ctx->exit_app = 1;
+
+    return 0;
 }
 
 CLIP_DEF_ROOT_COMMAND(g_exit_cmd, "exit", "application exit", exit_callback)
 CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_exit_cmd)
@@ -28,71 +28,82 @@ SOFTWARE.
 #include <time.h>
 #include <stdlib.h>
 
-static void gpio_set_pin_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int gpio_set_pin_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
 
-    printf("pin[%u] = %u\n", argv[0].val_uint, argv[1].val_uint);
+    out_printf(out, "pin[%u] = %u\n", argv[0].val_uint, argv[1].val_uint);
+
+    return 0;
 }
 
-static void gpio_set_reg_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int gpio_set_reg_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
+
+    out_printf(out, "reg[0x%08X] = 0x%08X\n", argv[0].val_uint, argv[1].val_uint);
 
-    printf("reg[0x%08X] = 0x%08X\n", argv[0].val_uint, argv[1].val_uint);
+    return 0;
 }
 
-static void gpio_get_pin_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int gpio_get_pin_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
 
     uint32_t val = rand() % 2;
 
-    printf("pin[%u] = %u\n", argv[0].val_uint, val);
+    out_printf(out, "pin[%u] = %u\n", argv[0].val_uint, val);
+
+    return 0;
 }
 
-static void gpio_get_reg_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int gpio_get_reg_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
 
     uint32_t val = rand() % 0x100000000;
 
-    printf("reg[0x%08X] = 0x%08X\n", argv[0].val_uint, val);
+    out_printf(out, "reg[0x%08X] = 0x%08X\n", argv[0].val_uint, val);
+
+    return 0;
 }
 
-static void gpio_test_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int gpio_test_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
+
+    return 0;
 }
 
 CLIP_DEF_ROOT_COMMAND(g_gpio_cmd, "gpio", "control gpio", NULL)
 
     CLIP_DEF_COMMAND("get", "get methods", NULL)
-        CLIP_DEF_COMMAND("pin", "get pin state", gpio_get_pin_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_COMMAND_WITH_USAGE("pin", "get pin state", gpio_get_pin_callback, CLIP_USAGE_ARG("pin", UINT)) CLIP_DEF_WITH_ARGS()
             CLIP_DEF_ARGUMENT("pin", "pin number", CLIP_ARG_TYPE_UINT)
         CLIP_DEF_COMMAND_END_WITH_ARGS()
 
-        CLIP_DEF_COMMAND("reg", "get register value", gpio_get_reg_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_COMMAND_WITH_USAGE("reg", "get register value", gpio_get_reg_callback, CLIP_USAGE_ARG("address", UINT)) CLIP_DEF_WITH_ARGS()
             CLIP_DEF_ARGUMENT("address", "register address", CLIP_ARG_TYPE_UINT)
         CLIP_DEF_COMMAND_END_WITH_ARGS()
     CLIP_DEF_COMMAND_END()
 
     CLIP_DEF_COMMAND("set", "set methods", NULL)
-        CLIP_DEF_COMMAND("pin", "set pin state", gpio_set_pin_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_COMMAND_WITH_USAGE("pin", "set pin state", gpio_set_pin_callback, CLIP_USAGE_ARG("pin", UINT) CLIP_USAGE_ARG("state", UINT)) CLIP_DEF_WITH_ARGS()
             CLIP_DEF_ARGUMENT("pin", "pin number", CLIP_ARG_TYPE_UINT)
             CLIP_DEF_ARGUMENT("state", "pin state", CLIP_ARG_TYPE_UINT)
         CLIP_DEF_COMMAND_END_WITH_ARGS()
 
-        CLIP_DEF_COMMAND("reg", "set register value", gpio_set_reg_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_COMMAND_WITH_USAGE("reg", "set register value", gpio_set_reg_callback, CLIP_USAGE_ARG("address", UINT) CLIP_USAGE_ARG("value", UINT)) CLIP_DEF_WITH_ARGS()
             CLIP_DEF_ARGUMENT("address", "register address", CLIP_ARG_TYPE_UINT)
             CLIP_DEF_ARGUMENT("value", "register value", CLIP_ARG_TYPE_UINT)
         CLIP_DEF_COMMAND_END_WITH_ARGS()
 
     CLIP_DEF_COMMAND_END()
 
-    CLIP_DEF_COMMAND("test", "test method", gpio_test_callback) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_COMMAND_WITH_USAGE("test", "test method", gpio_test_callback, CLIP_USAGE_ARG("type", UINT) CLIP_USAGE_OPT_ARG("mode", UINT)) CLIP_DEF_WITH_ARGS()
         CLIP_DEF_ARGUMENT("type", "test type", CLIP_ARG_TYPE_UINT)
         CLIP_DEF_OPT_ARGUMENT("mode", "optional test mode", CLIP_ARG_TYPE_UINT)
     CLIP_DEF_COMMAND_END_WITH_ARGS()
 
 CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_gpio_cmd)
@@ -26,6 +26,10 @@ SOFTWARE.
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#include <termios.h>
 
 #include "clip.h"
 #include "main.h"
@@ -33,14 +37,15 @@ SOFTWARE.
 static void event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context)
 {
     switch (event) {
-    case CLIP_EVENT_HELP:
+    case CLIP_EVENT_HELP: {
+        /* help text is streamed to stdout, whole subtree (with usage hints) is written without any buffer */
+        struct clip_out out;
+        clip_out_init(&out, NULL, 0, stdout_sink, NULL);
         printf(COLOR_YELLOW "supported commands for <%s>:\n", (event_arg->help.cmd != NULL) ? event_arg->help.cmd->name : ".");
-        while (*event_arg->help.commands != NULL) {
-            printf("%s - %s\n", (*event_arg->help.commands)->name, (*event_arg->help.commands)->description);
-            event_arg->help.commands++;
-        }
+        clip_help_put_commands(&out, event_arg->help.commands, CLIP_HELP_DEPTH_ALL);
         printf(COLOR_RESET);
         break;
+    }
 
     case CLIP_EVENT_COMMAND_NOT_FOUND:        
         printf(COLOR_RED);
@@ -60,6 +65,11 @@ static void event_callback(const struct clip *self, clip_event_t event, union cl
         printf("call command callback for <%s> with args <%s>\n", event_arg->call_command_callback.cmd->name, event_arg->call_command_callback.cmd_line);
         break;
     
+    case CLIP_EVENT_COMMAND_COMPLETE:
+        if (event_arg->command_complete.code != 0)
+            printf(COLOR_RED "<%s> failed: %d\n" COLOR_RESET, event_arg->command_complete.cmd->name, event_arg->command_complete.code);
+        break;
+
     case CLIP_EVENT_ARGUMENTS_ERROR: {
         char buf[128];
         clip_utils_arg_get_command_usage_string(buf, sizeof(buf), event_arg->arguments_error.cmd);
@@ -73,42 +83,149 @@ static void event_callback(const struct clip *self, clip_event_t event, union cl
         break;
     }
 }
-extern const struct clip_command g_adc_cmd;
-extern const struct clip_command g_gpio_cmd;
-extern const struct clip_command g_mem_cmd;
-extern const struct clip_command g_exit_cmd;
+extern struct clip_trace g_trace;
 
 static struct app_context g_app_context;
 
-CLIP_DEF_ROOT(g_clip, &g_app_context, event_callback)
-    CLIP_DEF_ADD_ROOT_COMMAND(&g_adc_cmd)
-    CLIP_DEF_ADD_ROOT_COMMAND(&g_gpio_cmd)
-    CLIP_DEF_ADD_ROOT_COMMAND(&g_mem_cmd)
-    CLIP_DEF_ADD_ROOT_COMMAND(&g_exit_cmd)
-CLIP_DEF_ROOT_END()
+/* root commands are registered by modules (CLIP_REGISTER_ROOT_COMMAND) and collected by clip_section_init */
+static struct clip g_clip = {
+    .context = &g_app_context,
+    .event_callback = event_callback,
+    .trace = &g_trace,
+};
+
+static struct termios g_term_saved;
+
+static void term_restore(void)
+{
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &g_term_saved);
+}
+
+static void term_signal(int sig)
+{
+    term_restore();
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static bool term_raw_init(void)
+{
+    /* line editing only for interactive terminal (piped input is fed directly to stream reader) */
+    if (isatty(STDIN_FILENO) == 0 || tcgetattr(STDIN_FILENO, &g_term_saved) != 0)
+        return false;
+
+    /* chars are passed without waiting for new line, and echoed by line editor */
+    struct termios term = g_term_saved;
+    term.c_lflag &= ~(ICANON | ECHO);
+    term.c_cc[VMIN] = 1;
+    term.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &term) != 0)
+        return false;
+
+    atexit(term_restore);
+    signal(SIGINT, term_signal);
+    signal(SIGTERM, term_signal);
+    return true;
+}
 
 int main(int argc, char *argv[])
 {
     /* allocate buffer for command line */
     char buf[128];
+    /* allocate buffer for streamed arguments data */
+    uint8_t chunk[16];
+    /* allocate buffer for input data */
+    char input[64];
+    /* allocate buffer for commands responses */
+    char output[512];
+    /* command line stream reader */
+    struct clip_stream stream;
+    /* buffered commands responses writer */
+    struct clip_out out;
+    /* buffer for edited line and its echo */
+    char line[128];
+    char echo_buf[64];
+    /* buffer for lines history (recalled with up/down arrow keys) */
+    char history_buf[1024];
+    /* line editor with history */
+    struct clip_reader reader;
+    struct clip_out echo;
+    struct clip_history history;
 
     /* init random */
     srand(time(0));
 
+    /* collect registered root commands, sorted by names for binary search lookup */
+    if (clip_section_init(&g_clip) == false)
+        return 1;
+
+    /* init trace ring buffer (dispatch events recorded when library is built with CLIP_CONFIG_TRACE_ENABLED) */
+    if (trace_init(&g_clip) == false)
+        return 1;
+
+    /* init commands index of schema (every command is written with its ID) */
+    if (schema_init(&g_clip) == false)
+        return 1;
+
+    /* init stream reader */
+    clip_stream_init(&stream, &g_clip, buf, sizeof(buf), chunk, sizeof(chunk));
+
+    /* init responses writer, every response goes to stdout in one write */
+    clip_out_init(&out, output, sizeof(output), stdout_sink, NULL);
+    stream.out = &out;
+
+    /* init line editor with history and tab completion (library is built with CLIP_CONFIG_EDITOR_ENABLED for this example) */
+    bool editor = term_raw_init();
+    clip_out_init(&echo, echo_buf, sizeof(echo_buf), stdout_sink, NULL);
+    clip_history_init(&history, history_buf, sizeof(history_buf));
+    clip_reader_init(&reader, line, sizeof(line), &echo);
+    clip_reader_set_history(&reader, &history);
+    reader.prompt = "> ";
+    if (complete_init(&g_clip, &reader) == false)
+        return 1;
+
+    /* print prompt */
+    printf("> ");
+
     do {
-        /* print prompt */
-        printf("> ");
-        /* read line from stdin */
-        if (fgets(buf, sizeof(buf), stdin) == NULL)
+        /* complete pending commands (e.g. slow adc conversion) */
+        if (adc_process())
+            printf("> ");
+
+        /* wait for input data, but not longer than 10ms (pending commands still need processing) */
+        struct pollfd fds = {.fd = STDIN_FILENO, .events = POLLIN};
+        if (poll(&fds, 1, 10) <= 0)
+            continue;
+
+        /* read input data from stdin (long lines are read in many parts) */
+        ssize_t len = read(STDIN_FILENO, input, sizeof(input));
+        if (len <= 0)
             break;
-        /* remove new line character at the end, ensure it will be zero-ended */
-        buf[strlen(buf) - 1] = '\0';
-        /* do not feed clip with empty command line */
-        if (strlen(buf) == 0)
+
+        /* edit lines typed in terminal, then feed stream reader with every accepted line */
+        if (editor) {
+            for (ssize_t i = 0; i < len && g_app_context.exit_app == 0; i++) {
+                char *edited = clip_reader_put_char(&reader, input[i]);
+                if (edited == NULL)
+                    continue;
+                clip_out_flush(&echo);
+                clip_stream_feed(&stream, edited, strlen(edited), NULL);
+                clip_stream_feed(&stream, "\n", 1, NULL);
+                if (g_app_context.exit_app == 0) {
+                    printf("> ");
+                    fflush(stdout);
+                }
+            }
+            clip_out_flush(&echo);
             continue;
+        }
+
+        /* feed clip with input data, lines are parsed as soon as they are complete */
+        clip_stream_feed(&stream, input, len, NULL);
 
-        /* parse command line */
-        clip_cmd_parse_line(&g_clip, NULL, buf, NULL);
+        /* print prompt after every complete line */
+        if (input[len - 1] == '\n' && g_app_context.exit_app == 0)
+            printf("> ");
 
         /* repeat all above until application exit */
     } while (g_app_context.exit_app == 0);
@@ -25,19 +25,21 @@ SOFTWARE.
 #include "clip.h"
 #include "main.h"
 
-static void mem_read_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int mem_read_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
 
     uint32_t addr = argv[0].val_uint;
     uint32_t size = argv[1].val_uint;
 
-    print_mem_dump(addr, size, NULL);
+    print_mem_dump(out, addr, size, NULL);
+
+    return 0;
 }
 
-static void mem_write_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+static int mem_write_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    print_args(__func__, argc, argv);
+    print_args(out, __func__, argc, argv);
 
     uint32_t addr = argv[0].val_uint;
     clip_hexarray_t hexarray = argv[1].val_hexarray;
@@ -45,19 +47,62 @@ static void mem_write_callback(const struct clip *self, const struct clip_comman
     uint8_t *data = NULL;
     size_t size = clip_utils_arg_unpack_hexarray(&data, hexarray);
 
-    print_mem_dump(addr, size, data);
+    print_mem_dump(out, addr, size, data);
+
+    return 0;
+}
+
+static uint32_t g_flash_addr;
+
+static void mem_flash_begin_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    print_args(out, __func__, argc, argv);
+
+    g_flash_addr = argv[0].val_uint;
+}
+
+static void mem_flash_data_callback(const struct clip *self, const struct clip_command *cmd, const uint8_t *data, size_t size, struct clip_out *out, void *context)
+{
+    print_mem_dump(out, g_flash_addr, size, (uint8_t*)data);
+
+    g_flash_addr += size;
+}
+
+static void mem_flash_end_callback(const struct clip *self, const struct clip_command *cmd, size_t size, clip_arg_error_t error, struct clip_out *out, void *context)
+{
+    if (error != CLIP_ARG_ERROR_NO_ERROR) {
+        clip_out_put_str(out, COLOR_RED "flash error: ");
+        clip_out_put_str(out, clip_utils_arg_get_error_string(error));
+        clip_out_put_str(out, "\n" COLOR_RESET);
+        return;
+    }
+    clip_out_put_str(out, "flashed ");
+    clip_out_put_u32(out, size);
+    clip_out_put_str(out, " bytes\n");
 }
 
+static const struct clip_arg_stream g_mem_flash_stream = {
+    .begin = mem_flash_begin_callback,
+    .data = mem_flash_data_callback,
+    .end = mem_flash_end_callback,
+};
+
 CLIP_DEF_ROOT_COMMAND(g_mem_cmd, "mem", "memory driver", NULL)
 
-    CLIP_DEF_COMMAND("write", "write data to memory", mem_write_callback) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_COMMAND_WITH_USAGE("write", "write data to memory", mem_write_callback, CLIP_USAGE_ARG("address", UINT) CLIP_USAGE_ARG("data", HEXARRAY)) CLIP_DEF_WITH_ARGS()
         CLIP_DEF_ARGUMENT("address", "address to write", CLIP_ARG_TYPE_UINT)
         CLIP_DEF_ARGUMENT("data", "binary data to write", CLIP_ARG_TYPE_HEXARRAY)
     CLIP_DEF_COMMAND_END_WITH_ARGS()
 
-    CLIP_DEF_COMMAND("read", "read data from memory", mem_read_callback) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_COMMAND_WITH_USAGE("read", "read data from memory", mem_read_callback, CLIP_USAGE_ARG("address", UINT) CLIP_USAGE_ARG("size", UINT)) CLIP_DEF_WITH_ARGS()
         CLIP_DEF_ARGUMENT("address", "address to read", CLIP_ARG_TYPE_UINT)
         CLIP_DEF_ARGUMENT("size", "number of bytes to read", CLIP_ARG_TYPE_UINT)
     CLIP_DEF_COMMAND_END_WITH_ARGS()
 
+    CLIP_DEF_COMMAND_WITH_USAGE("flash", "write streamed data to memory", NULL, CLIP_USAGE_ARG("address", UINT) CLIP_USAGE_ARG("data", HEXSTREAM)) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("address", "address to write", CLIP_ARG_TYPE_UINT)
+        CLIP_DEF_STREAM_ARGUMENT("data", "binary data to write (any length)", &g_mem_flash_stream)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+
 CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_mem_cmd)
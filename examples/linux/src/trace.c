@@ -0,0 +1,86 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+#include "main.h"
+
+#include <time.h>
+
+#define TRACE_INDEX_SIZE    64
+#define TRACE_RECORDS_NUM   256
+
+static struct clip_index_entry g_trace_index_entries[TRACE_INDEX_SIZE];
+static struct clip_index g_trace_index;
+static struct clip_trace_record g_trace_records[TRACE_RECORDS_NUM];
+
+struct clip_trace g_trace;
+
+static uint32_t trace_time_us(void *context)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (uint32_t)(now.tv_sec * 1000000L + now.tv_nsec / 1000L);
+}
+
+static void trace_file_sink(struct clip_out *self, const char *data, size_t size)
+{
+    fwrite(data, 1, size, (FILE*)self->context);
+}
+
+bool trace_init(const struct clip *clip)
+{
+    if (clip_index_init(&g_trace_index, clip, g_trace_index_entries, TRACE_INDEX_SIZE) == false)
+        return false;
+
+    clip_trace_init(&g_trace, &g_trace_index, g_trace_records, TRACE_RECORDS_NUM, trace_time_us, NULL);
+    return true;
+}
+
+static int trace_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    print_args(out, __func__, argc, argv);
+
+    FILE *file = fopen(argv[0].val_str, "wb");
+    if (file == NULL) {
+        clip_out_put_str(out, "can't open file\n");
+        return -1;
+    }
+
+    /* binary image goes to file, decode it with "clip_trace_decode <file>" */
+    char buf[64];
+    struct clip_out file_out;
+    clip_out_init(&file_out, buf, sizeof(buf), trace_file_sink, file);
+    clip_trace_dump(&g_trace, &file_out);
+    clip_out_flush(&file_out);
+    fclose(file);
+
+    clip_out_put_str(out, "trace saved\n");
+
+    return 0;
+}
+
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_trace_cmd, "trace", "save trace dump to file", trace_callback, CLIP_USAGE_ARG("file", STRING)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("file", "output file name", CLIP_ARG_TYPE_STRING)
+CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
+CLIP_REGISTER_ROOT_COMMAND(g_trace_cmd)
@@ -27,51 +27,85 @@ SOFTWARE.
 #include <time.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <stdarg.h>
+#include <unistd.h>
 
 #include "clip.h"
 #include "main.h"
 
-void print_args(const char *tag, size_t argc, struct clip_arg_value argv[])
+void out_printf(struct clip_out *out, const char *fmt, ...)
 {
-    printf(COLOR_GREEN "%s, argc=%lu, argv=", tag, argc);
+    char buf[128];
+    va_list args;
+
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    if (len > 0)
+        clip_out_put_bytes(out, buf, ((size_t)len < sizeof(buf)) ? (size_t)len : sizeof(buf) - 1);
+}
+
+void stdout_sink(struct clip_out *self, const char *data, size_t size)
+{
+    /* keep order with data printed by stdio (e.g. in event callback) */
+    fflush(stdout);
+
+    while (size > 0) {
+        ssize_t n = write(STDOUT_FILENO, data, size);
+        if (n <= 0)
+            break;
+        data += n;
+        size -= n;
+    }
+}
+
+void print_args(struct clip_out *out, const char *tag, size_t argc, struct clip_arg_value argv[])
+{
+    clip_out_put_str(out, COLOR_GREEN);
+    clip_out_put_str(out, tag);
+    clip_out_put_str(out, ", argc=");
+    clip_out_put_u32(out, argc);
+    clip_out_put_str(out, ", argv=");
     for (size_t i = 0; i < argc; i++) {
         const char *type_name = clip_utils_arg_get_type_string(argv[i].type);
+        clip_out_put_str(out, "<");
+        clip_out_put_str(out, type_name);
+        clip_out_put_str(out, ":");
         switch (argv[i].type) {
         case CLIP_ARG_TYPE_STRING:
-            printf("<%s:%s> ", type_name, argv[i].val_str);
+            clip_out_put_str(out, argv[i].val_str);
             break;
 
         case CLIP_ARG_TYPE_INT:
-            printf("<%s:%d> ", type_name, argv[i].val_int);
+            out_printf(out, "%d", argv[i].val_int);
             break;
 
         case CLIP_ARG_TYPE_UINT:
-            printf("<%s:%u> ", type_name, argv[i].val_uint);
+            clip_out_put_u32(out, argv[i].val_uint);
             break;
 
         case CLIP_ARG_TYPE_FLOAT:
-            printf("<%s:%f> ", type_name, argv[i].val_float);
+            out_printf(out, "%f", argv[i].val_float);
             break;
 
         case CLIP_ARG_TYPE_HEXARRAY: {
-            printf("<%s:", type_name);
             uint8_t *data = NULL;
             size_t size = clip_utils_arg_unpack_hexarray(&data, argv[i].val_hexarray);
-            for (size_t n = 0; n < size; n++)
-                printf("%02X", data[n]);
-            printf("> ");
+            clip_out_put_hex(out, data, size);
             break;
         }
         
         default:
-            printf("<%s:%s> ", type_name, argv[i].val_str);
+            clip_out_put_str(out, argv[i].val_str);
             break;
         }
+        clip_out_put_str(out, "> ");
     }
-    printf(COLOR_RESET "\n");
+    clip_out_put_str(out, COLOR_RESET "\n");
 }
 
-void print_mem_dump(uint32_t addr, size_t size, uint8_t *data)
+void print_mem_dump(struct clip_out *out, uint32_t addr, size_t size, uint8_t *data)
 {
     const size_t max_align = 16;
     size_t align = 0;
@@ -80,7 +114,7 @@ void print_mem_dump(uint32_t addr, size_t size, uint8_t *data)
 
     while (size > 0 || align > 0) {
         if (align == 0)
-            printf("0x%08X  ", addr);
+            out_printf(out, "0x%08X  ", addr);
 
         if (size > 0) {
             uint8_t val;
@@ -90,10 +124,11 @@ void print_mem_dump(uint32_t addr, size_t size, uint8_t *data)
                 val = *data;
                 data++;
             }
-            printf("%02X ", val);            
+            clip_out_put_hex(out, &val, 1);
+            clip_out_put_str(out, " ");
             buf[buf_size++] = val;
         } else {
-            printf("   ");
+            clip_out_put_str(out, "   ");
         }
 
         if (size > 0)
@@ -104,12 +139,13 @@ void print_mem_dump(uint32_t addr, size_t size, uint8_t *data)
         align %= max_align;
 
         if (align == 0) {
-            printf(" ");
+            clip_out_put_str(out, " ");
             for (size_t i = 0; i < buf_size; i++) {
                 char ch = (char)buf[i];
-                printf("%c", isalnum(ch) ? ch : '.');
+                ch = isalnum(ch) ? ch : '.';
+                clip_out_put_bytes(out, &ch, 1);
             }
-            printf("\n");
+            clip_out_put_str(out, "\n");
             buf_size = 0;
         }
     }
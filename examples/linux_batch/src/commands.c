@@ -0,0 +1,164 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "clip.h"
+#include "commands.h"
+
+#define CONFIG_KEYS_MAX         32
+#define CONFIG_KEY_SIZE         16
+#define CONFIG_VALUE_SIZE       32
+#define OTP_SIZE                1024
+#define CALIB_CHANNELS          8
+
+///< structure contains simulated board state
+struct board {
+    char keys[CONFIG_KEYS_MAX][CONFIG_KEY_SIZE];
+    char values[CONFIG_KEYS_MAX][CONFIG_VALUE_SIZE];
+    uint32_t serial;
+    uint8_t otp[OTP_SIZE];
+    float gain[CALIB_CHANNELS];
+    int32_t offset[CALIB_CHANNELS];
+};
+
+static struct board g_board;
+
+static int config_find(const char *key, bool create)
+{
+    for (int i = 0; i < CONFIG_KEYS_MAX; i++) {
+        if (strcmp(g_board.keys[i], key) == 0)
+            return i;
+        if (g_board.keys[i][0] == '\0' && create) {
+            strcpy(g_board.keys[i], key);
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int config_set_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    if (strlen(argv[0].val_str) >= CONFIG_KEY_SIZE || strlen(argv[1].val_str) >= CONFIG_VALUE_SIZE)
+        return -1;
+
+    int i = config_find(argv[0].val_str, true);
+    if (i < 0)
+        return -2;
+
+    strcpy(g_board.values[i], argv[1].val_str);
+    return 0;
+}
+
+static int config_get_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    int i = config_find(argv[0].val_str, false);
+    if (i < 0)
+        return -1;
+
+    clip_out_put_str(out, g_board.values[i]);
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+static int serial_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    g_board.serial = argv[0].val_uint;
+    return 0;
+}
+
+static int otp_write_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    uint8_t *data;
+    size_t size = clip_utils_arg_unpack_hexarray(&data, argv[1].val_hexarray);
+    uint32_t address = argv[0].val_uint;
+
+    if (address > OTP_SIZE || size > OTP_SIZE - address)
+        return -1;
+
+    /* OTP bits can only be set */
+    for (size_t i = 0; i < size; i++)
+        g_board.otp[address + i] |= data[i];
+    return 0;
+}
+
+static int calib_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    uint32_t channel = argv[0].val_uint;
+
+    if (channel >= CALIB_CHANNELS)
+        return -1;
+
+    g_board.gain[channel] = argv[1].val_float;
+    g_board.offset[channel] = argv[2].val_int;
+    return 0;
+}
+
+static int status_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    clip_out_put_str(out, "serial ");
+    clip_out_put_u32(out, g_board.serial);
+    clip_out_put_str(out, " crc ");
+    clip_out_put_u32(out, clip_utils_crc_calc(CLIP_ARG_CHECK_CRC32, g_board.otp, sizeof(g_board.otp)));
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+CLIP_DEF_ROOT_COMMAND(g_config_cmd, "config", "configuration storage", NULL)
+    CLIP_DEF_COMMAND_WITH_USAGE("set", "set configuration value", config_set_callback, CLIP_USAGE_ARG("key", STRING) CLIP_USAGE_ARG("value", STRING)) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("key", "configuration key", CLIP_ARG_TYPE_STRING)
+        CLIP_DEF_ARGUMENT("value", "configuration value", CLIP_ARG_TYPE_STRING)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+    CLIP_DEF_COMMAND_WITH_USAGE("get", "get configuration value", config_get_callback, CLIP_USAGE_ARG("key", STRING)) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("key", "configuration key", CLIP_ARG_TYPE_STRING)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+CLIP_DEF_ROOT_COMMAND_END()
+
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_serial_cmd, "serial", "set serial number", serial_callback, CLIP_USAGE_ARG("number", UINT)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("number", "serial number", CLIP_ARG_TYPE_UINT)
+CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
+
+CLIP_DEF_ROOT_COMMAND(g_otp_cmd, "otp", "one-time programmable memory", NULL)
+    CLIP_DEF_COMMAND_WITH_USAGE("write", "program OTP bytes", otp_write_callback, CLIP_USAGE_ARG("address", UINT) CLIP_USAGE_ARG("data", HEXARRAY)) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("address", "OTP address", CLIP_ARG_TYPE_UINT)
+        CLIP_DEF_ARGUMENT("data", "OTP data", CLIP_ARG_TYPE_HEXARRAY)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+CLIP_DEF_ROOT_COMMAND_END()
+
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_calib_cmd, "calib", "set channel calibration", calib_callback, CLIP_USAGE_ARG("channel", UINT) CLIP_USAGE_ARG("gain", FLOAT) CLIP_USAGE_ARG("offset", INT)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("channel", "channel number", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_ARGUMENT("gain", "channel gain", CLIP_ARG_TYPE_FLOAT)
+    CLIP_DEF_ARGUMENT("offset", "channel offset", CLIP_ARG_TYPE_INT)
+CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
+
+CLIP_DEF_ROOT_COMMAND(g_status_cmd, "status", "print board status", status_callback)
+CLIP_DEF_ROOT_COMMAND_END()
+
+CLIP_DEF_ROOT(g_board_clip, NULL, NULL)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_config_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_serial_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_otp_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_calib_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_status_cmd)
+CLIP_DEF_ROOT_END()
@@ -0,0 +1,216 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "clip.h"
+#include "commands.h"
+
+#define BATCH_INDEX_SIZE        64
+#define BATCH_MAX_ERRORS_PRINT  20
+
+///< structure contains per-command counters (indexed by command ID)
+struct batch_counters {
+    size_t lines;
+    size_t not_found;
+    size_t arguments_errors;
+    size_t command_errors;
+};
+
+///< structure contains batch runner state passed as context
+struct batch {
+    struct clip_index index;
+    struct clip_index_entry entries[BATCH_INDEX_SIZE];
+    struct batch_counters counters[BATCH_INDEX_SIZE];
+    size_t errors_printed;
+};
+
+static void file_sink(struct clip_out *self, const char *data, size_t size)
+{
+    fwrite(data, 1, size, (FILE*)self->context);
+}
+
+static void batch_report(const struct clip *self, size_t line_no, const struct clip_result *result, void *context)
+{
+    struct batch *batch = (struct batch*)context;
+    size_t id = clip_index_get_id(&batch->index, result->cmd);
+
+    if (id >= BATCH_INDEX_SIZE)
+        return;
+
+    struct batch_counters *counters = &batch->counters[id];
+    counters->lines++;
+    switch (result->status) {
+    case CLIP_STATUS_COMMAND_NOT_FOUND: counters->not_found++; break;
+    case CLIP_STATUS_ARGUMENTS_ERROR: counters->arguments_errors++; break;
+    case CLIP_STATUS_COMMAND_ERROR: counters->command_errors++; break;
+    default: return;
+    }
+
+    if (batch->errors_printed++ >= BATCH_MAX_ERRORS_PRINT)
+        return;
+
+    fprintf(stderr, "line %zu: ", line_no);
+    switch (result->status) {
+    case CLIP_STATUS_COMMAND_NOT_FOUND:
+        fprintf(stderr, "command not found \"%s\" (offset %zu)\n", result->token, result->offset);
+        break;
+    case CLIP_STATUS_ARGUMENTS_ERROR:
+        fprintf(stderr, "%s (offset %zu)\n", clip_utils_arg_get_error_string(result->error), result->offset);
+        break;
+    default:
+        fprintf(stderr, "command error %d\n", result->code);
+        break;
+    }
+}
+
+static void batch_print_counters(const struct clip_index *index, const struct clip_path *path, size_t id, void *context)
+{
+    struct batch *batch = (struct batch*)context;
+
+    if (id >= BATCH_INDEX_SIZE || batch->counters[id].lines == 0)
+        return;
+
+    /* command path is written with unbuffered response writer, directly to stderr */
+    const struct batch_counters *counters = &batch->counters[id];
+    struct clip_out out;
+    clip_out_init(&out, NULL, 0, file_sink, stderr);
+    fprintf(stderr, "  %-8zu %-10zu %-10zu %-10zu ", counters->lines, counters->not_found, counters->arguments_errors, counters->command_errors);
+    clip_out_put_path(&out, path);
+    fprintf(stderr, "\n");
+}
+
+static char* map_script(const char *path, size_t *size)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror(path);
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+
+    /* anonymous reservation is one byte bigger than file, so the last line can be zero-ended in place */
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t reserve = (*size + 1 + page - 1) & ~(page - 1);
+    char *script = mmap(NULL, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (script == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return NULL;
+    }
+
+    /* private mapping, lines are split in copy-on-write pages and the file is never modified */
+    if (*size > 0 && mmap(script, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return NULL;
+    }
+    madvise(script, *size, MADV_SEQUENTIAL);
+    close(fd);
+    return script;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-c] [-q] SCRIPT\n", name);
+    fprintf(stderr, "  -c  continue past failed lines\n");
+    fprintf(stderr, "  -q  don't print commands responses\n");
+}
+
+int main(int argc, char *argv[])
+{
+    clip_pipeline_policy_t policy = CLIP_PIPELINE_STOP_ON_ERROR;
+    bool quiet = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "cq")) != -1) {
+        switch (opt) {
+        case 'c':
+            policy = CLIP_PIPELINE_CONTINUE;
+            break;
+        case 'q':
+            quiet = true;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (optind + 1 != argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    static struct batch batch;
+    if (clip_index_init(&batch.index, &g_board_clip, batch.entries, BATCH_INDEX_SIZE) == false) {
+        fprintf(stderr, "index too small\n");
+        return 2;
+    }
+
+    size_t size = 0;
+    char *script = map_script(argv[optind], &size);
+    if (script == NULL)
+        return 2;
+
+    static char out_buf[4096];
+    struct clip_out out;
+    clip_out_init(&out, out_buf, sizeof(out_buf), file_sink, stdout);
+
+    struct timespec start, stop;
+    struct clip_batch_result result;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool success = clip_batch_run(&g_board_clip, script, size, (quiet != false) ? NULL : &out, &batch, policy, batch_report, &result);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    fflush(stdout);
+
+    double elapsed = (double)(stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, "lines:       %zu\n", result.lines);
+    fprintf(stderr, "errors:      %zu\n", result.errors);
+    if (result.error_line > 0)
+        fprintf(stderr, "first error: line %zu\n", result.error_line);
+    if (result.size < size)
+        fprintf(stderr, "stopped:     %zu of %zu bytes processed\n", result.size, size);
+    fprintf(stderr, "elapsed:     %.3f s\n", elapsed);
+    fprintf(stderr, "throughput:  %.0f lines/s, %.1f MB/s\n", (elapsed > 0.0) ? (double)result.lines / elapsed : 0.0, (elapsed > 0.0) ? (double)result.size / elapsed / 1e6 : 0.0);
+    fprintf(stderr, "  %-8s %-10s %-10s %-10s %s\n", "lines", "not_found", "args_err", "cmd_err", "command");
+    clip_index_walk(&batch.index, batch_print_counters, &batch);
+
+    return (success != false) ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "clip_types.h"
+
+///< maximum number of worker threads
+#define EXECUTOR_MAX_WORKERS    64
+
+///< size of job command line buffer (same as client line buffer)
+#define EXECUTOR_LINE_SIZE      256
+
+struct client;
+
+///< structure contains single command line submitted by client
+struct executor_job {
+    struct executor_job *next;              ///< next job of the same client (submission order)
+    struct executor_job *work_prev;         ///< previous job in worker deque
+    struct executor_job *work_next;         ///< next job in worker deque or in completion list
+    struct client *client;                  ///< client which submitted the line
+    struct clip_bound_command bound;        ///< parsed command (valid if "runnable" is set)
+    bool runnable;                          ///< command has to be called, response is incomplete until then
+    bool ready;                             ///< response is complete and may be transmitted
+    char line[EXECUTOR_LINE_SIZE];          ///< copy of command line (referenced by bound arguments)
+    struct clip_out out;                    ///< response writer (bind errors and command output)
+    char out_buf[128];                      ///< response writer buffer
+    char *data;                             ///< complete response (grows as needed)
+    size_t size;                            ///< response length
+    size_t capacity;                        ///< allocated response buffer size
+};
+
+/**
+ * @brief           Function used to start worker threads.
+ * @param[in]       workers
+ *                  Number of worker threads.
+ * @return          File descriptor which becomes readable when some jobs are completed (-1 on error).
+*/
+int executor_start(size_t workers);
+
+/**
+ * @brief           Function used to allocate new job with empty response.
+ * @param[in]       client
+ *                  Client which submits the line.
+ * @return          Pointer to new job (NULL if there is no memory).
+*/
+struct executor_job* executor_job_new(struct client *client);
+
+/**
+ * @brief           Function used to release job and its response.
+ * @param[in/out]   job
+ *                  Pointer to job.
+*/
+void executor_job_free(struct executor_job *job);
+
+/**
+ * @brief           Function used to pass runnable job to worker threads.
+ * @param[in/out]   job
+ *                  Pointer to job (it can't be touched until collected).
+ * @param[in]       hint
+ *                  Preferred worker (jobs with the same hint are queued to the same worker).
+*/
+void executor_submit(struct executor_job *job, size_t hint);
+
+/**
+ * @brief           Function used to collect completed jobs (called when executor descriptor is readable).
+ * @return          List of completed jobs (linked by "work_next" field, NULL if empty).
+*/
+struct executor_job* executor_collect(void);
+
+#endif /* EXECUTOR_H */
@@ -0,0 +1,72 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "clip_types.h"
+
+struct executor_job;
+
+///< size of client transmit ring (must be power of 2)
+#define CLIENT_TX_SIZE          4096
+
+///< structure contains state of single connected client
+struct client {
+    int fd;                                 ///< connection socket
+    bool closing;                           ///< close connection after transmitting pending data
+    struct clip_session session;            ///< command line session (context is this client)
+    char line[256];                         ///< command line buffer
+    uint8_t chunk[64];                      ///< streamed arguments data buffer
+    char out[512];                          ///< single response buffer
+    char tx[CLIENT_TX_SIZE];                ///< responses waiting for transmission (ring)
+    size_t tx_head;                         ///< number of bytes put into ring (free running)
+    size_t tx_tail;                         ///< number of bytes transmitted from ring (free running)
+    struct clip_out *reply;                 ///< writer for errors and help of currently parsed line
+    size_t line_len;                        ///< assembled line length (executor mode)
+    bool line_discard;                      ///< line is too long and it's discarded up to new line (executor mode)
+    struct executor_job *jobs_head;         ///< oldest job waiting for response transmission (executor mode)
+    struct executor_job *jobs_tail;         ///< newest job waiting for response transmission (executor mode)
+    size_t jobs_num;                        ///< number of jobs waiting for response transmission (executor mode)
+    struct client *ready_next;              ///< next client with completed jobs (executor mode)
+    bool ready_queued;                      ///< client is on completed jobs list (executor mode)
+    bool closed;                            ///< connection is closed, client is freed after current events batch
+    struct client *closed_next;             ///< next closed client waiting to be freed
+};
+
+///< root commands handler served to every client
+extern const struct clip g_server_clip;
+
+/**
+ * @brief           Function used to check if command must be called from main thread (executor mode).
+ * @param[in]       cmd
+ *                  Pointer to bound command.
+ * @return          True if command touches client state and can't be called from worker thread.
+*/
+bool server_command_is_inline(const struct clip_command *cmd);
+
+#endif /* SERVER_H */
@@ -0,0 +1,47 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SOCKET_H
+#define SOCKET_H
+
+///< default server address (loopback TCP port)
+#define SOCKET_DEFAULT_ADDRESS  "5555"
+
+/**
+ * @brief           Function used to create non-blocking listening socket.
+ * @param[in]       address
+ *                  "unix:PATH" for Unix-domain socket or "PORT" for loopback TCP port.
+ * @return          Socket descriptor or -1 on error.
+*/
+int socket_listen(const char *address);
+
+/**
+ * @brief           Function used to connect (blocking) to server.
+ * @param[in]       address
+ *                  "unix:PATH" for Unix-domain socket or "PORT" for loopback TCP port.
+ * @return          Socket descriptor or -1 on error.
+*/
+int socket_connect(const char *address);
+
+#endif /* SOCKET_H */
@@ -0,0 +1,145 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+#include "server.h"
+
+static void server_event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context)
+{
+    /* errors go to the response of the line which is parsed (session context is the client) */
+    struct clip_out *out = ((struct client*)context)->reply;
+
+    switch (event) {
+    case CLIP_EVENT_HELP:
+        clip_help_put_commands(out, event_arg->help.commands, CLIP_HELP_DEPTH_ALL);
+        break;
+
+    case CLIP_EVENT_COMMAND_NOT_FOUND:
+        clip_out_put_str(out, "error: command not found\n");
+        break;
+
+    case CLIP_EVENT_ARGUMENTS_ERROR:
+        clip_out_put_str(out, "error: ");
+        clip_out_put_str(out, clip_utils_arg_get_error_string(event_arg->arguments_error.error));
+        clip_out_put_str(out, "\nusage: ");
+        clip_utils_arg_put_command_usage(out, event_arg->arguments_error.cmd);
+        clip_out_put_str(out, "\n");
+        break;
+
+    default:
+        break;
+    }
+}
+
+static int ping_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    clip_out_put_str(out, "pong\n");
+    return 0;
+}
+
+static int echo_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    clip_out_put_str(out, argv[0].val_str);
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+static int add_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    clip_out_put_u32(out, argv[0].val_uint + argv[1].val_uint);
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+static int crc_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    uint8_t *data;
+    size_t size = clip_utils_arg_unpack_hexarray(&data, argv[0].val_hexarray);
+
+    clip_out_put_u32(out, clip_utils_crc_calc(CLIP_ARG_CHECK_CRC32, data, size));
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+static int selftest_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    /* CPU-heavy command, checksum of 1 KiB pattern is computed given number of times */
+    uint8_t data[1024];
+    uint32_t crc = 0;
+
+    for (uint32_t round = 0; round < argv[0].val_uint; round++) {
+        for (size_t i = 0; i < sizeof(data); i++)
+            data[i] = (uint8_t)(i + round + crc);
+        crc = clip_utils_crc_calc(CLIP_ARG_CHECK_CRC32, data, sizeof(data));
+    }
+
+    clip_out_put_u32(out, crc);
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+static int quit_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    ((struct client*)context)->closing = true;
+    clip_out_put_str(out, "bye\n");
+    return 0;
+}
+
+CLIP_DEF_ROOT_COMMAND(g_ping_cmd, "ping", "check connection", ping_callback)
+CLIP_DEF_ROOT_COMMAND_END()
+
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_echo_cmd, "echo", "print text", echo_callback, CLIP_USAGE_ARG("text", STRING)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("text", "text to print", CLIP_ARG_TYPE_STRING)
+CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
+
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_add_cmd, "add", "add numbers", add_callback, CLIP_USAGE_ARG("a", UINT) CLIP_USAGE_ARG("b", UINT)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("a", "first number", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_ARGUMENT("b", "second number", CLIP_ARG_TYPE_UINT)
+CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
+
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_crc_cmd, "crc", "compute CRC-32 of data", crc_callback, CLIP_USAGE_ARG("data", HEXARRAY)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("data", "binary data", CLIP_ARG_TYPE_HEXARRAY)
+CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
+
+CLIP_DEF_ROOT_COMMAND_WITH_USAGE(g_selftest_cmd, "selftest", "compute checksums (CPU load)", selftest_callback, CLIP_USAGE_ARG("rounds", UINT)) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_ARGUMENT("rounds", "number of rounds", CLIP_ARG_TYPE_UINT)
+CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()
+
+CLIP_DEF_ROOT_COMMAND(g_quit_cmd, "quit", "close connection", quit_callback)
+CLIP_DEF_ROOT_COMMAND_END()
+
+CLIP_DEF_ROOT_EX(g_server_clip, NULL, server_event_callback, NULL, CLIP_EVENT_MASK(CLIP_EVENT_CALL_COMMAND_CALLBACK))
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_ping_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_echo_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_add_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_crc_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_selftest_cmd)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_quit_cmd)
+CLIP_DEF_ROOT_END()
+
+bool server_command_is_inline(const struct clip_command *cmd)
+{
+    /* quit changes client state, other commands use only their arguments and output */
+    return cmd == &g_quit_cmd;
+}
@@ -0,0 +1,226 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+
+#include "clip.h"
+#include "executor.h"
+
+///< structure contains jobs queued to single worker (owner takes the oldest, thieves take the newest)
+struct executor_deque {
+    pthread_mutex_t lock;
+    struct executor_job *head;
+    struct executor_job *tail;
+};
+
+static struct executor_deque g_deques[EXECUTOR_MAX_WORKERS];
+static size_t g_workers_num;
+
+static pthread_mutex_t g_idle_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_idle_cond = PTHREAD_COND_INITIALIZER;
+static long g_queued;
+
+static pthread_mutex_t g_done_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct executor_job *g_done_head;
+static struct executor_job *g_done_tail;
+static int g_event_fd = -1;
+
+static void executor_job_sink(struct clip_out *self, const char *data, size_t size)
+{
+    struct executor_job *job = (struct executor_job*)self->context;
+
+    if (job->capacity - job->size < size) {
+        size_t capacity = (job->capacity > 0) ? job->capacity : sizeof(job->out_buf);
+        while (capacity - job->size < size)
+            capacity *= 2;
+
+        /* response is truncated if there is no memory */
+        char *buf = realloc(job->data, capacity);
+        if (buf == NULL)
+            return;
+        job->data = buf;
+        job->capacity = capacity;
+    }
+
+    memcpy(&job->data[job->size], data, size);
+    job->size += size;
+}
+
+static void executor_deque_push(struct executor_deque *deque, struct executor_job *job)
+{
+    pthread_mutex_lock(&deque->lock);
+    job->work_next = NULL;
+    job->work_prev = deque->tail;
+    if (deque->tail != NULL) {
+        deque->tail->work_next = job;
+    } else {
+        deque->head = job;
+    }
+    deque->tail = job;
+    pthread_mutex_unlock(&deque->lock);
+}
+
+static struct executor_job* executor_deque_take(struct executor_deque *deque, bool steal)
+{
+    pthread_mutex_lock(&deque->lock);
+    struct executor_job *job = (steal != false) ? deque->tail : deque->head;
+    if (job != NULL) {
+        if (job->work_prev != NULL) {
+            job->work_prev->work_next = job->work_next;
+        } else {
+            deque->head = job->work_next;
+        }
+        if (job->work_next != NULL) {
+            job->work_next->work_prev = job->work_prev;
+        } else {
+            deque->tail = job->work_prev;
+        }
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return job;
+}
+
+static void executor_complete(struct executor_job *job)
+{
+    uint64_t one = 1;
+
+    pthread_mutex_lock(&g_done_lock);
+    job->work_next = NULL;
+    if (g_done_tail != NULL) {
+        g_done_tail->work_next = job;
+    } else {
+        g_done_head = job;
+    }
+    g_done_tail = job;
+    pthread_mutex_unlock(&g_done_lock);
+
+    if (write(g_event_fd, &one, sizeof(one)) < 0)
+        perror("eventfd");
+}
+
+static void* executor_worker(void *arg)
+{
+    size_t self = (size_t)(uintptr_t)arg;
+
+    while (true) {
+        /* own jobs are taken in submission order, so responses of one client are rarely held back */
+        struct executor_job *job = executor_deque_take(&g_deques[self], false);
+        for (size_t i = 1; job == NULL && i < g_workers_num; i++)
+            job = executor_deque_take(&g_deques[(self + i) % g_workers_num], true);
+
+        pthread_mutex_lock(&g_idle_lock);
+        if (job == NULL) {
+            while (g_queued <= 0)
+                pthread_cond_wait(&g_idle_cond, &g_idle_lock);
+            pthread_mutex_unlock(&g_idle_lock);
+            continue;
+        }
+        g_queued--;
+        pthread_mutex_unlock(&g_idle_lock);
+
+        clip_cmd_invoke(&job->bound, &job->out);
+        executor_complete(job);
+    }
+
+    return NULL;
+}
+
+int executor_start(size_t workers)
+{
+    if (workers == 0 || workers > EXECUTOR_MAX_WORKERS) {
+        fprintf(stderr, "executor: workers number must be in range 1..%d\n", EXECUTOR_MAX_WORKERS);
+        return -1;
+    }
+
+    g_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (g_event_fd < 0) {
+        perror("eventfd");
+        return -1;
+    }
+
+    /* all deques are ready before first worker starts stealing */
+    g_workers_num = workers;
+    for (size_t i = 0; i < workers; i++)
+        pthread_mutex_init(&g_deques[i].lock, NULL);
+
+    for (size_t i = 0; i < workers; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, executor_worker, (void*)(uintptr_t)i) != 0) {
+            fprintf(stderr, "executor: can't create worker thread\n");
+            return -1;
+        }
+        pthread_detach(thread);
+    }
+
+    return g_event_fd;
+}
+
+struct executor_job* executor_job_new(struct client *client)
+{
+    struct executor_job *job = calloc(1, sizeof(struct executor_job));
+    if (job == NULL)
+        return NULL;
+
+    job->client = client;
+    clip_out_init(&job->out, job->out_buf, sizeof(job->out_buf), executor_job_sink, job);
+    return job;
+}
+
+void executor_job_free(struct executor_job *job)
+{
+    free(job->data);
+    free(job);
+}
+
+void executor_submit(struct executor_job *job, size_t hint)
+{
+    executor_deque_push(&g_deques[hint % g_workers_num], job);
+
+    pthread_mutex_lock(&g_idle_lock);
+    g_queued++;
+    pthread_cond_signal(&g_idle_cond);
+    pthread_mutex_unlock(&g_idle_lock);
+}
+
+struct executor_job* executor_collect(void)
+{
+    uint64_t count;
+
+    if (read(g_event_fd, &count, sizeof(count)) < 0)
+        return NULL;
+
+    pthread_mutex_lock(&g_done_lock);
+    struct executor_job *jobs = g_done_head;
+    g_done_head = NULL;
+    g_done_tail = NULL;
+    pthread_mutex_unlock(&g_done_lock);
+
+    return jobs;
+}
@@ -0,0 +1,192 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+
+#include "socket.h"
+
+///< structure contains state of single load generating connection
+struct worker {
+    pthread_t thread;                       ///< worker thread
+    const char *address;                    ///< server address
+    const char *line;                       ///< command line sent to server (with new line char)
+    size_t commands;                        ///< number of commands to send
+    uint64_t *latency;                      ///< measured latency of every command (nanoseconds)
+    size_t done;                            ///< number of completed commands
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static bool write_all(int fd, const char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n <= 0)
+            return false;
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static void* worker_run(void *arg)
+{
+    struct worker *w = (struct worker*)arg;
+    size_t line_len = strlen(w->line);
+    char buf[4096];
+    size_t buf_len = 0;
+
+    int fd = socket_connect(w->address);
+    if (fd < 0)
+        return NULL;
+
+    for (w->done = 0; w->done < w->commands; w->done++) {
+        uint64_t start = now_ns();
+
+        if (write_all(fd, w->line, line_len) == false)
+            break;
+
+        /* every response is finished with new line char */
+        char *end = NULL;
+        while ((end = memchr(buf, '\n', buf_len)) == NULL) {
+            if (buf_len == sizeof(buf))
+                buf_len = 0;
+            ssize_t n = read(fd, &buf[buf_len], sizeof(buf) - buf_len);
+            if (n <= 0)
+                goto exit;
+            buf_len += (size_t)n;
+        }
+
+        w->latency[w->done] = now_ns() - start;
+
+        size_t used = (size_t)(end - buf) + 1;
+        memmove(buf, &buf[used], buf_len - used);
+        buf_len -= used;
+    }
+
+exit:
+    close(fd);
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-a unix:PATH | PORT] [-c connections] [-n commands] [-l line]\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *address = SOCKET_DEFAULT_ADDRESS;
+    const char *cmd = "ping";
+    size_t connections = 16;
+    size_t commands = 10000;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:c:n:l:h")) != -1) {
+        switch (opt) {
+        case 'a': address = optarg; break;
+        case 'c': connections = strtoul(optarg, NULL, 0); break;
+        case 'n': commands = strtoul(optarg, NULL, 0); break;
+        case 'l': cmd = optarg; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (connections == 0 || commands == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    char *line = malloc(strlen(cmd) + 2);
+    struct worker *workers = calloc(connections, sizeof(struct worker));
+    uint64_t *latency = calloc(connections * commands, sizeof(uint64_t));
+    if (line == NULL || workers == NULL || latency == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    sprintf(line, "%s\n", cmd);
+
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < connections; i++) {
+        workers[i].address = address;
+        workers[i].line = line;
+        workers[i].commands = commands;
+        workers[i].latency = &latency[i * commands];
+        pthread_create(&workers[i].thread, NULL, worker_run, &workers[i]);
+    }
+
+    /* samples of every worker are packed together */
+    size_t total = 0;
+    for (size_t i = 0; i < connections; i++) {
+        pthread_join(workers[i].thread, NULL);
+        memmove(&latency[total], workers[i].latency, workers[i].done * sizeof(uint64_t));
+        total += workers[i].done;
+    }
+
+    double elapsed = (double)(now_ns() - start) / 1e9;
+
+    if (total == 0) {
+        fprintf(stderr, "no command completed\n");
+        return 1;
+    }
+
+    qsort(latency, total, sizeof(uint64_t), compare_u64);
+
+    printf("connections: %zu\n", connections);
+    printf("commands:    %zu\n", total);
+    printf("elapsed:     %.3f s\n", elapsed);
+    printf("throughput:  %.0f cmd/s\n", (double)total / elapsed);
+    printf("latency p50: %.1f us\n", (double)latency[total * 50 / 100] / 1e3);
+    printf("latency p99: %.1f us\n", (double)latency[total * 99 / 100] / 1e3);
+    printf("latency max: %.1f us\n", (double)latency[total - 1] / 1e3);
+
+    free(latency);
+    free(workers);
+    free(line);
+
+    return (total == connections * commands) ? 0 : 1;
+}
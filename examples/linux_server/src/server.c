@@ -0,0 +1,387 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "clip.h"
+#include "server.h"
+#include "socket.h"
+#include "executor.h"
+
+#define SERVER_MAX_EVENTS       64
+#define SERVER_READ_SIZE        4096
+#define SERVER_CLIENT_MAX_JOBS  64
+
+static int g_epoll_fd;
+static int g_executor_fd = -1;
+static struct client *g_closed;
+
+static size_t client_tx_pending(const struct client *client)
+{
+    return client->tx_head - client->tx_tail;
+}
+
+static bool client_flush(struct client *client)
+{
+    /* ring content is sent with single call, even if it wraps around the buffer end */
+    while (client_tx_pending(client) > 0) {
+        size_t tail = client->tx_tail & (CLIENT_TX_SIZE - 1);
+        size_t pending = client_tx_pending(client);
+        size_t first = CLIENT_TX_SIZE - tail;
+        struct iovec iov[2] = {
+            {.iov_base = &client->tx[tail], .iov_len = (pending < first) ? pending : first},
+            {.iov_base = client->tx, .iov_len = (pending > first) ? pending - first : 0},
+        };
+
+        ssize_t n = writev(client->fd, iov, (iov[1].iov_len > 0) ? 2 : 1);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return false;
+            if (errno == EINTR)
+                continue;
+            /* connection broken, drop pending data */
+            client->tx_tail = client->tx_head;
+            client->closing = true;
+            return true;
+        }
+        client->tx_tail += (size_t)n;
+    }
+    return true;
+}
+
+static void client_sink(struct clip_out *self, const char *data, size_t size)
+{
+    struct client *client = (struct client*)self->context;
+
+    if (CLIENT_TX_SIZE - client_tx_pending(client) < size)
+        client_flush(client);
+
+    if (CLIENT_TX_SIZE - client_tx_pending(client) < size) {
+        /* client doesn't read responses, disconnect it */
+        client->closing = true;
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++)
+        client->tx[(client->tx_head + i) & (CLIENT_TX_SIZE - 1)] = data[i];
+    client->tx_head += size;
+}
+
+static void client_close(struct client *client)
+{
+    epoll_ctl(g_epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+
+    /* events batch may still hold pointer to this client, it's freed after the batch is handled */
+    client->closed = true;
+    client->closed_next = g_closed;
+    g_closed = client;
+}
+
+static void client_free_closed(void)
+{
+    while (g_closed != NULL) {
+        struct client *client = g_closed;
+        g_closed = client->closed_next;
+        free(client);
+    }
+}
+
+static void client_update_events(struct client *client)
+{
+    if (client->closing && client->jobs_num > 0 && client_tx_pending(client) == 0) {
+        /* connection isn't watched any more, client is closed when its last job is completed */
+        epoll_ctl(g_epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+        return;
+    }
+
+    /* stop reading new commands until previous responses are transmitted (or too many jobs are queued) */
+    struct epoll_event ev = {
+        .events = (client_tx_pending(client) > 0) ? EPOLLOUT : (client->jobs_num < SERVER_CLIENT_MAX_JOBS) ? EPOLLIN : 0,
+        .data.ptr = client,
+    };
+    epoll_ctl(g_epoll_fd, EPOLL_CTL_MOD, client->fd, &ev);
+}
+
+static void client_update(struct client *client)
+{
+    bool flushed = client_flush(client);
+
+    if (client->closing && flushed && client->jobs_num == 0) {
+        client_close(client);
+        return;
+    }
+    client_update_events(client);
+}
+
+static void client_release(struct client *client)
+{
+    /* responses are transmitted in submission order, inline commands are called when they reach the head */
+    struct executor_job *job;
+    while ((job = client->jobs_head) != NULL) {
+        bool drop = client->closing;
+
+        if (job->ready == false && job->runnable && server_command_is_inline(job->bound.cmd)) {
+            clip_cmd_invoke(&job->bound, &job->out);
+            job->ready = true;
+        }
+        if (job->ready == false)
+            break;
+
+        if (drop == false && job->size > 0)
+            clip_out_put_bytes(&client->session.out, job->data, job->size);
+
+        client->jobs_head = job->next;
+        if (client->jobs_head == NULL)
+            client->jobs_tail = NULL;
+        client->jobs_num--;
+        executor_job_free(job);
+    }
+    clip_out_flush(&client->session.out);
+}
+
+static void client_submit_line(struct client *client)
+{
+    struct executor_job *job = executor_job_new(client);
+    if (job == NULL) {
+        client->closing = true;
+        return;
+    }
+
+    /* line is only parsed here, errors and help are collected in job response to keep the order */
+    memcpy(job->line, client->line, client->line_len + 1);
+    client->reply = &job->out;
+    clip_status_t status = clip_cmd_bind(&g_server_clip, NULL, job->line, &job->out, client, &job->bound, NULL);
+    client->reply = &client->session.out;
+
+    if (client->jobs_tail != NULL) {
+        client->jobs_tail->next = job;
+    } else {
+        client->jobs_head = job;
+    }
+    client->jobs_tail = job;
+    client->jobs_num++;
+
+    if (status != CLIP_STATUS_BOUND) {
+        job->ready = true;
+        return;
+    }
+
+    job->runnable = true;
+    if (server_command_is_inline(job->bound.cmd) == false)
+        executor_submit(job, (size_t)client->fd);
+}
+
+static void client_feed_lines(struct client *client, const char *data, size_t size)
+{
+    /* too long lines are discarded the same way as in clip_session */
+    for (size_t i = 0; i < size && client->closing == false; i++) {
+        char ch = data[i];
+
+        if (ch == '\r')
+            continue;
+
+        if (ch == '\n') {
+            client->line[client->line_len] = '\0';
+            if (client->line_len > 0 && client->line_discard == false)
+                client_submit_line(client);
+            client->line_len = 0;
+            client->line_discard = false;
+            continue;
+        }
+
+        if (client->line_len + 1 >= sizeof(client->line)) {
+            client->line_discard = true;
+            continue;
+        }
+        client->line[client->line_len++] = ch;
+    }
+}
+
+static void server_complete(void)
+{
+    struct client *ready = NULL;
+
+    /* jobs are only marked here, clients may be closed (and jobs freed) when responses are released */
+    for (struct executor_job *job = executor_collect(); job != NULL; job = job->work_next) {
+        struct client *client = job->client;
+        job->ready = true;
+        if (client->ready_queued == false) {
+            client->ready_queued = true;
+            client->ready_next = ready;
+            ready = client;
+        }
+    }
+
+    while (ready != NULL) {
+        struct client *client = ready;
+        ready = client->ready_next;
+        client->ready_queued = false;
+        client_release(client);
+        client_update(client);
+    }
+}
+
+static void server_accept(int listen_fd)
+{
+    while (true) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        struct client *client = calloc(1, sizeof(struct client));
+        if (client == NULL) {
+            close(fd);
+            continue;
+        }
+
+        client->fd = fd;
+        client->reply = &client->session.out;
+        clip_session_init(&client->session, &g_server_clip, client->line, sizeof(client->line), client->chunk, sizeof(client->chunk), client->out, sizeof(client->out), client_sink, client);
+
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = client};
+        if (epoll_ctl(g_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            close(fd);
+            free(client);
+        }
+    }
+}
+
+static void server_handle(struct client *client, uint32_t events)
+{
+    static char input[SERVER_READ_SIZE];
+
+    if (events & EPOLLIN) {
+        ssize_t n = read(client->fd, input, sizeof(input));
+        if (n > 0 && g_executor_fd >= 0) {
+            /* lines are parsed here, commands are called by workers, responses are released in order */
+            client_feed_lines(client, input, (size_t)n);
+            client_release(client);
+        } else if (n > 0) {
+            /* lines are assembled per connection, complete lines are dispatched until client quits */
+            const char *data = input;
+            size_t size = (size_t)n;
+            while (size > 0 && client->closing == false) {
+                const char *end = memchr(data, '\n', size);
+                size_t len = (end != NULL) ? (size_t)(end - data) + 1 : size;
+                clip_session_feed(&client->session, data, len);
+                data += len;
+                size -= len;
+            }
+        } else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            client->closing = true;
+        }
+    } else if (events & (EPOLLERR | EPOLLHUP)) {
+        client->closing = true;
+        client->tx_tail = client->tx_head;
+    }
+
+    client_update(client);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t workers = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:")) != -1) {
+        switch (opt) {
+        case 'j':
+            workers = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-j WORKERS] [unix:PATH | PORT]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (argc - optind > 1) {
+        fprintf(stderr, "usage: %s [-j WORKERS] [unix:PATH | PORT]\n", argv[0]);
+        return 1;
+    }
+    const char *address = (optind < argc) ? argv[optind] : SOCKET_DEFAULT_ADDRESS;
+
+    /* broken connections are detected by write errors */
+    signal(SIGPIPE, SIG_IGN);
+
+    int listen_fd = socket_listen(address);
+    if (listen_fd < 0)
+        return 1;
+
+    g_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (g_epoll_fd < 0) {
+        perror("epoll");
+        return 1;
+    }
+
+    /* listening socket is recognized by NULL data pointer */
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+    epoll_ctl(g_epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+
+    if (workers > 0) {
+        g_executor_fd = executor_start(workers);
+        if (g_executor_fd < 0)
+            return 1;
+
+        /* completed jobs are recognized by executor descriptor pointer */
+        struct epoll_event executor_ev = {.events = EPOLLIN, .data.ptr = &g_executor_fd};
+        epoll_ctl(g_epoll_fd, EPOLL_CTL_ADD, g_executor_fd, &executor_ev);
+    }
+
+    printf("listening on %s (%zu workers)\n", address, workers);
+    fflush(stdout);
+
+    while (true) {
+        struct epoll_event events[SERVER_MAX_EVENTS];
+        int num = epoll_wait(g_epoll_fd, events, SERVER_MAX_EVENTS, -1);
+        if (num < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            return 1;
+        }
+
+        for (int i = 0; i < num; i++) {
+            if (events[i].data.ptr == NULL) {
+                server_accept(listen_fd);
+            } else if (events[i].data.ptr == &g_executor_fd) {
+                server_complete();
+            } else if (((struct client*)events[i].data.ptr)->closed == false) {
+                server_handle((struct client*)events[i].data.ptr, events[i].events);
+            }
+        }
+        client_free_closed();
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "socket.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define SOCKET_UNIX_PREFIX  "unix:"
+
+static socklen_t socket_make_address(struct sockaddr_storage *addr, const char *address)
+{
+    memset(addr, 0, sizeof(*addr));
+
+    if (strncmp(address, SOCKET_UNIX_PREFIX, strlen(SOCKET_UNIX_PREFIX)) == 0) {
+        struct sockaddr_un *un = (struct sockaddr_un*)addr;
+        const char *path = address + strlen(SOCKET_UNIX_PREFIX);
+        if (strlen(path) >= sizeof(un->sun_path))
+            return 0;
+        un->sun_family = AF_UNIX;
+        strcpy(un->sun_path, path);
+        return sizeof(*un);
+    }
+
+    int port = atoi(address);
+    if (port <= 0 || port > 65535)
+        return 0;
+
+    struct sockaddr_in *in = (struct sockaddr_in*)addr;
+    in->sin_family = AF_INET;
+    in->sin_port = htons((uint16_t)port);
+    in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return sizeof(*in);
+}
+
+int socket_listen(const char *address)
+{
+    struct sockaddr_storage addr;
+    socklen_t addr_len = socket_make_address(&addr, address);
+    if (addr_len == 0) {
+        fprintf(stderr, "wrong address: %s\n", address);
+        return -1;
+    }
+
+    int fd = socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    if (addr.ss_family == AF_UNIX) {
+        unlink(((struct sockaddr_un*)&addr)->sun_path);
+    } else {
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    }
+
+    if (bind(fd, (struct sockaddr*)&addr, addr_len) != 0 || listen(fd, SOMAXCONN) != 0) {
+        perror("listen");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int socket_connect(const char *address)
+{
+    struct sockaddr_storage addr;
+    socklen_t addr_len = socket_make_address(&addr, address);
+    if (addr_len == 0) {
+        fprintf(stderr, "wrong address: %s\n", address);
+        return -1;
+    }
+
+    int fd = socket(addr.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    if (connect(fd, (struct sockaddr*)&addr, addr_len) != 0) {
+        perror("connect");
+        close(fd);
+        return -1;
+    }
+
+    if (addr.ss_family != AF_UNIX) {
+        /* request-response traffic, don't wait for more data */
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    return fd;
+}
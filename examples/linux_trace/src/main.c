@@ -0,0 +1,177 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "clip.h"
+
+#define TRACE_HEADER_SIZE   12
+#define TRACE_RECORD_SIZE   12
+
+static const char *g_event_names[] = {
+    [CLIP_TRACE_EVENT_LINE] = "LINE",
+    [CLIP_TRACE_EVENT_LOOKUP] = "LOOKUP",
+    [CLIP_TRACE_EVENT_NOT_FOUND] = "NOT_FOUND",
+    [CLIP_TRACE_EVENT_HELP] = "HELP",
+    [CLIP_TRACE_EVENT_ARGS] = "ARGS",
+    [CLIP_TRACE_EVENT_CALLBACK] = "CALLBACK",
+    [CLIP_TRACE_EVENT_DONE] = "DONE",
+    [CLIP_TRACE_EVENT_COMPLETE] = "COMPLETE",
+};
+
+static uint32_t get_le(const uint8_t *data, size_t size)
+{
+    uint32_t value = 0;
+
+    while (size-- > 0)
+        value = (value << 8) | data[size];
+    return value;
+}
+
+static uint8_t* read_all(FILE *file, size_t *size)
+{
+    size_t cap = 4096;
+    uint8_t *data = malloc(cap);
+
+    *size = 0;
+    while (data != NULL) {
+        *size += fread(&data[*size], 1, cap - *size, file);
+        if (*size < cap)
+            break;
+        cap *= 2;
+        uint8_t *tmp = realloc(data, cap);
+        if (tmp == NULL)
+            free(data);
+        data = tmp;
+    }
+    return data;
+}
+
+static size_t decode_hex_text(uint8_t *data, size_t size)
+{
+    struct clip_hex_decoder decoder;
+    size_t len = 0;
+
+    /* decoded in-place, output never overtakes input */
+    clip_utils_hex_decoder_reset(&decoder);
+    for (size_t i = 0; i < size; i++) {
+        if (isspace(data[i]))
+            continue;
+        if (clip_utils_hex_decoder_feed(&decoder, data, &len, (char)data[i]) == false)
+            return 0;
+    }
+    return len;
+}
+
+static int decode(const uint8_t *data, size_t size)
+{
+    if (size < TRACE_HEADER_SIZE || memcmp(data, CLIP_TRACE_DUMP_MAGIC, 4) != 0) {
+        fprintf(stderr, "not a trace dump\n");
+        return -1;
+    }
+    if (data[4] != CLIP_TRACE_DUMP_VERSION || data[5] != TRACE_RECORD_SIZE) {
+        fprintf(stderr, "unsupported trace dump version: %u (record size: %u)\n", data[4], data[5]);
+        return -1;
+    }
+
+    size_t names_num = get_le(&data[6], 2);
+    size_t records_num = get_le(&data[8], 4);
+    const char **names = calloc(names_num + 1, sizeof(char*));
+    if (names == NULL)
+        return -1;
+
+    size_t pos = TRACE_HEADER_SIZE;
+    for (size_t i = 0; i < names_num; i++) {
+        const uint8_t *end = memchr(&data[pos], '\0', size - pos);
+        if (end == NULL) {
+            fprintf(stderr, "truncated names table\n");
+            free(names);
+            return -1;
+        }
+        names[i] = (const char*)&data[pos];
+        pos = end - data + 1;
+    }
+
+    if (size - pos < records_num * TRACE_RECORD_SIZE) {
+        fprintf(stderr, "truncated records (%zu of %zu)\n", (size - pos) / TRACE_RECORD_SIZE, records_num);
+        records_num = (size - pos) / TRACE_RECORD_SIZE;
+    }
+
+    printf("%10s %10s  %-9s %11s  %s\n", "timestamp", "delta", "event", "code", "command");
+
+    uint32_t prev = 0;
+    for (size_t i = 0; i < records_num; i++, pos += TRACE_RECORD_SIZE) {
+        uint32_t timestamp = get_le(&data[pos], 4);
+        int32_t code = (int32_t)get_le(&data[pos + 4], 4);
+        size_t id = get_le(&data[pos + 8], 2);
+        uint8_t event = data[pos + 10];
+
+        /* unsigned subtraction handles time source wrap-around */
+        uint32_t delta = (i > 0) ? timestamp - prev : 0;
+        prev = timestamp;
+
+        const char *event_name = (event < sizeof(g_event_names) / sizeof(g_event_names[0])) ? g_event_names[event] : "?";
+        const char *name = (id < names_num) ? names[id] : "?";
+
+        printf("%10u %+10d  %-9s %11d  %s\n", (unsigned)timestamp, (int)delta, event_name, (int)code, name);
+    }
+
+    free(names);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [dump_file]\n(binary or ascii hex dump, stdin is used when file is not given)\n", argv[0]);
+        return 1;
+    }
+
+    FILE *file = (argc == 2) ? fopen(argv[1], "rb") : stdin;
+    if (file == NULL) {
+        fprintf(stderr, "can't open file: %s\n", argv[1]);
+        return 1;
+    }
+
+    size_t size;
+    uint8_t *data = read_all(file, &size);
+    if (file != stdin)
+        fclose(file);
+    if (data == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    /* dump captured from terminal may be ascii hex text */
+    if (size >= 4 && memcmp(data, CLIP_TRACE_DUMP_MAGIC, 4) != 0)
+        size = decode_hex_text(data, size);
+
+    int ret = decode(data, size);
+    free(data);
+
+    return (ret == 0) ? 0 : 1;
+}
@@ -54,6 +54,95 @@ extern "C" {
 */
 void clip_cmd_parse_line(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context);
 
+/**
+ * @brief           Function for parsing command line with dispatch result.
+ *                  It works like "clip_cmd_parse_line" (all events are notified the same way),
+ *                  but additionally returns the dispatch status, so the caller doesn't need
+ *                  stateful event callback to check if the line succeeded (e.g. for scripts).
+ * @param[in]       self
+ *                  Pointer to main clip root handler.
+ * @param[in]       cmd
+ *                  Pointer to command which is called (must be NULL for root call).
+ * @param[in/out]   cmd_line
+ *                  Input command line which contains commands/subcommands and their arguments.
+ *                  Data pointed by this pointer will be changed during function call.
+ * @param[in/out]   out
+ *                  Response writer passed to command callbacks (may be NULL), flushed once after the command.
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events or callbacks.
+ * @param[out]      result
+ *                  Pointer where detailed dispatch result will be stored (may be NULL).
+ * @return          Dispatch status (CLIP_STATUS_OK on success).
+*/
+clip_status_t clip_cmd_parse_line_ex(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result);
+
+/**
+ * @brief           Function for parsing command line without calling command callback (parse-only).
+ *                  It works like "clip_cmd_parse_line_ex" (help, not found and arguments errors are handled
+ *                  and notified the same way), but found command with parsed arguments is stored in "bound"
+ *                  and CLIP_STATUS_BOUND is returned. Bound command may be called later with "clip_cmd_invoke",
+ *                  e.g. from worker thread. Arguments values point into command line, so it must stay unchanged
+ *                  until bound command is called.
+ * @param[in]       self
+ *                  Pointer to main clip root handler.
+ * @param[in]       cmd
+ *                  Pointer to command which is called (must be NULL for root call).
+ * @param[in/out]   cmd_line
+ *                  Input command line (modified in place, referenced by bound arguments).
+ * @param[in/out]   out
+ *                  Response writer for help and built-in commands (may be NULL), flushed once after parsing.
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events and bound command callback.
+ * @param[out]      bound
+ *                  Pointer where bound command will be stored (valid only for CLIP_STATUS_BOUND).
+ * @param[out]      result
+ *                  Pointer where detailed dispatch result will be stored (may be NULL).
+ * @return          CLIP_STATUS_BOUND if command is ready to be called, other status if line was handled completely.
+*/
+clip_status_t clip_cmd_bind(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_bound_command *bound, struct clip_result *result);
+
+/**
+ * @brief           Function used to call command bound by "clip_cmd_bind".
+ *                  It may be called from any thread (callback must be thread-safe then).
+ *                  Callback stage isn't recorded by profiler and trace (they are not thread-safe).
+ * @param[in/out]   bound
+ *                  Pointer to bound command.
+ * @param[in/out]   out
+ *                  Response writer passed to command callback (may be NULL), flushed after the callback.
+ * @return          Code returned by command callback (0 - success).
+*/
+int clip_cmd_invoke(struct clip_bound_command *bound, struct clip_out *out);
+
+/**
+ * @brief           Function for parsing pipelined command line, which contains many root commands
+ *                  separated by CLIP_CONFIG_PIPELINE_SEPARATOR (separators in quotemarks or escaped are ignored).
+ *                  Commands are called back to back (like "clip_cmd_parse_line_ex"), empty commands are skipped,
+ *                  and all responses are flushed together, once after the last command.
+ * @param[in]       self
+ *                  Pointer to main clip root handler.
+ * @param[in/out]   cmd_line
+ *                  Input command line (modified in place).
+ * @param[in/out]   out
+ *                  Response writer passed to commands (may be NULL), flushed once after all commands.
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events and command callbacks.
+ * @param[in]       policy
+ *                  Error policy (stop on the first failed command or call all commands).
+ * @param[out]      result
+ *                  Pointer where result of the first failed command (or the last command if none failed) will be stored
+ *                  (may be NULL). Token offset is counted from the beginning of the whole line.
+ * @return          Status of the first failed command, or status of the last command if none failed.
+*/
+clip_status_t clip_cmd_parse_pipeline(const struct clip *self, char *cmd_line, struct clip_out *out, void *context, clip_pipeline_policy_t policy, struct clip_result *result);
+
+/**
+ * @brief           Function used to check if dispatch status means failed command line.
+ * @param[in]       status
+ *                  Dispatch status.
+ * @return          True for not found command, arguments error and command error.
+*/
+bool clip_cmd_is_error(clip_status_t status);
+
 /**
  * @brief           Function called from "clip_cmd_parse_line" function.
  *                  It performs the last stage of parsing command.
@@ -69,10 +158,976 @@ void clip_cmd_parse_line(const struct clip *self, const struct clip_command *cmd
  * @param[in/out]   cmd_line
  *                  Part of the input command line which contains command arguments.
  *                  Data pointed by this pointer will be changed during function call.
+ * @param[in/out]   out
+ *                  Response writer passed to command callbacks (may be NULL).
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events or callbacks.
+ * @param[out]      result
+ *                  Pointer where dispatch result (status, error, callback code and failing token) will be stored.
+*/
+void clip_cmd_call_command_callback(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result);
+
+/**
+ * @brief           Function called from "clip_cmd_bind" function.
+ *                  It works like "clip_cmd_call_command_callback", but command callback is not called,
+ *                  parsed arguments are stored in bound command instead (result status is CLIP_STATUS_BOUND).
+ * @param[in]       self
+ *                  Pointer to main clip root handler.
+ * @param[in]       cmd
+ *                  Pointer to command which is bound.
+ * @param[in/out]   cmd_line
+ *                  Part of the input command line which contains command arguments.
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events or callbacks.
+ * @param[out]      result
+ *                  Pointer where dispatch result will be stored.
+ * @param[out]      bound
+ *                  Pointer where bound command will be stored.
+*/
+void clip_cmd_call_bind_command(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context, struct clip_result *result, struct clip_bound_command *bound);
+
+/**
+ * @brief           Function used to call command with already decoded arguments (e.g. from binary frame).
+ *                  It works like "clip_cmd_call_command_callback", but arguments are not parsed from text,
+ *                  required arguments count, stream arguments, events, statistics, profile and trace are handled the same way.
+ * @param[in]       self
+ *                  Pointer to main clip root handler.
+ * @param[in]       cmd
+ *                  Pointer to command which callback is called.
+ * @param[in]       error
+ *                  Argument decoding error (CLIP_ARG_ERROR_NO_ERROR if all arguments were decoded).
+ * @param[in]       argc
+ *                  Number of decoded arguments.
+ * @param[in]       argv
+ *                  List of decoded arguments values (must have space for CLIP_CONFIG_ARGS_MAX_NUM items).
+ *                  If there is space, item at "argc" index should be a string token at which decoding stopped (may be NULL).
+ * @param[in/out]   out
+ *                  Response writer passed to command callbacks (may be NULL).
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events or callbacks.
+ * @param[out]      result
+ *                  Pointer where dispatch result (status, error and callback code) will be stored.
+*/
+void clip_cmd_call_decoded_args(const struct clip *self, const struct clip_command *cmd, clip_arg_error_t error, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context, struct clip_result *result);
+
+/**
+ * @brief           Function used to verify order and checksum of decoded argument.
+ *                  It's shared by text and binary arguments decoders, called for every argument after its value is decoded.
+ *                  Checked binary argument must be directly followed by UINT argument equal to checksum of its data.
+ * @param[in]       ca
+ *                  Pointer to argument descriptor (NULL for argument above descriptors list).
+ * @param[in]       av
+ *                  Pointer to decoded argument value.
+ * @param[in/out]   check
+ *                  Check type of previous checked binary argument (CLIP_ARG_CHECK_NONE at start), updated for the next argument.
+ * @param[in]       crc
+ *                  Checksum of previous checked binary argument data (computed by decoder with its value).
+ * @return          Argument error (CLIP_ARG_ERROR_CHECKSUM if checksum argument is missing or doesn't match).
+*/
+clip_arg_error_t clip_cmd_call_check_arg(const struct clip_arg *ca, const struct clip_arg_value *av, clip_arg_check_t *check, uint32_t crc);
+
+/**
+ * @brief           Function used to parse command arguments.
+ *                  Its called internally by "clip_cmd_call_command_callback" and "clip_stream_feed" functions.
+ *                  Arguments are parsed according to command arguments descriptors.
+ *                  Parsing stops on first error or when there are no more arguments in command line.
+ *                  It doesn't check if all required arguments were provided.
+ * @param[in]       cmd
+ *                  Pointer to command which arguments are parsed.
+ * @param[in/out]   cmd_line
+ *                  Part of the input command line which contains command arguments.
+ *                  Data pointed by this pointer will be changed during function call.
+ * @param[out]      argc
+ *                  Pointer where number of parsed arguments will be stored.
+ * @param[out]      argv
+ *                  List of parsed arguments values (must have space for CLIP_CONFIG_ARGS_MAX_NUM items).
+ *                  If there is space, item at "argc" index contains token at which parsing stopped (as a string).
+ * @return          Argument parsing error (CLIP_ARG_ERROR_NO_ERROR on success).
+*/
+clip_arg_error_t clip_cmd_call_parse_args(const struct clip_command *cmd, char *cmd_line, size_t *argc, struct clip_arg_value argv[]);
+
+/**
+ * @brief           Function used to postpone command completion (for asynchronous commands).
+ *                  It should be called from command callback, which starts long operation (e.g. ADC conversion
+ *                  or I2C transaction) and returns value of this function instead of blocking.
+ *                  Dispatch result is CLIP_STATUS_PENDING and the input loop may handle other commands.
+ *                  When operation is finished, application calls "clip_cmd_complete" with the same token.
+ * @param[out]      token
+ *                  Pointer to completion token (owned by user, must not be pending already).
+ * @param[in]       self
+ *                  Pointer to main clip root handler (as passed to command callback).
+ * @param[in]       cmd
+ *                  Pointer to pending command (as passed to command callback).
+ * @param[in/out]   out
+ *                  Response writer used for completion response (as passed to command callback, may be NULL).
+ * @param[in]       context
+ *                  Generic pointer which will be passed to completion event.
+ * @return          CLIP_COMMAND_PENDING (to be returned from command callback).
+*/
+int clip_cmd_pend(struct clip_pending *token, const struct clip *self, const struct clip_command *cmd, struct clip_out *out, void *context);
+
+/**
+ * @brief           Function used to check if completion token is pending.
+ * @param[in]       token
+ *                  Pointer to completion token.
+ * @return          true - command is pending, false - token is free
+*/
+bool clip_cmd_is_pending(const struct clip_pending *token);
+
+/**
+ * @brief           Function used to complete pending command.
+ *                  Completion response may be put to token "out" writer before this call.
+ *                  Token is released, the response writer is flushed and CLIP_EVENT_COMMAND_COMPLETE event is notified.
+ *                  It must be called from the same context as command line parsing (not from interrupt).
+ * @param[in/out]   token
+ *                  Pointer to pending completion token.
+ * @param[in]       code
+ *                  Completion code (0 - success).
+*/
+void clip_cmd_complete(struct clip_pending *token, int code);
+
+/**
+ * @brief           Function used to initialize command line stream reader.
+ *                  Stream reader collects input chars into command line buffer and parses complete lines.
+ *                  When command with CLIP_ARG_TYPE_HEXSTREAM argument is recognized, arguments before
+ *                  streamed argument are parsed immediately, and the streamed argument is decoded on the fly
+ *                  and passed to the argument stream callbacks in chunks. Thanks to that streamed
+ *                  data may be much bigger than command line buffer.
+ * @param[out]      self
+ *                  Pointer to stream reader to initialize.
+ * @param[in]       clip
+ *                  Pointer to main clip root handler.
+ * @param[in]       buf
+ *                  Pointer to command line buffer (it also limits the length of streamed command head).
+ * @param[in]       buf_size
+ *                  Size of command line buffer.
+ * @param[in]       chunk
+ *                  Pointer to buffer for decoded streamed data.
+ * @param[in]       chunk_size
+ *                  Size of decoded streamed data buffer (maximum size of data passed to data callback).
+*/
+void clip_stream_init(struct clip_stream *self, const struct clip *clip, char *buf, size_t buf_size, uint8_t *chunk, size_t chunk_size);
+
+/**
+ * @brief           Function used to feed command line stream reader with input data.
+ *                  Data could be fed in any portions (even char by char).
+ *                  Lines are finished with new line char ('\n'), carriage return chars are ignored.
+ *                  Too long lines (without streamed argument) are discarded.
+ *                  If "out" field is set, it is passed to callbacks and flushed after every command.
+ * @param[in/out]   self
+ *                  Pointer to stream reader.
+ * @param[in]       data
+ *                  Pointer to input data.
+ * @param[in]       size
+ *                  Number of chars in input data.
  * @param[in]       context
  *                  Generic pointer which will be passed to events or callbacks.
 */
-void clip_cmd_call_command_callback(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context);
+void clip_stream_feed(struct clip_stream *self, const char *data, size_t size, void *context);
+
+/**
+ * @brief           Function used to initialize console session.
+ *                  Session keeps all mutable state needed for serving one client (line assembly,
+ *                  streamed arguments and responses buffer). Commands tree is const and may be shared
+ *                  by many sessions, which may be used concurrently from different threads
+ *                  (every session from one thread at a time, see README for thread safety rules).
+ * @param[out]      self
+ *                  Pointer to session to initialize.
+ * @param[in]       clip
+ *                  Pointer to shared root clip handler.
+ * @param[in]       buf
+ *                  Pointer to command line buffer.
+ * @param[in]       buf_size
+ *                  Size of command line buffer.
+ * @param[in]       chunk
+ *                  Pointer to buffer for decoded streamed data.
+ * @param[in]       chunk_size
+ *                  Size of decoded streamed data buffer.
+ * @param[in]       out_buf
+ *                  Pointer to responses buffer (may be NULL if out_size is 0).
+ * @param[in]       out_size
+ *                  Size of responses buffer.
+ * @param[in]       sink
+ *                  Responses output sink (may be NULL, then responses are dropped).
+ * @param[in]       context
+ *                  Session context passed to callbacks, events and output sink.
+*/
+void clip_session_init(struct clip_session *self, const struct clip *clip, char *buf, size_t buf_size, uint8_t *chunk, size_t chunk_size, char *out_buf, size_t out_size, clip_out_sink_t sink, void *context);
+
+/**
+ * @brief           Function used to feed session with input data (in any portions, see "clip_stream_feed").
+ *                  Responses are flushed to session sink after every command.
+ * @param[in/out]   self
+ *                  Pointer to session.
+ * @param[in]       data
+ *                  Pointer to input data.
+ * @param[in]       size
+ *                  Number of chars in input data.
+*/
+void clip_session_feed(struct clip_session *self, const char *data, size_t size);
+
+/**
+ * @brief           Function used to dispatch complete command line in session (see "clip_cmd_parse_line_ex").
+ *                  Response is flushed to session sink after command.
+ * @param[in/out]   self
+ *                  Pointer to session.
+ * @param[in/out]   cmd_line
+ *                  Pointer to command line (modified in place).
+ * @param[out]      result
+ *                  Pointer to dispatch result (may be NULL).
+ * @return          Dispatch status.
+*/
+clip_status_t clip_session_dispatch(struct clip_session *self, char *cmd_line, struct clip_result *result);
+
+/**
+ * @brief           Function used to initialize lock-free single-producer/single-consumer lines queue.
+ *                  Producer (e.g. UART receive interrupt) pushes chars with "clip_queue_push_char",
+ *                  consumer (main loop) dispatches complete lines with "clip_poll".
+ * @param[out]      self
+ *                  Pointer to queue to initialize.
+ * @param[in]       buf
+ *                  Pointer to slots buffer (slot_size * slots_num bytes).
+ * @param[in]       slot_size
+ *                  Size of single slot (longest accepted line + 1).
+ * @param[in]       slots_num
+ *                  Number of slots (must be power of 2, not greater than CLIP_QUEUE_SLOTS_MAX_NUM).
+*/
+void clip_queue_init(struct clip_queue *self, char *buf, size_t slot_size, size_t slots_num);
+
+/**
+ * @brief           Function used to push single received char into queue (producer side, interrupt safe).
+ *                  Line is published on new line char ('\r' and empty lines are ignored).
+ *                  Line which doesn't fit in slot, or which begins when all slots are taken, is dropped and counted.
+ * @param[in/out]   self
+ *                  Pointer to queue.
+ * @param[in]       ch
+ *                  Received char.
+*/
+void clip_queue_push_char(struct clip_queue *self, char ch);
+
+/**
+ * @brief           Function used to push received data into queue (producer side, interrupt safe, see "clip_queue_push_char").
+ * @param[in/out]   self
+ *                  Pointer to queue.
+ * @param[in]       data
+ *                  Pointer to received data.
+ * @param[in]       size
+ *                  Number of received chars.
+*/
+void clip_queue_push(struct clip_queue *self, const char *data, size_t size);
+
+/**
+ * @brief           Function used to get the oldest complete line from queue (consumer side).
+ *                  Line stays in its slot (and may be modified in place) until "clip_queue_pop" is called.
+ * @param[in/out]   self
+ *                  Pointer to queue.
+ * @return          Pointer to zero-ended line, NULL if queue is empty.
+*/
+char* clip_queue_front(struct clip_queue *self);
+
+/**
+ * @brief           Function used to release the oldest line slot (consumer side).
+ * @param[in/out]   self
+ *                  Pointer to queue (must not be empty).
+*/
+void clip_queue_pop(struct clip_queue *self);
+
+/**
+ * @brief           Function used to dispatch all complete lines waiting in queue (consumer side, e.g. main loop).
+ *                  Only lines queued before the call are dispatched, so the call time is bounded.
+ * @param[in]       self
+ *                  Pointer to main clip root handler.
+ * @param[in/out]   queue
+ *                  Pointer to lines queue.
+ * @param[in/out]   out
+ *                  Response writer passed to commands (may be NULL), flushed after every line.
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events and command callbacks.
+ * @return          Number of dispatched lines.
+*/
+size_t clip_poll(const struct clip *self, struct clip_queue *queue, struct clip_out *out, void *context);
+
+/**
+ * @brief           Function used to initialize interactive line reader.
+ *                  Reader assembles command line in fixed buffer (no dynamic memory), handles backspace
+ *                  ('\b' or DEL), "\r", "\n" and "\r\n" line endings, and optionally echoes typed chars.
+ * @param[out]      self
+ *                  Pointer to reader to initialize.
+ * @param[in]       buf
+ *                  Pointer to command line buffer.
+ * @param[in]       buf_size
+ *                  Size of command line buffer (longest accepted line + 1).
+ * @param[in/out]   echo
+ *                  Writer for echo of typed chars, usually unbuffered writer of terminal output (may be NULL).
+*/
+void clip_reader_init(struct clip_reader *self, char *buf, size_t buf_size, struct clip_out *echo);
+
+/**
+ * @brief           Function used to attach lines history to reader (only with CLIP_CONFIG_EDITOR_ENABLED).
+ *                  Every accepted non-empty line is added to history, up and down arrow keys recall stored lines.
+ *                  Recalled line is shown directly from history ring, and copied into reader buffer only when
+ *                  it's edited or accepted.
+ * @param[in/out]   self
+ *                  Pointer to reader.
+ * @param[in/out]   history
+ *                  Pointer to initialized history (may be NULL, then history is detached).
+*/
+void clip_reader_set_history(struct clip_reader *self, struct clip_history *history);
+
+/**
+ * @brief           Function used to attach completion index to reader (only with CLIP_CONFIG_EDITOR_ENABLED).
+ *                  Tab key completes token before cursor: single candidate is inserted (with trailing space),
+ *                  common part of many candidates is inserted, otherwise candidates are listed and line is redrawn
+ *                  (after "prompt" set in reader).
+ * @param[in/out]   self
+ *                  Pointer to reader.
+ * @param[in]       complete
+ *                  Pointer to initialized completion index (may be NULL, then completion is detached).
+*/
+void clip_reader_set_complete(struct clip_reader *self, const struct clip_complete *complete);
+
+/**
+ * @brief           Function used to put single received char into reader.
+ *                  Too long lines are dropped (and counted), empty lines are skipped, other control chars are ignored.
+ *                  With CLIP_CONFIG_EDITOR_ENABLED, chars are inserted at cursor position, and ANSI escape
+ *                  sequences of left/right arrows, home, end and delete keys edit the line (up/down arrows
+ *                  recall lines from history).
+ * @param[in/out]   self
+ *                  Pointer to reader.
+ * @param[in]       ch
+ *                  Received char.
+ * @return          Pointer to complete zero-ended line (valid until the next char is put), NULL otherwise.
+*/
+char* clip_reader_put_char(struct clip_reader *self, char ch);
+
+/**
+ * @brief           Function used to feed reader with received data and dispatch every complete line.
+ *                  Lines are dispatched like "clip_cmd_parse_line_ex" (or "clip_cmd_parse_pipeline" if
+ *                  CLIP_CONFIG_PIPELINE_ENABLED is set), echo is flushed before every line and at the end.
+ * @param[in/out]   self
+ *                  Pointer to reader.
+ * @param[in]       clip
+ *                  Pointer to main clip root handler.
+ * @param[in]       data
+ *                  Pointer to received data.
+ * @param[in]       size
+ *                  Number of received bytes.
+ * @param[in/out]   out
+ *                  Response writer passed to commands (may be NULL), flushed after every line.
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events and command callbacks.
+ * @return          Number of dispatched lines.
+*/
+size_t clip_reader_feed(struct clip_reader *self, const struct clip *clip, const char *data, size_t size, struct clip_out *out, void *context);
+
+/**
+ * @brief           Function used to initialize command line history (fixed-size byte ring, no dynamic memory).
+ *                  Lines are stored as zero-ended strings one after another, the oldest lines are overwritten.
+ * @param[out]      self
+ *                  Pointer to history to initialize.
+ * @param[in]       buf
+ *                  Pointer to ring buffer.
+ * @param[in]       size
+ *                  Size of ring buffer (sum of stored lines lengths + 1 byte per line).
+*/
+void clip_history_init(struct clip_history *self, char *buf, size_t size);
+
+/**
+ * @brief           Function used to add line to history.
+ *                  Empty lines, lines bigger than the whole ring and repetitions of the newest line are not stored.
+ * @param[in/out]   self
+ *                  Pointer to history.
+ * @param[in]       line
+ *                  Pointer to line (doesn't need to be zero-ended).
+ * @param[in]       len
+ *                  Line length.
+*/
+void clip_history_add(struct clip_history *self, const char *line, size_t len);
+
+/**
+ * @brief           Function used to find stored line (without copying).
+ * @param[in]       self
+ *                  Pointer to history.
+ * @param[in]       back
+ *                  Number of steps back (1 - the newest line).
+ * @param[out]      pos
+ *                  Pointer where ring index of line beginning will be stored (line may wrap around ring end).
+ * @param[out]      len
+ *                  Pointer where line length will be stored.
+ * @return          True if line was found.
+*/
+bool clip_history_find(const struct clip_history *self, size_t back, size_t *pos, size_t *len);
+
+/**
+ * @brief           Function used to copy stored line into buffer (e.g. when recalled line is selected).
+ * @param[in]       self
+ *                  Pointer to history.
+ * @param[in]       pos
+ *                  Ring index of line beginning (see "clip_history_find").
+ * @param[in]       len
+ *                  Line length.
+ * @param[out]      buf
+ *                  Pointer to destination buffer (line is zero-ended, and truncated if needed).
+ * @param[in]       buf_size
+ *                  Size of destination buffer.
+ * @return          Number of copied chars (without terminating zero).
+*/
+size_t clip_history_copy(const struct clip_history *self, size_t pos, size_t len, char *buf, size_t buf_size);
+
+/**
+ * @brief           Function used to write stored line into response writer (without copying into temporary buffer).
+ * @param[in]       self
+ *                  Pointer to history.
+ * @param[in]       pos
+ *                  Ring index of line beginning (see "clip_history_find").
+ * @param[in]       len
+ *                  Line length.
+ * @param[in/out]   out
+ *                  Pointer to response writer (may be NULL).
+*/
+void clip_history_put(const struct clip_history *self, size_t pos, size_t len, struct clip_out *out);
+
+/**
+ * @brief           Function used to execute script (many command lines) from memory, e.g. from memory-mapped file.
+ *                  Lines are split and zero-ended in place (without copying), '\r' before new line is removed,
+ *                  empty lines and lines beginning with '#' are skipped. Every line is dispatched like
+ *                  "clip_cmd_parse_line_ex" (or "clip_cmd_parse_pipeline" if CLIP_CONFIG_PIPELINE_ENABLED is set).
+ * @param[in]       self
+ *                  Pointer to main clip root handler.
+ * @param[in/out]   script
+ *                  Pointer to script (modified in place). One writable byte must follow the script (for zero-ending
+ *                  the last line if it's not ended with new line char).
+ * @param[in]       size
+ *                  Script size.
+ * @param[in/out]   out
+ *                  Response writer passed to commands (may be NULL).
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events, command callbacks and report function.
+ * @param[in]       policy
+ *                  Error policy (stop on the first failed line or execute all lines).
+ * @param[in]       report
+ *                  Function called after every dispatched line (may be NULL).
+ * @param[out]      result
+ *                  Pointer where batch summary will be stored (may be NULL).
+ * @return          True if all lines succeeded.
+*/
+bool clip_batch_run(const struct clip *self, char *script, size_t size, struct clip_out *out, void *context, clip_pipeline_policy_t policy, clip_batch_report_t report, struct clip_batch_result *result);
+
+/**
+ * @brief           Function used to initialize binary framed transport (for machine-to-machine sessions).
+ *                  Request frame (before COBS encoding): sequence number (u8), command ID (u16 LE, "clip_index" ID,
+ *                  written explicitly for every command by "clip_schema_put_binary" and "clip_schema_put_json"), then arguments: type (u8, clip_arg_type_t) and value.
+ *                  Values: BOOL - u8, INT, UINT and FLOAT - 4 bytes LE, STRING - zero terminated chars,
+ *                  HEXARRAY and HEXSTREAM - packed bytes array (length header like "clip_utils_arg_unpack_hexarray": u8 length
+ *                  below 0x80, or 0x80 | n and n-byte LE length (n up to 4), then data). Values are used in place, without copying.
+ *                  Type must match argument descriptor (CLIP_ARG_ERROR_TYPE_MISMATCH), arguments above descriptors list
+ *                  may have any type. Checked arrays are verified with the following UINT argument, like in text.
+ *                  Response frames: sequence number (u8), status (u8), payload. Not final parts of long response have
+ *                  CLIP_FRAME_STATUS_MORE status, final frame has clip_status_t status (for CLIP_STATUS_ARGUMENTS_ERROR
+ *                  payload is failed argument index (u8) and clip_arg_error_t (u8)).
+ *                  Frames are COBS encoded and ended with CLIP_FRAME_DELIMITER.
+ * @param[out]      self
+ *                  Pointer to framed transport to initialize.
+ * @param[in]       clip
+ *                  Pointer to main clip root handler.
+ * @param[in]       index
+ *                  Pointer to initialized commands index (used only at init).
+ * @param[out]      commands
+ *                  Commands table indexed by ID (filled at init, must have space for index "count" items).
+ * @param[in]       commands_num
+ *                  Number of commands table entries.
+ * @param[in]       rx
+ *                  Pointer to receive buffer (longest accepted encoded frame, without delimiter).
+ * @param[in]       rx_size
+ *                  Size of receive buffer.
+ * @param[in]       tx
+ *                  Pointer to transmit buffer (response frame is built and COBS encoded in place).
+ * @param[in]       tx_size
+ *                  Size of transmit buffer (payload space is smaller by header size and COBS overhead).
+ * @param[in]       sink
+ *                  Frames sink function (may be NULL, then responses are dropped).
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events, command callbacks and frames sink.
+ * @return          True if succeeded (commands table and transmit buffer are big enough).
+*/
+bool clip_frame_init(struct clip_frame *self, const struct clip *clip, const struct clip_index *index, const struct clip_command **commands, size_t commands_num, uint8_t *rx, size_t rx_size, uint8_t *tx, size_t tx_size, clip_frame_sink_t sink, void *context);
+
+/**
+ * @brief           Function used to feed framed transport with received bytes (e.g. from serial port).
+ *                  Every complete frame is decoded and dispatched, response frames are passed to sink
+ *                  before function returns. Broken frames are dropped without response.
+ * @param[in/out]   self
+ *                  Pointer to framed transport.
+ * @param[in]       data
+ *                  Pointer to received bytes.
+ * @param[in]       size
+ *                  Number of received bytes.
+ * @return          Number of dispatched frames.
+*/
+size_t clip_frame_feed(struct clip_frame *self, const uint8_t *data, size_t size);
+
+/**
+ * @brief           Function used to COBS encode data (without delimiter).
+ *                  Encoding may be done in place, when destination starts at least CLIP_FRAME_COBS_OVERHEAD(size) + 1
+ *                  bytes before source.
+ * @param[out]      dst
+ *                  Pointer to destination buffer (size + CLIP_FRAME_COBS_OVERHEAD(size) bytes).
+ * @param[in]       src
+ *                  Pointer to data to encode.
+ * @param[in]       size
+ *                  Size of data to encode.
+ * @return          Encoded data size.
+*/
+size_t clip_frame_cobs_encode(uint8_t *dst, const uint8_t *src, size_t size);
+
+/**
+ * @brief           Function used to COBS decode data in place (without delimiter).
+ * @param[in/out]   buf
+ *                  Pointer to encoded data (replaced by decoded data).
+ * @param[in]       size
+ *                  Size of encoded data.
+ * @param[out]      len
+ *                  Pointer where decoded data size will be stored.
+ * @return          True if succeeded, false if encoding is broken (zero byte or block longer than data).
+*/
+bool clip_frame_cobs_decode(uint8_t *buf, size_t size, size_t *len);
+
+/**
+ * @brief           Function used to build root commands list from commands registered in linker section
+ *                  (see CLIP_REGISTER_ROOT_COMMAND, compiled only with CLIP_CONFIG_SECTION_ENABLED on ELF targets).
+ *                  Registered commands are sorted by names in place (once, without copying), so root commands
+ *                  are looked up with binary search. Object which holds only registrations is dropped from
+ *                  static archive unless something else references it (link such modules as objects),
+ *                  and with "--gc-sections" the section needs KEEP in linker script (or "retain" attribute),
+ *                  because "used" attribute only keeps it from compiler. Section is sorted in place, so it must be
+ *                  writable and initialized at startup: with custom linker script (e.g. MCU) put it inside ".data"
+ *                  output section (RAM, copied from flash by startup code, with "__start_clip_commands" and
+ *                  "__stop_clip_commands" bounds defined by the script), not into flash with ".rodata".
+ * @param[in/out]   self
+ *                  Pointer to main clip root handler (must be mutable, "commands" and "commands_num" are set).
+ * @return          True if succeeded, false if there are duplicated names (only one of them could be found).
+*/
+bool clip_section_init(struct clip *self);
+
+/**
+ * @brief           Function used to initialize buffered response writer.
+ *                  Command callbacks put response data into writer buffer, and the whole response
+ *                  is passed to the sink once (on flush), instead of many small writes.
+ *                  When data doesn't fit into buffer, buffer is flushed automatically.
+ * @param[out]      self
+ *                  Pointer to response writer to initialize.
+ * @param[in]       buf
+ *                  Pointer to response buffer (may be NULL if buf_size is 0, then every put goes directly to sink).
+ * @param[in]       buf_size
+ *                  Size of response buffer.
+ * @param[in]       sink
+ *                  Output sink function (may be NULL, then response is dropped).
+ * @param[in]       context
+ *                  Generic pointer for sink usage.
+*/
+void clip_out_init(struct clip_out *self, char *buf, size_t buf_size, clip_out_sink_t sink, void *context);
+
+/**
+ * @brief           Function used to pass buffered response to the sink.
+ *                  Its called internally by "clip_cmd_parse_line_ex" after every command.
+ * @param[in/out]   self
+ *                  Pointer to response writer (may be NULL).
+*/
+void clip_out_flush(struct clip_out *self);
+
+/**
+ * @brief           Function used to put raw bytes into response.
+ *                  Data bigger than the whole buffer is passed to the sink directly, without copying.
+ * @param[in/out]   self
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       data
+ *                  Pointer to data.
+ * @param[in]       size
+ *                  Number of bytes.
+*/
+void clip_out_put_bytes(struct clip_out *self, const void *data, size_t size);
+
+/**
+ * @brief           Function used to put zero-ended string into response.
+ * @param[in/out]   self
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       str
+ *                  Pointer to zero-ended string.
+*/
+void clip_out_put_str(struct clip_out *self, const char *str);
+
+/**
+ * @brief           Function used to put unsigned integer into response (decimal format).
+ * @param[in/out]   self
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       value
+ *                  Value to put.
+*/
+void clip_out_put_u32(struct clip_out *self, uint32_t value);
+
+/**
+ * @brief           Function used to put binary data into response (ascii hex format, upper-case).
+ * @param[in/out]   self
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       data
+ *                  Pointer to data.
+ * @param[in]       size
+ *                  Number of bytes.
+*/
+void clip_out_put_hex(struct clip_out *self, const uint8_t *data, size_t size);
+
+/**
+ * @brief           Function used to put command path into response (names separated with spaces, "." for root).
+ * @param[in/out]   self
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       path
+ *                  Pointer to command path.
+*/
+void clip_out_put_path(struct clip_out *self, const struct clip_path *path);
+
+/**
+ * @brief           Function used to write help for list of commands (one "usage - description" line per command).
+ *                  Text is streamed to response writer in one pass, without intermediate buffers.
+ *                  Subcommands are indented by two spaces per level.
+ *                  It may be used in help event handler with "help.commands" list.
+ * @param[in/out]   out
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       commands
+ *                  List of commands (last item is NULL, may be NULL).
+ * @param[in]       depth
+ *                  Number of written levels (1 - only listed commands, CLIP_HELP_DEPTH_ALL - whole subtrees).
+ *                  Depth is limited to CLIP_CONFIG_HELP_MAX_DEPTH, subcommands cut by this limit
+ *                  are replaced with single "..." line.
+*/
+void clip_help_put_commands(struct clip_out *out, const struct clip_command **commands, size_t depth);
+
+/**
+ * @brief           Function used to write help for single command and its subcommands.
+ * @param[in/out]   out
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       cmd
+ *                  Pointer to command.
+ * @param[in]       depth
+ *                  Number of written subcommands levels (0 - only command, CLIP_HELP_DEPTH_ALL - whole subtree).
+ *                  Depth is limited to CLIP_CONFIG_HELP_MAX_DEPTH, subcommands cut by this limit
+ *                  are replaced with single "..." line.
+*/
+void clip_help_put_command(struct clip_out *out, const struct clip_command *cmd, size_t depth);
+
+/**
+ * @brief           Function used to write machine-readable schema of commands tree as compact JSON.
+ *                  Schema contains commands names, descriptions, arguments names, types and flags.
+ *                  It is streamed to response writer (no allocation, recursion depth follows the tree).
+ *                  Format: {"version":1,"help":"?","commands":[{"id":1,"name":..,"description":..,"callable":true,
+ *                  "args":[{"name":..,"description":..,"type":"UINT","optional":true,"check":"CRC32"}],"commands":[..]}]}
+ *                  (keys with default values: null description, false flags, empty lists and no check are omitted).
+ *                  "id" is "clip_index" ID of command (shared command is written under every parent, with the same ID).
+ * @param[in/out]   out
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       index
+ *                  Pointer to initialized commands index (of described clip handler).
+*/
+void clip_schema_put_json(struct clip_out *out, const struct clip_index *index);
+
+/**
+ * @brief           Function used to write schema of commands tree in binary form (the same content as JSON).
+ *                  Image: magic (CLIP_SCHEMA_MAGIC), version (u8), help command (string), root commands list.
+ *                  Commands list: count (u16 LE), then for every command: ID (u16 LE, "clip_index" ID), name and
+ *                  description (strings), flags (u8, CLIP_SCHEMA_FLAG_CALLABLE), args count (u16 LE), args,
+ *                  subcommands list (recursively). Argument: name and description (strings), type (u8, clip_arg_type_t),
+ *                  check (u8, clip_arg_check_t), flags (u8, CLIP_SCHEMA_FLAG_OPTIONAL). Strings are zero terminated
+ *                  (NULL written as empty). Shared command is written under every parent, with the same ID.
+ * @param[in/out]   out
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       index
+ *                  Pointer to initialized commands index (of described clip handler).
+*/
+void clip_schema_put_binary(struct clip_out *out, const struct clip_index *index);
+
+/**
+ * @brief           Function used to initialize commands index.
+ *                  Command descriptors are const (may be placed in flash), so runtime tables (e.g. profiler
+ *                  histograms) are indexed by command ID. IDs are assigned in commands tree order
+ *                  (depth first, starting from 1, 0 is reserved for root), so they don't depend on descriptors addresses.
+ *                  Commands are stored in hash table, so getting ID doesn't walk the commands tree.
+ * @param[out]      self
+ *                  Pointer to commands index to initialize.
+ * @param[in]       clip
+ *                  Pointer to main clip root handler.
+ * @param[in]       entries
+ *                  Hash table slots (owned by user).
+ * @param[in]       size
+ *                  Number of hash table slots (must be bigger than number of commands, twice as big is recommended).
+ * @return          Initialization status. true - success, false - too small hash table
+*/
+bool clip_index_init(struct clip_index *self, const struct clip *clip, struct clip_index_entry *entries, size_t size);
+
+/**
+ * @brief           Function used to get command ID.
+ * @param[in]       self
+ *                  Pointer to commands index.
+ * @param[in]       cmd
+ *                  Pointer to command (NULL for root).
+ * @return          Command ID (CLIP_INDEX_INVALID_ID for not indexed command).
+*/
+size_t clip_index_get_id(const struct clip_index *self, const struct clip_command *cmd);
+
+/**
+ * @brief           Function used to get command by ID (slow, it scans the whole hash table).
+ * @param[in]       self
+ *                  Pointer to commands index.
+ * @param[in]       id
+ *                  Command ID.
+ * @return          Pointer to command (NULL for root or unknown ID).
+*/
+const struct clip_command* clip_index_get_command(const struct clip_index *self, size_t id);
+
+/**
+ * @brief           Function used to walk commands tree in ID order.
+ *                  Visitor is called for root (ID 0, path with NULL command) and then for every command.
+ * @param[in]       self
+ *                  Pointer to commands index.
+ * @param[in]       visitor
+ *                  Function called for every command (with its full path).
+ * @param[in]       context
+ *                  Generic pointer which will be passed to visitor.
+*/
+void clip_index_walk(const struct clip_index *self, clip_index_visitor_t visitor, void *context);
+
+/**
+ * @brief           Function used to initialize completion index.
+ *                  Every subcommands list is copied into names table and sorted by names (without dynamic memory),
+ *                  so candidates for typed prefix are found with binary search, also in big commands trees.
+ *                  List shared by many commands (the same "commands" array) is copied only once.
+ * @param[out]      self
+ *                  Pointer to completion index to initialize.
+ * @param[in]       index
+ *                  Pointer to initialized commands index.
+ * @param[out]      names
+ *                  Pointer to sorted names table.
+ * @param[in]       names_size
+ *                  Size of sorted names table (sum of distinct subcommands lists lengths, at most index "count" - 1
+ *                  when commands are not shared, every shared list is counted once).
+ * @param[out]      ranges
+ *                  Pointer to ranges table.
+ * @param[in]       ranges_num
+ *                  Number of ranges table entries (usually index "count").
+ * @return          True if all commands lists were indexed.
+*/
+bool clip_complete_init(struct clip_complete *self, const struct clip_index *index, const struct clip_command **names, size_t names_size, struct clip_complete_range *ranges, size_t ranges_num);
+
+/**
+ * @brief           Function used to find completion candidates of partial command line.
+ *                  Complete tokens select subcommands (or are counted as arguments of the last command), the last
+ *                  token (empty if line ends with space) is completed: with subcommands names, with bool argument
+ *                  keywords, or with hint of the next argument.
+ * @param[in]       self
+ *                  Pointer to completion index.
+ * @param[in]       line
+ *                  Pointer to partial command line (not modified, doesn't need to be zero-ended).
+ * @param[in]       len
+ *                  Length of partial command line (e.g. cursor position).
+ * @param[out]      candidates
+ *                  Pointer to candidates table (in names order).
+ * @param[in]       size
+ *                  Size of candidates table.
+ * @param[out]      result
+ *                  Pointer where completion summary will be stored.
+ * @return          Number of candidates stored in table.
+*/
+size_t clip_complete_line(const struct clip_complete *self, const char *line, size_t len, struct clip_candidate *candidates, size_t size, struct clip_completion *result);
+
+/**
+ * @brief           Function used to initialize latency profiler.
+ *                  Profiler is used by dispatch functions only if CLIP_CONFIG_PROFILE_ENABLED is set
+ *                  and the profiler is attached to root handler ("profile" field).
+ *                  Every dispatch stage (see clip_profile_stage_t) is measured with user time source,
+ *                  and recorded in log2 histogram of the command. Tokenize and lookup stages are
+ *                  recorded for tree node which searches subcommand (root for first level).
+ * @param[out]      self
+ *                  Pointer to profiler to initialize.
+ * @param[in]       index
+ *                  Pointer to initialized commands index.
+ * @param[in]       entries
+ *                  Histograms table (owned by user, one entry per command ID, cleared during init).
+ * @param[in]       entries_num
+ *                  Number of histograms table entries (usually index "count").
+ * @param[in]       time
+ *                  Time source function (e.g. cycles counter or microseconds timer).
+ * @param[in]       time_context
+ *                  Generic pointer for time source usage.
+*/
+void clip_profile_init(struct clip_profile *self, const struct clip_index *index, struct clip_profile_entry *entries, size_t entries_num, clip_profile_time_t time, void *time_context);
+
+/**
+ * @brief           Function used to clear all profiler histograms.
+ * @param[in/out]   self
+ *                  Pointer to profiler.
+*/
+void clip_profile_reset(struct clip_profile *self);
+
+/**
+ * @brief           Function used to get current time from profiler time source.
+ * @param[in]       self
+ *                  Pointer to profiler.
+ * @return          Current time ticks.
+*/
+uint32_t clip_profile_now(const struct clip_profile *self);
+
+/**
+ * @brief           Function used to record single latency sample.
+ * @param[in/out]   self
+ *                  Pointer to profiler.
+ * @param[in]       cmd
+ *                  Pointer to measured command (NULL for root).
+ * @param[in]       stage
+ *                  Measured dispatch stage.
+ * @param[in]       ticks
+ *                  Measured latency.
+*/
+void clip_profile_record(struct clip_profile *self, const struct clip_command *cmd, clip_profile_stage_t stage, uint32_t ticks);
+
+/**
+ * @brief           Function used to record latency since "start" time, and to get the current time.
+ *                  Its called internally by dispatch functions between stages.
+ * @param[in/out]   self
+ *                  Pointer to profiler.
+ * @param[in]       cmd
+ *                  Pointer to measured command (NULL for root).
+ * @param[in]       stage
+ *                  Measured dispatch stage.
+ * @param[in]       start
+ *                  Time of stage start.
+ * @return          Current time ticks (start of the next stage).
+*/
+uint32_t clip_profile_lap(struct clip_profile *self, const struct clip_command *cmd, clip_profile_stage_t stage, uint32_t start);
+
+/**
+ * @brief           Function used to dump profiler histograms as text.
+ *                  Every non-empty histogram is one line: full command path, stage name and non-empty
+ *                  buckets labeled with their lower bound, e.g. "gpio set pin args: 2+:10 4+:1".
+ * @param[in]       self
+ *                  Pointer to profiler.
+ * @param[in/out]   out
+ *                  Response writer for the dump (it is not flushed).
+*/
+void clip_profile_dump(const struct clip_profile *self, struct clip_out *out);
+
+/**
+ * @brief           Function used to initialize statistics counters.
+ *                  Counters are used by dispatch functions only if CLIP_CONFIG_STATS_ENABLED is set
+ *                  and the statistics are attached to root handler ("stats" field).
+ *                  Then also built-in root command CLIP_CONFIG_STATS_COMMAND is supported (if not defined by user),
+ *                  which dumps all counters to response writer.
+ * @param[out]      self
+ *                  Pointer to statistics to initialize.
+ * @param[in]       index
+ *                  Pointer to initialized commands index.
+ * @param[in]       entries
+ *                  Counters table (owned by user, one entry per command ID, cleared during init).
+ * @param[in]       entries_num
+ *                  Number of counters table entries (usually index "count").
+*/
+void clip_stats_init(struct clip_stats *self, const struct clip_index *index, struct clip_stats_entry *entries, size_t entries_num);
+
+/**
+ * @brief           Function used to clear all statistics counters.
+ * @param[in/out]   self
+ *                  Pointer to statistics.
+*/
+void clip_stats_reset(struct clip_stats *self);
+
+/**
+ * @brief           Function used to increment single counter (saturated).
+ *                  Its called internally by dispatch functions.
+ * @param[in/out]   self
+ *                  Pointer to statistics.
+ * @param[in]       cmd
+ *                  Pointer to counted command (NULL for root).
+ * @param[in]       counter
+ *                  Counter to increment.
+*/
+void clip_stats_inc(struct clip_stats *self, const struct clip_command *cmd, clip_stats_counter_t counter);
+
+/**
+ * @brief           Function used to get counters of single command.
+ * @param[in]       self
+ *                  Pointer to statistics.
+ * @param[in]       cmd
+ *                  Pointer to command (NULL for root).
+ * @return          Pointer to command counters (NULL if command is not counted).
+*/
+const struct clip_stats_entry* clip_stats_get(const struct clip_stats *self, const struct clip_command *cmd);
+
+/**
+ * @brief           Function used to dump statistics counters as text.
+ *                  Every command with non-zero counters is one line: full command path and non-zero
+ *                  counters, e.g. "gpio set: calls=10 arg_errors=2".
+ * @param[in]       self
+ *                  Pointer to statistics.
+ * @param[in/out]   out
+ *                  Response writer for the dump (it is not flushed).
+*/
+void clip_stats_dump(const struct clip_stats *self, struct clip_out *out);
+
+/**
+ * @brief           Function used to initialize trace ring buffer.
+ *                  Trace is used by dispatch functions only if CLIP_CONFIG_TRACE_ENABLED is set
+ *                  and the trace is attached to root handler ("trace" field).
+ *                  Every dispatch stage writes fixed-size binary record (timestamp, command ID, event type and code),
+ *                  without any formatting. When buffer is full, the oldest records are overwritten.
+ * @param[out]      self
+ *                  Pointer to trace to initialize.
+ * @param[in]       index
+ *                  Pointer to initialized commands index.
+ * @param[in]       records
+ *                  Records buffer (owned by user).
+ * @param[in]       size
+ *                  Number of records in buffer (must be power of 2).
+ * @param[in]       time
+ *                  Time source function (e.g. cycles counter or microseconds timer).
+ * @param[in]       time_context
+ *                  Generic pointer for time source usage.
+*/
+void clip_trace_init(struct clip_trace *self, const struct clip_index *index, struct clip_trace_record *records, size_t size, clip_trace_time_t time, void *time_context);
+
+/**
+ * @brief           Function used to write single trace record.
+ *                  Its called internally by dispatch functions (single writer, record is published after it is written).
+ * @param[in/out]   self
+ *                  Pointer to trace.
+ * @param[in]       event
+ *                  Record type.
+ * @param[in]       cmd
+ *                  Pointer to traced command (NULL for root).
+ * @param[in]       code
+ *                  Event specific code.
+*/
+void clip_trace_write(struct clip_trace *self, clip_trace_event_t event, const struct clip_command *cmd, int32_t code);
+
+/**
+ * @brief           Function used to copy the newest trace records (in write order).
+ * @param[in]       self
+ *                  Pointer to trace.
+ * @param[out]      records
+ *                  Buffer for copied records.
+ * @param[in]       max
+ *                  Maximum number of copied records.
+ * @return          Number of copied records.
+*/
+size_t clip_trace_read(const struct clip_trace *self, struct clip_trace_record *records, size_t max);
+
+/**
+ * @brief           Function used to dump trace as binary image (decoded on host by "clip_trace_decode" tool).
+ *                  Image contains header (magic CLIP_TRACE_DUMP_MAGIC, version, record size, number of names
+ *                  and records), zero-ended command paths in ID order and records (all integers little-endian).
+ *                  It should be called from dispatch context (e.g. from command callback).
+ * @param[in]       self
+ *                  Pointer to trace.
+ * @param[in/out]   out
+ *                  Response writer for the dump (it is not flushed).
+*/
+void clip_trace_dump(const struct clip_trace *self, struct clip_out *out);
 
 /**
  * @brief           Function used to get first argument from input command line.
@@ -89,6 +1144,15 @@ void clip_cmd_call_command_callback(const struct clip *self, const struct clip_c
 */
 char* clip_utils_arg_get_first(char **arg, char *cmd_line);
 
+/**
+ * @brief           Function used to split the first command from pipelined command line.
+ *                  The first CLIP_CONFIG_PIPELINE_SEPARATOR outside quotemarks (and not escaped) is replaced by zero byte.
+ * @param[in/out]   cmd_line
+ *                  Pointer to input command line (modified in place).
+ * @return          Pointer to the rest of command line (after separator), NULL if there is no more commands.
+*/
+char* clip_utils_arg_split_command(char *cmd_line);
+
 /**
  * @brief           Function used to convert argument type enum to string.
  * @param[in]       type
@@ -123,20 +1187,30 @@ const char* clip_utils_arg_get_error_string(clip_arg_error_t error);
 char* clip_utils_arg_update_buf(char *buf, size_t *buf_size, size_t *out_size, size_t size);
 
 /**
- * @brief           Helper function for generate command usage string.
- *                  It bases on command and its arguments descriptors.
- *                  This is only internal implementation which works out-of-the-box.
- *                  User can implement his own usage string for commands.
+ * @brief           Helper function for generate command usage string (e.g. "cmd <arg:UINT> [opt:INT]").
+ *                  Precomputed command usage (see CLIP_DEF_COMMAND_WITH_USAGE) is only copied,
+ *                  otherwise usage is generated from command and its arguments descriptors.
+ *                  Output is always zero terminated (truncated when buffer is too small).
  * @param[out]      buf
  *                  Pointer to buffer where usage string will be stored.
  * @param[in]       buf_size
  *                  How many chars can be stored in output buffer.
  * @param[in]       cmd
  *                  Pointer to command for which we want to generate usage string.
- * @return          How many chars was stored in output buffer (without zero byte at the end).
+ * @return          Full usage string length (without zero byte at the end), output is truncated when not less than "buf_size".
 */
 size_t clip_utils_arg_get_command_usage_string(char *buf, size_t buf_size, const struct clip_command *cmd);
 
+/**
+ * @brief           Function used to write command usage string to response writer (without intermediate buffer).
+ *                  Precomputed command usage is written as is, otherwise it is generated from arguments descriptors.
+ * @param[in]       out
+ *                  Pointer to response writer (may be NULL).
+ * @param[in]       cmd
+ *                  Pointer to command for which we want to write usage string.
+*/
+void clip_utils_arg_put_command_usage(struct clip_out *out, const struct clip_command *cmd);
+
 /**
  * @brief           Function used to unpack hexarray argument value.
  *                  For avoid dynamic allocation, hex arrays are stored in place in command line input.
@@ -153,9 +1227,23 @@ size_t clip_utils_arg_get_command_usage_string(char *buf, size_t buf_size, const
 */
 size_t clip_utils_arg_unpack_hexarray(uint8_t **data, clip_hexarray_t hex_array);
 
+/**
+ * @brief           Function used to validate layout of checked binary argument descriptors.
+ *                  Checksum of binary data is verified against the next argument,
+ *                  so it must be required argument of CLIP_ARG_TYPE_UINT type.
+ * @param[in]       args
+ *                  Pointer to NULL terminated arguments descriptors list.
+ * @param[in]       index
+ *                  Index of binary argument in "args" list.
+ * @return          True if argument is not checked or it is followed by required checksum argument.
+*/
+bool clip_utils_arg_has_checksum(const struct clip_arg **args, size_t index);
+
 /**
  * @brief           Function used to notify CLIP_EVENT_HELP event.
  *                  Its called internally by "clip_cmd_parse_line" function.
+ *                  Event is skipped when masked in "event_mask", and dispatched to per-event handler
+ *                  (if defined in "event_handlers") instead of generic event callback.
  * @param[in]       context
  *                  Generic pointer which will be passed to event callbacks.
  * @param[in]       cmd
@@ -168,6 +1256,8 @@ void clip_notify_event_help(const struct clip *self, void *context, const struct
 /**
  * @brief           Function used to notify CLIP_EVENT_COMMAND_NOT_FOUND event.
  *                  Its called internally by "clip_cmd_parse_line" function.
+ *                  Event is skipped when masked in "event_mask", and dispatched to per-event handler
+ *                  (if defined in "event_handlers") instead of generic event callback.
  * @param[in]       context
  *                  Generic pointer which will be passed to event callbacks.
  * @param[in]       cmd
@@ -180,6 +1270,8 @@ void clip_notify_event_command_not_found(const struct clip *self, void *context,
 /**
  * @brief           Function used to notify CLIP_EVENT_ARGUMENTS_ERROR event.
  *                  Its called internally by "clip_cmd_parse_line" function.
+ *                  Event is skipped when masked in "event_mask", and dispatched to per-event handler
+ *                  (if defined in "event_handlers") instead of generic event callback.
  * @param[in]       context
  *                  Generic pointer which will be passed to event callbacks.
  * @param[in]       cmd
@@ -192,6 +1284,8 @@ void clip_notify_event_arguments_error(const struct clip *self, void *context, c
 /**
  * @brief           Function used to notify CLIP_EVENT_CALL_COMMAND_CALLBACK event.
  *                  Its called internally by "clip_cmd_parse_line" function.
+ *                  Event is skipped when masked in "event_mask", and dispatched to per-event handler
+ *                  (if defined in "event_handlers") instead of generic event callback.
  * @param[in]       context
  *                  Generic pointer which will be passed to event callbacks.
  * @param[in]       cmd
@@ -201,6 +1295,20 @@ void clip_notify_event_arguments_error(const struct clip *self, void *context, c
 */
 void clip_notify_event_call_command_callback(const struct clip *self, void *context, const struct clip_command *cmd, const char *cmd_line);
 
+/**
+ * @brief           Function used to notify CLIP_EVENT_COMMAND_COMPLETE event.
+ *                  Its called internally by "clip_cmd_complete" function.
+ *                  Event is skipped when masked in "event_mask", and dispatched to per-event handler
+ *                  (if defined in "event_handlers") instead of generic event callback.
+ * @param[in]       context
+ *                  Generic pointer which will be passed to event callbacks.
+ * @param[in]       cmd
+ *                  Pointer to completed command which will be placed in event arguments.
+ * @param[in]       code
+ *                  Completion code which will be placed in event arguments.
+*/
+void clip_notify_event_command_complete(const struct clip *self, void *context, const struct clip_command *cmd, int code);
+
 /**
  * @brief           Function used to convert single nibble byte (0-15) to char ('0'-'9', 'A'-'F')
  *                  It uses upper-case characters for encoding.
@@ -255,6 +1363,30 @@ bool clip_utils_hex_from_buf(char *hex, const uint8_t *buf, size_t buf_size);
 */
 bool clip_utils_hex_to_buf(uint8_t *buf, const char *hex, size_t hex_size);
 
+/**
+ * @brief           Function used to reset incremental ascii hex decoder.
+ * @param[out]      decoder
+ *                  Pointer to decoder state.
+*/
+void clip_utils_hex_decoder_reset(struct clip_hex_decoder *decoder);
+
+/**
+ * @brief           Function used to decode ascii hex array incrementally, char by char.
+ *                  It supports lower- and upper-case characters.
+ *                  Every second successfully decoded char appends one byte to the output buffer.
+ *                  User needs to be sure that the output buffer has space for at least one byte.
+ * @param[in/out]   decoder
+ *                  Pointer to decoder state.
+ * @param[out]      buf
+ *                  Pointer to output buffer.
+ * @param[in/out]   buf_len
+ *                  Number of bytes in output buffer (increased when byte is decoded).
+ * @param[in]       ch
+ *                  Ascii hex char to decode.
+ * @return          Decoding status. true - success, false - error
+*/
+bool clip_utils_hex_decoder_feed(struct clip_hex_decoder *decoder, uint8_t *buf, size_t *buf_len, const char ch);
+
 /**
  * @brief           Function used by "clip_cmd_call_command_callback" function.
  *                  Its used for parsing CLIP_ARG_TYPE_BOOL argument.
@@ -322,6 +1454,67 @@ bool clip_utils_parse_float(struct clip_arg_value *argv, const char *arg);
 */
 bool clip_utils_parse_hexarray(struct clip_arg_value *argv, char *arg);
 
+/**
+ * @brief           Function used by "clip_cmd_call_command_callback" function.
+ *                  Its used for parsing CLIP_ARG_TYPE_HEXARRAY argument with optional integrity check.
+ *                  It works like "clip_utils_parse_hexarray", but checksum is computed inside decoding loop,
+ *                  so the decoded data don't need to be processed again.
+ * @param[out]      argv
+ *                  Argument value contains type and parsed data.
+ * @param[in]       arg
+ *                  Pointer to string representation of value which will be parsed.
+ * @param[in]       check
+ *                  Type of integrity check to compute (CLIP_ARG_CHECK_NONE for no checksum).
+ * @param[out]      crc
+ *                  Pointer where computed checksum will be stored (may be NULL for CLIP_ARG_CHECK_NONE).
+ * @return          Parsing status. true - success, false - error
+*/
+bool clip_utils_parse_hexarray_crc(struct clip_arg_value *argv, char *arg, clip_arg_check_t check, uint32_t *crc);
+
+/**
+ * @brief           Function used to get initial value of checksum.
+ * @param[in]       check
+ *                  Type of integrity check.
+ * @return          Initial checksum value.
+*/
+uint32_t clip_utils_crc_init(clip_arg_check_t check);
+
+/**
+ * @brief           Function used to update checksum with single byte.
+ *                  It's designed to be called from decoding loops, byte by byte.
+ *                  Lookup tables size depends on CLIP_CONFIG_CRC_TABLE_BITS.
+ * @param[in]       check
+ *                  Type of integrity check.
+ * @param[in]       crc
+ *                  Current checksum value.
+ * @param[in]       byte
+ *                  Data byte.
+ * @return          Updated checksum value.
+*/
+uint32_t clip_utils_crc_update(clip_arg_check_t check, uint32_t crc, const uint8_t byte);
+
+/**
+ * @brief           Function used to finalize checksum computation.
+ * @param[in]       check
+ *                  Type of integrity check.
+ * @param[in]       crc
+ *                  Current checksum value.
+ * @return          Final checksum value (the one which is compared with checksum argument).
+*/
+uint32_t clip_utils_crc_final(clip_arg_check_t check, uint32_t crc);
+
+/**
+ * @brief           Function used to compute checksum of the whole buffer.
+ * @param[in]       check
+ *                  Type of integrity check.
+ * @param[in]       data
+ *                  Pointer to data.
+ * @param[in]       size
+ *                  Number of bytes.
+ * @return          Final checksum value.
+*/
+uint32_t clip_utils_crc_calc(clip_arg_check_t check, const uint8_t *data, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
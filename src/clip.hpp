@@ -0,0 +1,677 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef CLIP_HPP
+#define CLIP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "clip.h"
+
+/*
+ * Header-only C++17 builder of commands tree (alternative to C macros from clip_defs.h, which use
+ * compound literals, not valid in ISO C++). Tree is defined as constexpr value, validated at compile time
+ * and converted to static constexpr "clip_command" descriptors (the same layout as built by macros).
+ * Every subcommands list is sorted by names at compile time, so commands are looked up with binary search.
+ *
+ *     static constexpr auto g_tree_def = clip_cpp::root(
+ *         clip_cpp::command("gpio", "gpio commands", nullptr,
+ *             clip_cpp::command("set", "set pin state", gpio_set_callback,
+ *                 clip_cpp::arg("pin", "pin number", CLIP_ARG_TYPE_UINT),
+ *                 clip_cpp::opt_arg("state", "pin state", CLIP_ARG_TYPE_BOOL))));
+ *
+ *     using g_tree = clip_cpp::tree<g_tree_def>;
+ *     const struct clip g_clip = g_tree::root(nullptr, event_callback);
+ *
+ * Commands may be also bound to typed functions, then arguments descriptors are deduced from function signature
+ * and values are unpacked into function parameters (std::optional for optional arguments, clip_cpp::bytes for binary data):
+ *
+ *     static void gpio_set(uint32_t pin, std::optional<bool> state);
+ *
+ *     clip_cpp::command<&gpio_set>("set", "set pin state", clip_cpp::param("pin", "pin number"), clip_cpp::param("state", "pin state"))
+ */
+namespace clip_cpp {
+
+///< structure contains argument definition (converted to "clip_arg" descriptor)
+struct arg_def {
+    const char *name;                       ///< argument name
+    const char *description;                ///< argument description
+    clip_arg_type_t type;                   ///< argument value type
+    bool optional;                          ///< optional argument flag
+    const struct clip_arg_stream *stream;   ///< streamed data callbacks (only for CLIP_ARG_TYPE_HEXSTREAM)
+    clip_arg_check_t check;                 ///< integrity check of binary data
+};
+
+///< structure contains parameter definition of typed command (argument type is deduced from function parameter)
+struct param_def {
+    const char *name;                       ///< argument name
+    const char *description;                ///< argument description
+    clip_arg_check_t check;                 ///< integrity check of binary data (only for clip_cpp::bytes parameter)
+};
+
+///< structure contains view of binary argument data (HEXARRAY, decoded in place, valid only during callback)
+struct bytes {
+    const uint8_t *data;                    ///< pointer to data
+    std::size_t size;                       ///< data size
+
+    constexpr const uint8_t* begin() const { return data; }
+    constexpr const uint8_t* end() const { return data + size; }
+};
+
+///< structure contains dispatch details, which may be taken by typed command function as its first parameter
+struct call {
+    const struct clip *self;                ///< root clip handler
+    const struct clip_command *cmd;         ///< called command
+    struct clip_out *out;                   ///< response writer (may be NULL)
+    void *context;                          ///< context passed to dispatch
+};
+
+///< structure contains command definition (converted to "clip_command" descriptor, subcommands are kept in tuple)
+template <std::size_t ArgsNum, typename Commands>
+struct command_def {
+    using commands_type = Commands;
+    static constexpr std::size_t args_num = ArgsNum;
+
+    const char *name;                       ///< command name
+    const char *description;                ///< command description
+    clip_command_callback_t callback;       ///< command call callback function pointer (may be nullptr)
+    std::array<arg_def, ArgsNum> args;      ///< arguments definitions
+    Commands commands;                      ///< subcommands definitions (tuple)
+};
+
+///< structure contains root commands definition
+template <typename Commands>
+struct root_def {
+    using commands_type = Commands;
+
+    Commands commands;                      ///< root commands definitions (tuple)
+};
+
+namespace detail {
+
+template <typename T>
+struct is_command : std::false_type {};
+
+template <std::size_t ArgsNum, typename Commands>
+struct is_command<command_def<ArgsNum, Commands>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_arg = std::is_same_v<T, arg_def>;
+
+template <typename T>
+constexpr bool is_param = std::is_same_v<T, param_def>;
+
+template <typename T, typename = void>
+struct arg_traits;
+
+template <>
+struct arg_traits<bool> {
+    static constexpr clip_arg_type_t type = CLIP_ARG_TYPE_BOOL;
+    static bool get(const struct clip_arg_value &value) { return value.val_bool; }
+};
+
+template <typename T>
+struct arg_traits<T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) <= sizeof(int32_t)>> {
+    static constexpr clip_arg_type_t type = CLIP_ARG_TYPE_INT;
+    static T get(const struct clip_arg_value &value) { return static_cast<T>(value.val_int); }
+};
+
+template <typename T>
+struct arg_traits<T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= sizeof(uint32_t)>> {
+    static constexpr clip_arg_type_t type = CLIP_ARG_TYPE_UINT;
+    static T get(const struct clip_arg_value &value) { return static_cast<T>(value.val_uint); }
+};
+
+template <>
+struct arg_traits<float> {
+    static constexpr clip_arg_type_t type = CLIP_ARG_TYPE_FLOAT;
+    static float get(const struct clip_arg_value &value) { return value.val_float; }
+};
+
+template <>
+struct arg_traits<const char*> {
+    static constexpr clip_arg_type_t type = CLIP_ARG_TYPE_STRING;
+    static const char* get(const struct clip_arg_value &value) { return value.val_str; }
+};
+
+template <>
+struct arg_traits<std::string_view> {
+    static constexpr clip_arg_type_t type = CLIP_ARG_TYPE_STRING;
+    static std::string_view get(const struct clip_arg_value &value) { return value.val_str; }
+};
+
+template <>
+struct arg_traits<bytes> {
+    static constexpr clip_arg_type_t type = CLIP_ARG_TYPE_HEXARRAY;
+    static bytes get(const struct clip_arg_value &value)
+    {
+        uint8_t *data = nullptr;
+        std::size_t size = clip_utils_arg_unpack_hexarray(&data, value.val_hexarray);
+        return bytes{data, size};
+    }
+};
+
+template <typename T>
+struct param_traits {
+    using value_type = std::decay_t<T>;
+    static constexpr bool optional = false;
+    static constexpr clip_arg_type_t type = arg_traits<value_type>::type;
+    static value_type get(std::size_t argc, struct clip_arg_value argv[], std::size_t i)
+    {
+        // required arguments count is already checked by dispatcher
+        (void)argc;
+        return arg_traits<value_type>::get(argv[i]);
+    }
+};
+
+template <typename T>
+struct param_traits<std::optional<T>> {
+    static constexpr bool optional = true;
+    static constexpr clip_arg_type_t type = arg_traits<T>::type;
+    static std::optional<T> get(std::size_t argc, struct clip_arg_value argv[], std::size_t i)
+    {
+        return (i < argc) ? std::optional<T>(arg_traits<T>::get(argv[i])) : std::nullopt;
+    }
+};
+
+template <typename T>
+struct param_traits<const std::optional<T>&> : param_traits<std::optional<T>> {};
+
+template <typename... Params>
+struct leading_params {
+    static constexpr bool out = false;
+    static constexpr std::size_t num = 0;
+};
+
+template <typename First, typename... Params>
+struct leading_params<First, Params...> {
+    static constexpr bool out = std::is_same_v<First, struct clip_out*>;
+    static constexpr std::size_t num = (out || std::is_same_v<First, const call&>) ? 1 : 0;
+};
+
+template <typename F>
+struct signature;
+
+template <typename R, typename... Params>
+struct signature<R (*)(Params...)> {
+    using result_type = R;
+    using params_type = std::tuple<Params...>;
+    static constexpr bool out = leading_params<Params...>::out;
+    static constexpr std::size_t skip = leading_params<Params...>::num;
+    static constexpr std::size_t values_num = sizeof...(Params) - skip;
+
+    template <std::size_t I>
+    using value_param = param_traits<std::tuple_element_t<I + skip, params_type>>;
+};
+
+template <typename R, typename... Params>
+struct signature<R (*)(Params...) noexcept> : signature<R (*)(Params...)> {};
+
+template <auto Func, std::size_t... I>
+int invoke_typed(const call &info, std::size_t argc, struct clip_arg_value argv[], std::index_sequence<I...>)
+{
+    using sig = signature<decltype(Func)>;
+
+    (void)argc;
+    (void)argv;
+    auto invoke = [&]() {
+        if constexpr (sig::skip == 0) {
+            return Func(sig::template value_param<I>::get(argc, argv, I)...);
+        } else if constexpr (sig::out) {
+            return Func(info.out, sig::template value_param<I>::get(argc, argv, I)...);
+        } else {
+            return Func(info, sig::template value_param<I>::get(argc, argv, I)...);
+        }
+    };
+
+    if constexpr (std::is_void_v<typename sig::result_type>) {
+        invoke();
+        return 0;
+    } else {
+        return invoke();
+    }
+}
+
+template <auto Func>
+int invoke(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    using sig = signature<decltype(Func)>;
+
+    return invoke_typed<Func>(call{self, cmd, out, context}, argc, argv, std::make_index_sequence<sig::values_num>{});
+}
+
+template <typename Sig, std::size_t N, std::size_t... I>
+constexpr std::array<arg_def, N> typed_args_of(const std::array<param_def, N> &params, std::index_sequence<I...>)
+{
+    return {{arg_def{params[I].name, params[I].description, Sig::template value_param<I>::type, Sig::template value_param<I>::optional, nullptr, params[I].check}...}};
+}
+
+constexpr int compare(const char *a, const char *b)
+{
+    // the same order as strcmp (chars compared as unsigned)
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return static_cast<int>(static_cast<unsigned char>(*a)) - static_cast<int>(static_cast<unsigned char>(*b));
+}
+
+constexpr std::tuple<> commands_of(const arg_def &)
+{
+    return {};
+}
+
+constexpr std::tuple<> commands_of(const param_def &)
+{
+    return {};
+}
+
+template <std::size_t ArgsNum, typename Commands>
+constexpr std::tuple<command_def<ArgsNum, Commands>> commands_of(const command_def<ArgsNum, Commands> &cmd)
+{
+    return std::tuple<command_def<ArgsNum, Commands>>(cmd);
+}
+
+template <typename T, std::size_t N, typename... Items>
+constexpr std::array<T, N> items_of(const Items &... items)
+{
+    std::array<T, N> args{};
+    std::size_t i = 0;
+    auto put = [&args, &i](const auto &item) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(item)>, T>)
+            args[i++] = item;
+    };
+    (put(items), ...);
+    (void)put;
+    return args;
+}
+
+template <typename Commands, std::size_t... I>
+constexpr std::array<const char*, sizeof...(I)> names_of(const Commands &commands, std::index_sequence<I...>)
+{
+    return {{std::get<I>(commands).name...}};
+}
+
+template <typename Commands>
+constexpr auto names_of(const Commands &commands)
+{
+    return names_of(commands, std::make_index_sequence<std::tuple_size_v<Commands>>{});
+}
+
+template <std::size_t N>
+constexpr std::array<std::size_t, N> sorted_order(const std::array<const char*, N> &names)
+{
+    std::array<std::size_t, N> order{};
+    for (std::size_t i = 0; i < N; i++) {
+        std::size_t j = i;
+        for (; j > 0 && compare(names[i], names[order[j - 1]]) < 0; j--)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    return order;
+}
+
+template <typename Commands>
+constexpr bool names_valid(const Commands &commands)
+{
+    auto names = names_of(commands);
+    for (std::size_t i = 0; i < names.size(); i++) {
+        if (names[i] == nullptr || *names[i] == '\0' || compare(names[i], CLIP_CONFIG_HELP_COMMAND) == 0)
+            return false;
+        for (std::size_t j = i + 1; j < names.size(); j++) {
+            if (compare(names[i], names[j]) == 0)
+                return false;
+        }
+    }
+    return std::apply([](const auto &... cmd) { return (true && ... && names_valid(cmd.commands)); }, commands);
+}
+
+template <std::size_t N>
+constexpr bool args_ordered(const std::array<arg_def, N> &args)
+{
+    bool optional = false;
+    for (std::size_t i = 0; i < N; i++) {
+        if (optional && !args[i].optional)
+            return false;
+        optional = optional || args[i].optional;
+    }
+    return true;
+}
+
+template <typename Commands>
+constexpr bool tree_args_ordered(const Commands &commands)
+{
+    return std::apply([](const auto &... cmd) { return (true && ... && (args_ordered(cmd.args) && tree_args_ordered(cmd.commands))); }, commands);
+}
+
+template <std::size_t N>
+constexpr bool args_checked(const std::array<arg_def, N> &args)
+{
+    for (std::size_t i = 0; i < N; i++) {
+        if (args[i].check == CLIP_ARG_CHECK_NONE)
+            continue;
+        if (i + 1 >= N || args[i + 1].type != CLIP_ARG_TYPE_UINT || args[i + 1].optional)
+            return false;
+    }
+    return true;
+}
+
+template <typename Commands>
+constexpr bool tree_args_checked(const Commands &commands)
+{
+    return std::apply([](const auto &... cmd) { return (true && ... && (args_checked(cmd.args) && tree_args_checked(cmd.commands))); }, commands);
+}
+
+template <typename Commands>
+constexpr std::size_t max_args(const Commands &commands)
+{
+    std::size_t result = 0;
+    std::apply([&result](const auto &... cmd) { ((result = std::max({result, cmd.args_num, max_args(cmd.commands)})), ...); }, commands);
+    return result;
+}
+
+template <typename T>
+constexpr const T& at(const T &def)
+{
+    return def;
+}
+
+template <std::size_t I, std::size_t... Path, typename T>
+constexpr const auto& at(const T &def)
+{
+    return at<Path...>(std::get<I>(def.commands));
+}
+
+template <const auto &Root, std::size_t... Path>
+constexpr const auto& node(std::index_sequence<Path...>)
+{
+    return at<Path...>(Root);
+}
+
+template <const auto &Root, typename Path>
+using node_type = std::decay_t<decltype(node<Root>(Path{}))>;
+
+template <const auto &Root, typename Path>
+constexpr std::size_t commands_num = std::tuple_size_v<typename node_type<Root, Path>::commands_type>;
+
+constexpr struct clip_arg make_arg(const arg_def &def)
+{
+    struct clip_arg arg{};
+    arg.name = def.name;
+    arg.description = def.description;
+    arg.type = def.type;
+    arg.optional = def.optional;
+    arg.stream = def.stream;
+    arg.check = def.check;
+    return arg;
+}
+
+template <std::size_t N, std::size_t... I>
+constexpr std::array<struct clip_arg, N> make_args(const std::array<arg_def, N> &defs, std::index_sequence<I...>)
+{
+    return {{make_arg(defs[I])...}};
+}
+
+template <std::size_t N, std::size_t... I>
+constexpr std::array<const struct clip_arg*, N + 1> make_arg_list(const std::array<struct clip_arg, N> &args, std::index_sequence<I...>)
+{
+    return {{&args[I]..., nullptr}};
+}
+
+template <const auto &Root, typename Path>
+inline constexpr auto order_v = sorted_order(names_of(node<Root>(Path{}).commands));
+
+template <const auto &Root, typename Path>
+inline constexpr auto args_v = make_args(node<Root>(Path{}).args, std::make_index_sequence<node_type<Root, Path>::args_num>{});
+
+template <const auto &Root, typename Path>
+inline constexpr auto arg_list_v = make_arg_list(args_v<Root, Path>, std::make_index_sequence<node_type<Root, Path>::args_num>{});
+
+template <const auto &Root, typename Path>
+constexpr struct clip_command make_command();
+
+template <const auto &Root, typename Path>
+inline constexpr struct clip_command command_v = make_command<Root, Path>();
+
+template <const auto &Root, std::size_t... Path, std::size_t... I>
+constexpr std::array<const struct clip_command*, sizeof...(I) + 1> make_command_list(std::index_sequence<Path...>, std::index_sequence<I...>)
+{
+    using path = std::index_sequence<Path...>;
+    return {{&command_v<Root, std::index_sequence<Path..., order_v<Root, path>[I]>>..., nullptr}};
+}
+
+template <const auto &Root, typename Path>
+inline constexpr auto command_list_v = make_command_list<Root>(Path{}, std::make_index_sequence<commands_num<Root, Path>>{});
+
+template <const auto &Root, typename Path>
+constexpr struct clip_command make_command()
+{
+    const auto &def = node<Root>(Path{});
+    struct clip_command cmd{};
+
+    cmd.name = def.name;
+    cmd.description = def.description;
+    cmd.callback = def.callback;
+    if constexpr (commands_num<Root, Path> > 0) {
+        cmd.commands = const_cast<const struct clip_command**>(command_list_v<Root, Path>.data());
+        cmd.commands_num = commands_num<Root, Path>;
+    }
+    if constexpr (node_type<Root, Path>::args_num > 0)
+        cmd.args = const_cast<const struct clip_arg**>(arg_list_v<Root, Path>.data());
+    return cmd;
+}
+
+} // namespace detail
+
+/**
+ * @brief           Function used to define required argument.
+ * @param[in]       name
+ *                  Argument name.
+ * @param[in]       description
+ *                  Argument description.
+ * @param[in]       type
+ *                  Argument value type.
+ * @return          Argument definition.
+*/
+constexpr arg_def arg(const char *name, const char *description, clip_arg_type_t type)
+{
+    return arg_def{name, description, type, false, nullptr, CLIP_ARG_CHECK_NONE};
+}
+
+/**
+ * @brief           Function used to define optional argument (only optional arguments may follow it).
+ * @param[in]       name
+ *                  Argument name.
+ * @param[in]       description
+ *                  Argument description.
+ * @param[in]       type
+ *                  Argument value type.
+ * @return          Argument definition.
+*/
+constexpr arg_def opt_arg(const char *name, const char *description, clip_arg_type_t type)
+{
+    return arg_def{name, description, type, true, nullptr, CLIP_ARG_CHECK_NONE};
+}
+
+/**
+ * @brief           Function used to define binary argument with integrity check (checksum must be the next UINT argument).
+ * @param[in]       name
+ *                  Argument name.
+ * @param[in]       description
+ *                  Argument description.
+ * @param[in]       type
+ *                  Argument value type (CLIP_ARG_TYPE_HEXARRAY).
+ * @param[in]       check
+ *                  Integrity check type.
+ * @return          Argument definition.
+*/
+constexpr arg_def checked_arg(const char *name, const char *description, clip_arg_type_t type, clip_arg_check_t check)
+{
+    return arg_def{name, description, type, false, nullptr, check};
+}
+
+/**
+ * @brief           Function used to define streamed argument (must be the last one, or followed only by its checksum).
+ * @param[in]       name
+ *                  Argument name.
+ * @param[in]       description
+ *                  Argument description.
+ * @param[in]       stream
+ *                  Pointer to streamed data callbacks.
+ * @param[in]       check
+ *                  Optional integrity check type.
+ * @return          Argument definition.
+*/
+constexpr arg_def stream_arg(const char *name, const char *description, const struct clip_arg_stream *stream, clip_arg_check_t check = CLIP_ARG_CHECK_NONE)
+{
+    return arg_def{name, description, CLIP_ARG_TYPE_HEXSTREAM, false, stream, check};
+}
+
+/**
+ * @brief           Function used to define command.
+ * @param[in]       name
+ *                  Command name.
+ * @param[in]       description
+ *                  Command description.
+ * @param[in]       callback
+ *                  Command call callback function pointer (may be nullptr).
+ * @param[in]       items
+ *                  Arguments (in order) and subcommands definitions.
+ * @return          Command definition.
+*/
+template <typename... Items>
+constexpr auto command(const char *name, const char *description, clip_command_callback_t callback, Items... items)
+{
+    static_assert(((detail::is_arg<Items> || detail::is_command<Items>::value) && ...), "clip: command items must be arguments or subcommands");
+
+    constexpr std::size_t args_num = (std::size_t{0} + ... + (detail::is_arg<Items> ? 1 : 0));
+    auto commands = std::tuple_cat(detail::commands_of(items)...);
+    return command_def<args_num, decltype(commands)>{name, description, callback, detail::items_of<arg_def, args_num>(items...), commands};
+}
+
+/**
+ * @brief           Function used to define parameter of typed command (in order of function parameters).
+ * @param[in]       name
+ *                  Argument name.
+ * @param[in]       description
+ *                  Argument description.
+ * @param[in]       check
+ *                  Optional integrity check (only for clip_cpp::bytes, checksum must be the next uint32_t parameter).
+ * @return          Parameter definition.
+*/
+constexpr param_def param(const char *name, const char *description = nullptr, clip_arg_check_t check = CLIP_ARG_CHECK_NONE)
+{
+    return param_def{name, description, check};
+}
+
+/**
+ * @brief           Function used to define command bound to typed function.
+ *                  Arguments descriptors are deduced from function parameters (bool, signed and unsigned integers
+ *                  up to 32 bits, float, const char*, std::string_view, clip_cpp::bytes, and std::optional of them
+ *                  for optional arguments). Function may take "struct clip_out*" or "const clip_cpp::call&" as the first
+ *                  parameter, and may return void (success) or int (callback code).
+ * @param[in]       name
+ *                  Command name.
+ * @param[in]       description
+ *                  Command description.
+ * @param[in]       items
+ *                  Parameters names (one per function argument, in order) and subcommands definitions.
+ * @return          Command definition.
+*/
+template <auto Func, typename... Items>
+constexpr auto command(const char *name, const char *description, Items... items)
+{
+    using sig = detail::signature<decltype(Func)>;
+
+    static_assert(((detail::is_param<Items> || detail::is_command<Items>::value) && ...), "clip: typed command items must be parameters or subcommands");
+    static_assert(std::is_void_v<typename sig::result_type> || std::is_same_v<typename sig::result_type, int>, "clip: typed command function must return void or int");
+
+    constexpr std::size_t params_num = (std::size_t{0} + ... + (detail::is_param<Items> ? 1 : 0));
+    static_assert(params_num == sig::values_num, "clip: every function argument needs its parameter definition");
+
+    auto commands = std::tuple_cat(detail::commands_of(items)...);
+    auto args = detail::typed_args_of<sig>(detail::items_of<param_def, params_num>(items...), std::make_index_sequence<params_num>{});
+    return command_def<params_num, decltype(commands)>{name, description, detail::invoke<Func>, args, commands};
+}
+
+/**
+ * @brief           Function used to define root commands list.
+ * @param[in]       commands
+ *                  Root commands definitions.
+ * @return          Root commands definition.
+*/
+template <typename... Commands>
+constexpr auto root(Commands... commands)
+{
+    static_assert((detail::is_command<Commands>::value && ...), "clip: root items must be commands");
+
+    return root_def<std::tuple<Commands...>>{std::tuple<Commands...>(commands...)};
+}
+
+///< structure contains commands tree built from constexpr definition (all descriptors are static constexpr)
+template <const auto &Def>
+struct tree {
+    static_assert(detail::names_valid(Def.commands), "clip: command names must be non-empty, unique within subcommands list and different from help command");
+    static_assert(detail::tree_args_ordered(Def.commands), "clip: required argument can't follow optional argument");
+    static_assert(detail::tree_args_checked(Def.commands), "clip: checked binary argument must be followed by required UINT checksum argument");
+    static_assert(detail::max_args(Def.commands) <= CLIP_CONFIG_ARGS_MAX_NUM, "clip: command has more arguments than CLIP_CONFIG_ARGS_MAX_NUM");
+
+    ///< the biggest number of arguments of single command
+    static constexpr std::size_t max_argc = detail::max_args(Def.commands);
+
+    ///< number of root commands
+    static constexpr std::size_t commands_num = detail::commands_num<Def, std::index_sequence<>>;
+
+    ///< root commands list sorted by names (last item is NULL)
+    static constexpr const struct clip_command **commands = const_cast<const struct clip_command**>(detail::command_list_v<Def, std::index_sequence<>>.data());
+
+    /**
+     * @brief           Function used to make root clip handler of the tree.
+     * @param[in]       context
+     *                  Generic pointer used as global context.
+     * @param[in]       event_callback
+     *                  Pointer to event callback function (may be nullptr).
+     * @return          Root clip handler (other fields, e.g. profile, may be set on the returned value).
+    */
+    static constexpr struct clip root(void *context = nullptr, clip_event_callback_t event_callback = nullptr)
+    {
+        struct clip self{};
+        self.context = context;
+        self.event_callback = event_callback;
+        self.commands = commands;
+        self.commands_num = commands_num;
+        return self;
+    }
+};
+
+} // namespace clip_cpp
+
+#endif /* CLIP_HPP */
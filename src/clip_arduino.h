@@ -0,0 +1,62 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef CLIP_ARDUINO_H
+#define CLIP_ARDUINO_H
+
+#include <Arduino.h>
+
+#include "clip.h"
+
+/**
+ * @brief           Function used to drain all bytes available in Arduino stream (e.g. Serial) into line reader,
+ *                  and dispatch every complete line (see "clip_reader_feed"). It never waits for data.
+ * @param[in/out]   self
+ *                  Pointer to line reader.
+ * @param[in/out]   stream
+ *                  Arduino stream with received data.
+ * @param[in]       clip
+ *                  Pointer to main clip root handler.
+ * @param[in/out]   out
+ *                  Response writer passed to commands (may be NULL).
+ * @param[in]       context
+ *                  Generic pointer which will be passed to events and command callbacks.
+ * @return          Number of dispatched lines.
+*/
+static inline size_t clip_reader_poll_stream(struct clip_reader *self, Stream &stream, const struct clip *clip, struct clip_out *out, void *context)
+{
+    char chunk[16];
+    size_t count = 0;
+    int available;
+
+    while ((available = stream.available()) > 0) {
+        size_t len = ((size_t)available < sizeof(chunk)) ? (size_t)available : sizeof(chunk);
+        len = stream.readBytes(chunk, len);
+        count += clip_reader_feed(self, clip, chunk, len, out, context);
+    }
+
+    return count;
+}
+
+#endif /* CLIP_ARDUINO_H */
@@ -0,0 +1,93 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+static char* clip_batch_split_line(char *line, char *end, char **next)
+{
+    char *eol = memchr(line, '\n', end - line);
+
+    *next = (eol != NULL) ? eol + 1 : end;
+    if (eol == NULL)
+        eol = end;
+    if (eol > line && eol[-1] == '\r')
+        eol--;
+    *eol = '\0';
+
+    while (*line == ' ' || *line == '\t')
+        line++;
+    return line;
+}
+
+bool clip_batch_run(const struct clip *self, char *script, size_t size, struct clip_out *out, void *context, clip_pipeline_policy_t policy, clip_batch_report_t report, struct clip_batch_result *result)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(script != NULL);
+
+    struct clip_batch_result local_result;
+    if (result == NULL)
+        result = &local_result;
+
+    memset(result, 0, sizeof(*result));
+
+    char *end = script + size;
+    char *line = script;
+    char *next = NULL;
+    size_t line_no = 0;
+
+    for (; line < end; line = next) {
+        char *cmd_line = clip_batch_split_line(line, end, &next);
+        line_no++;
+
+        if (*cmd_line == '\0' || *cmd_line == '#')
+            continue;
+
+        struct clip_result line_result;
+        clip_status_t status;
+        if (CLIP_CONFIG_PIPELINE_ENABLED) {
+            status = clip_cmd_parse_pipeline(self, cmd_line, out, context, policy, &line_result);
+        } else {
+            status = clip_cmd_parse_line_ex(self, NULL, cmd_line, out, context, &line_result);
+        }
+        result->lines++;
+
+        if (report != NULL)
+            report(self, line_no, &line_result, context);
+
+        if (clip_cmd_is_error(status)) {
+            result->errors++;
+            if (result->error_line == 0)
+                result->error_line = line_no;
+            if (policy == CLIP_PIPELINE_STOP_ON_ERROR) {
+                line = next;
+                break;
+            }
+        }
+    }
+
+    result->size = line - script;
+    return result->errors == 0;
+}
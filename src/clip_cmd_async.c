@@ -0,0 +1,70 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+int clip_cmd_pend(struct clip_pending *token, const struct clip *self, const struct clip_command *cmd, struct clip_out *out, void *context)
+{
+    CLIP_CONFIG_ASSERT(token != NULL);
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(cmd != NULL);
+    CLIP_CONFIG_ASSERT(token->clip == NULL);
+
+    token->clip = self;
+    token->cmd = cmd;
+    token->out = out;
+    token->context = context;
+
+    return CLIP_COMMAND_PENDING;
+}
+
+bool clip_cmd_is_pending(const struct clip_pending *token)
+{
+    CLIP_CONFIG_ASSERT(token != NULL);
+
+    return token->clip != NULL;
+}
+
+void clip_cmd_complete(struct clip_pending *token, int code)
+{
+    CLIP_CONFIG_ASSERT(token != NULL);
+    CLIP_CONFIG_ASSERT(token->clip != NULL);
+
+    const struct clip *self = token->clip;
+    const struct clip_command *cmd = token->cmd;
+    struct clip_out *out = token->out;
+    void *context = token->context;
+
+    // token is released before notification, so it may be reused from completion event
+    token->clip = NULL;
+
+    if (CLIP_TRACE_IS_ENABLED(self))
+        clip_trace_write(self->trace, CLIP_TRACE_EVENT_COMPLETE, cmd, code);
+
+    if (out != NULL)
+        clip_out_flush(out);
+
+    if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_COMMAND_COMPLETE))
+        clip_notify_event_command_complete(self, context, cmd, code);
+}
@@ -26,33 +26,53 @@ SOFTWARE.
 
 #include <string.h>
 
-void clip_cmd_call_command_callback(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context)
+clip_arg_error_t clip_cmd_call_check_arg(const struct clip_arg *ca, const struct clip_arg_value *av, clip_arg_check_t *check, uint32_t crc)
+{
+    CLIP_CONFIG_ASSERT(av != NULL);
+    CLIP_CONFIG_ASSERT(check != NULL);
+
+    clip_arg_error_t error = CLIP_ARG_ERROR_NO_ERROR;
+    if (*check != CLIP_ARG_CHECK_NONE) {
+        // checksum argument must directly follow checked binary argument (data can't be verified otherwise)
+        if (ca == NULL || ca->type != CLIP_ARG_TYPE_UINT || av->val_uint != crc)
+            error = CLIP_ARG_ERROR_CHECKSUM;
+    }
+
+    *check = (ca != NULL && (ca->type == CLIP_ARG_TYPE_HEXARRAY || ca->type == CLIP_ARG_TYPE_HEXSTREAM)) ? ca->check : CLIP_ARG_CHECK_NONE;
+    return error;
+}
+
+clip_arg_error_t clip_cmd_call_parse_args(const struct clip_command *cmd, char *cmd_line, size_t *argc, struct clip_arg_value argv[])
 {
-    CLIP_CONFIG_ASSERT(self != NULL);
     CLIP_CONFIG_ASSERT(cmd != NULL);
     CLIP_CONFIG_ASSERT(cmd_line != NULL);
+    CLIP_CONFIG_ASSERT(argc != NULL);
+    CLIP_CONFIG_ASSERT(argv != NULL);
 
-    size_t argc = 0;
     char *arg = cmd_line;
-    struct clip_arg_value argv[CLIP_CONFIG_ARGS_MAX_NUM] = {0};
     struct clip_arg_value *av = NULL;
 
-    clip_notify_event_call_command_callback(self, context, cmd, cmd_line);
-
     clip_arg_error_t error = CLIP_ARG_ERROR_NO_ERROR;
     bool no_more_required_args = false;
-    while (argc < (sizeof(argv) / sizeof(argv[0]))) {
+    clip_arg_check_t check = CLIP_ARG_CHECK_NONE;
+    uint32_t crc = 0;
+    *argc = 0;
+    while (*argc < CLIP_CONFIG_ARGS_MAX_NUM) {
         cmd_line = clip_utils_arg_get_first(&arg, cmd_line);
-        if (*arg == '\0')
+
+        av = &argv[*argc];
+        if (*arg == '\0') {
+            av->type = CLIP_ARG_TYPE_STRING;
+            av->val_str = arg;
             break;
+        }
 
-        av = &argv[argc];
         av->type = CLIP_ARG_TYPE_STRING;
         av->val_str = arg;
 
         const struct clip_arg *ca = NULL;
         if (no_more_required_args == false && cmd->args != NULL) {
-            ca = cmd->args[argc];
+            ca = cmd->args[*argc];
             if (ca != NULL) {
                 switch (ca->type) {
                 case CLIP_ARG_TYPE_BOOL:
@@ -76,7 +96,9 @@ void clip_cmd_call_command_callback(const struct clip *self, const struct clip_c
                     break;
 
                 case CLIP_ARG_TYPE_HEXARRAY:
-                    if (clip_utils_parse_hexarray(av, arg) == false)
+                case CLIP_ARG_TYPE_HEXSTREAM:
+                    CLIP_CONFIG_ASSERT(clip_utils_arg_has_checksum(cmd->args, *argc));
+                    if (clip_utils_parse_hexarray_crc(av, arg, ca->check, &crc) == false)
                         error = CLIP_ARG_ERROR_PARSE_HEXARRAY;
                     break;
 
@@ -91,12 +113,45 @@ void clip_cmd_call_command_callback(const struct clip *self, const struct clip_c
             }
         }
 
-        if (error != CLIP_ARG_ERROR_NO_ERROR)
+        if (error == CLIP_ARG_ERROR_NO_ERROR)
+            error = clip_cmd_call_check_arg(ca, av, &check, crc);
+
+        if (error != CLIP_ARG_ERROR_NO_ERROR) {
+            av->type = CLIP_ARG_TYPE_STRING;
+            av->val_str = arg;
             break;
+        }
 
-        argc++;
+        (*argc)++;
     }
 
+    // checked binary argument without following checksum argument
+    if (error == CLIP_ARG_ERROR_NO_ERROR && check != CLIP_ARG_CHECK_NONE)
+        error = CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS;
+
+    return error;
+}
+
+static void clip_cmd_call_stream_callbacks(const struct clip *self, const struct clip_command *cmd, size_t index, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    const struct clip_arg_stream *stream = cmd->args[index]->stream;
+    uint8_t *data = NULL;
+    size_t size = clip_utils_arg_unpack_hexarray(&data, argv[index].val_hexarray);
+
+    if (stream == NULL)
+        return;
+
+    if (stream->begin != NULL)
+        stream->begin(self, cmd, index, argv, out, context);
+    if (stream->data != NULL && size > 0)
+        stream->data(self, cmd, data, size, out, context);
+    if (stream->end != NULL)
+        stream->end(self, cmd, size, CLIP_ARG_ERROR_NO_ERROR, out, context);
+}
+
+static clip_arg_error_t clip_cmd_call_check(const struct clip *self, const struct clip_command *cmd, clip_arg_error_t error, void *context, struct clip_result *result, size_t *argc, struct clip_arg_value argv[], size_t *stream_index, uint32_t *stamp)
+{
+    *stream_index = *argc;
     if (error == CLIP_ARG_ERROR_NO_ERROR) {
         size_t required_args_count = 0;
         const struct clip_arg* *args = cmd->args;
@@ -104,18 +159,148 @@ void clip_cmd_call_command_callback(const struct clip *self, const struct clip_c
             while (*args != NULL) {
                 if (!(*args)->optional)
                     required_args_count++;
+                if ((*args)->type == CLIP_ARG_TYPE_HEXSTREAM && *stream_index == *argc)
+                    *stream_index = args - cmd->args;
                 args++;
             }
         }
-        if (required_args_count > argc) {
+        if (required_args_count > *argc) {
             error = CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS;
         }
     }
 
+    if (CLIP_PROFILE_IS_ENABLED(self))
+        *stamp = clip_profile_lap(self->profile, cmd, CLIP_PROFILE_STAGE_ARGS, *stamp);
+    if (CLIP_TRACE_IS_ENABLED(self))
+        clip_trace_write(self->trace, CLIP_TRACE_EVENT_ARGS, cmd, error);
+
+    result->cmd = cmd;
+    result->error = error;
+    result->token = (*argc < CLIP_CONFIG_ARGS_MAX_NUM) ? argv[*argc].val_str : NULL;
+
     if (error != CLIP_ARG_ERROR_NO_ERROR) {
-        clip_notify_event_arguments_error(self, context, cmd, error);
-    } else {
-        if (cmd->callback != NULL)
-            cmd->callback(self, cmd, argc, argv, context);
+        result->status = CLIP_STATUS_ARGUMENTS_ERROR;
+        if (CLIP_STATS_IS_ENABLED(self))
+            clip_stats_inc(self->stats, cmd, CLIP_STATS_COUNTER_ARGUMENTS_ERRORS);
+        if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_ARGUMENTS_ERROR))
+            clip_notify_event_arguments_error(self, context, cmd, error);
+        return error;
+    }
+
+    result->status = CLIP_STATUS_OK;
+    result->token = NULL;
+    if (CLIP_STATS_IS_ENABLED(self))
+        clip_stats_inc(self->stats, cmd, CLIP_STATS_COUNTER_CALLS);
+    return error;
+}
+
+static clip_arg_error_t clip_cmd_call_prepare(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context, struct clip_result *result, size_t *argc, struct clip_arg_value argv[], size_t *stream_index, uint32_t *stamp)
+{
+    if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_CALL_COMMAND_CALLBACK))
+        clip_notify_event_call_command_callback(self, context, cmd, cmd_line);
+
+    if (CLIP_PROFILE_IS_ENABLED(self))
+        *stamp = clip_profile_now(self->profile);
+
+    clip_arg_error_t error = clip_cmd_call_parse_args(cmd, cmd_line, argc, argv);
+
+    return clip_cmd_call_check(self, cmd, error, context, result, argc, argv, stream_index, stamp);
+}
+
+static int clip_cmd_call_invoke(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], size_t stream_index, struct clip_out *out, void *context)
+{
+    if (stream_index < argc) {
+        clip_cmd_call_stream_callbacks(self, cmd, stream_index, argv, out, context);
+        return 0;
     }
+
+    return (cmd->callback != NULL) ? cmd->callback(self, cmd, argc, argv, out, context) : 0;
+}
+
+static void clip_cmd_call_run(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], size_t stream_index, uint32_t stamp, struct clip_out *out, void *context, struct clip_result *result)
+{
+    result->code = clip_cmd_call_invoke(self, cmd, argc, argv, stream_index, out, context);
+
+    if (CLIP_PROFILE_IS_ENABLED(self))
+        clip_profile_lap(self->profile, cmd, CLIP_PROFILE_STAGE_CALLBACK, stamp);
+    if (CLIP_TRACE_IS_ENABLED(self))
+        clip_trace_write(self->trace, CLIP_TRACE_EVENT_CALLBACK, cmd, result->code);
+
+    if (result->code == CLIP_COMMAND_PENDING) {
+        result->status = CLIP_STATUS_PENDING;
+    } else if (result->code != 0) {
+        result->status = CLIP_STATUS_COMMAND_ERROR;
+    }
+}
+
+void clip_cmd_call_command_callback(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(cmd != NULL);
+    CLIP_CONFIG_ASSERT(cmd_line != NULL);
+    CLIP_CONFIG_ASSERT(result != NULL);
+
+    size_t argc = 0;
+    struct clip_arg_value argv[CLIP_CONFIG_ARGS_MAX_NUM] = {0};
+    size_t stream_index = 0;
+    uint32_t stamp = 0;
+
+    if (clip_cmd_call_prepare(self, cmd, cmd_line, context, result, &argc, argv, &stream_index, &stamp) != CLIP_ARG_ERROR_NO_ERROR)
+        return;
+
+    clip_cmd_call_run(self, cmd, argc, argv, stream_index, stamp, out, context, result);
+}
+
+void clip_cmd_call_decoded_args(const struct clip *self, const struct clip_command *cmd, clip_arg_error_t error, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context, struct clip_result *result)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(cmd != NULL);
+    CLIP_CONFIG_ASSERT(argv != NULL);
+    CLIP_CONFIG_ASSERT(result != NULL);
+
+    size_t stream_index = 0;
+    uint32_t stamp = 0;
+
+    if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_CALL_COMMAND_CALLBACK))
+        clip_notify_event_call_command_callback(self, context, cmd, "");
+
+    if (CLIP_PROFILE_IS_ENABLED(self))
+        stamp = clip_profile_now(self->profile);
+
+    if (clip_cmd_call_check(self, cmd, error, context, result, &argc, argv, &stream_index, &stamp) != CLIP_ARG_ERROR_NO_ERROR)
+        return;
+
+    clip_cmd_call_run(self, cmd, argc, argv, stream_index, stamp, out, context, result);
+}
+
+void clip_cmd_call_bind_command(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context, struct clip_result *result, struct clip_bound_command *bound)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(cmd != NULL);
+    CLIP_CONFIG_ASSERT(cmd_line != NULL);
+    CLIP_CONFIG_ASSERT(result != NULL);
+    CLIP_CONFIG_ASSERT(bound != NULL);
+
+    uint32_t stamp = 0;
+
+    memset(bound->argv, 0, sizeof(bound->argv));
+    if (clip_cmd_call_prepare(self, cmd, cmd_line, context, result, &bound->argc, bound->argv, &bound->stream_index, &stamp) != CLIP_ARG_ERROR_NO_ERROR)
+        return;
+
+    result->status = CLIP_STATUS_BOUND;
+    bound->clip = self;
+    bound->cmd = cmd;
+    bound->context = context;
+}
+
+int clip_cmd_invoke(struct clip_bound_command *bound, struct clip_out *out)
+{
+    CLIP_CONFIG_ASSERT(bound != NULL);
+    CLIP_CONFIG_ASSERT(bound->cmd != NULL);
+
+    int code = clip_cmd_call_invoke(bound->clip, bound->cmd, bound->argc, bound->argv, bound->stream_index, out, bound->context);
+
+    if (out != NULL)
+        clip_out_flush(out);
+    return code;
 }
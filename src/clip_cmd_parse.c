@@ -26,33 +26,205 @@ SOFTWARE.
 
 #include <string.h>
 
-void clip_cmd_parse_line(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context)
+static const struct clip_command* clip_cmd_parse_find(const struct clip_command **commands, size_t commands_num, const char *cmd_name)
 {
-    CLIP_CONFIG_ASSERT(self != NULL);
-    CLIP_CONFIG_ASSERT(cmd_line != NULL);
+    size_t first = 0;
+    size_t last = commands_num;
+
+    if (commands_num == 0) {
+        while (*commands != NULL) {
+            if (strcmp(cmd_name, (*commands)->name) == 0)
+                return *commands;
+            commands++;
+        }
+        return NULL;
+    }
+
+    while (first < last) {
+        size_t mid = first + ((last - first) >> 1);
+        int cmp = strcmp(cmd_name, commands[mid]->name);
+        if (cmp == 0)
+            return commands[mid];
+        if (cmp < 0) {
+            last = mid;
+        } else {
+            first = mid + 1;
+        }
+    }
+    return NULL;
+}
 
+static void clip_cmd_parse_line_recursive(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result, struct clip_bound_command *bound)
+{
     if (cmd != NULL && (cmd->commands == NULL || *cmd->commands == NULL)) {
-        clip_cmd_call_command_callback(self, cmd, cmd_line, context);
+        if (bound != NULL) {
+            clip_cmd_call_bind_command(self, cmd, cmd_line, context, result, bound);
+        } else {
+            clip_cmd_call_command_callback(self, cmd, cmd_line, out, context, result);
+        }
         return;
     }
 
     const struct clip_command* *commands = (cmd != NULL) ? cmd->commands : self->commands;
 
+    uint32_t stamp = 0;
+    if (CLIP_PROFILE_IS_ENABLED(self))
+        stamp = clip_profile_now(self->profile);
+
     char *cmd_name;
     cmd_line = clip_utils_arg_get_first(&cmd_name, cmd_line);
 
+    if (CLIP_PROFILE_IS_ENABLED(self))
+        stamp = clip_profile_lap(self->profile, cmd, CLIP_PROFILE_STAGE_TOKENIZE, stamp);
+
+    result->cmd = cmd;
+    result->token = cmd_name;
+
     if (strcmp(cmd_name, CLIP_CONFIG_HELP_COMMAND) == 0) {
-        clip_notify_event_help(self, context, cmd, commands);
+        result->status = CLIP_STATUS_HELP;
+        if (CLIP_TRACE_IS_ENABLED(self))
+            clip_trace_write(self->trace, CLIP_TRACE_EVENT_HELP, cmd, 0);
+        if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_HELP))
+            clip_notify_event_help(self, context, cmd, commands);
         return;
     }
 
-    while (*commands != NULL) {
-        if (strcmp(cmd_name, (*commands)->name) == 0) {
-            clip_cmd_parse_line(self, *commands, cmd_line, context);
+    const struct clip_command *found = clip_cmd_parse_find(commands, (cmd != NULL) ? cmd->commands_num : self->commands_num, cmd_name);
+    if (found != NULL) {
+        if (CLIP_PROFILE_IS_ENABLED(self))
+            clip_profile_lap(self->profile, cmd, CLIP_PROFILE_STAGE_LOOKUP, stamp);
+        if (CLIP_TRACE_IS_ENABLED(self))
+            clip_trace_write(self->trace, CLIP_TRACE_EVENT_LOOKUP, found, 0);
+        clip_cmd_parse_line_recursive(self, found, cmd_line, out, context, result, bound);
+        return;
+    }
+
+    if (CLIP_PROFILE_IS_ENABLED(self))
+        clip_profile_lap(self->profile, cmd, CLIP_PROFILE_STAGE_LOOKUP, stamp);
+
+    if (CLIP_STATS_IS_ENABLED(self)) {
+        if (cmd == NULL && strcmp(cmd_name, CLIP_CONFIG_STATS_COMMAND) == 0) {
+            result->status = CLIP_STATUS_OK;
+            result->token = NULL;
+            clip_stats_dump(self->stats, out);
             return;
         }
-        commands++;
+        clip_stats_inc(self->stats, cmd, CLIP_STATS_COUNTER_NOT_FOUND);
+    }
+
+    result->status = CLIP_STATUS_COMMAND_NOT_FOUND;
+    if (CLIP_TRACE_IS_ENABLED(self))
+        clip_trace_write(self->trace, CLIP_TRACE_EVENT_NOT_FOUND, cmd, 0);
+    if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_COMMAND_NOT_FOUND))
+        clip_notify_event_command_not_found(self, context, cmd, cmd_name);
+}
+
+static clip_status_t clip_cmd_parse_line_bound(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result, struct clip_bound_command *bound)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(cmd_line != NULL);
+
+    struct clip_result local_result;
+    if (result == NULL)
+        result = &local_result;
+
+    result->status = CLIP_STATUS_OK;
+    result->cmd = cmd;
+    result->error = CLIP_ARG_ERROR_NO_ERROR;
+    result->code = 0;
+    result->token = NULL;
+    result->offset = 0;
+
+    if (CLIP_TRACE_IS_ENABLED(self))
+        clip_trace_write(self->trace, CLIP_TRACE_EVENT_LINE, cmd, 0);
+
+    clip_cmd_parse_line_recursive(self, cmd, cmd_line, out, context, result, bound);
+
+    if (CLIP_TRACE_IS_ENABLED(self))
+        clip_trace_write(self->trace, CLIP_TRACE_EVENT_DONE, result->cmd, result->status);
+
+    if (result->token != NULL)
+        result->offset = result->token - cmd_line;
+
+    return result->status;
+}
+
+clip_status_t clip_cmd_parse_line_ex(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result)
+{
+    clip_status_t status = clip_cmd_parse_line_bound(self, cmd, cmd_line, out, context, result, NULL);
+
+    if (out != NULL)
+        clip_out_flush(out);
+    return status;
+}
+
+clip_status_t clip_cmd_bind(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_bound_command *bound, struct clip_result *result)
+{
+    CLIP_CONFIG_ASSERT(bound != NULL);
+
+    clip_status_t status = clip_cmd_parse_line_bound(self, cmd, cmd_line, out, context, result, bound);
+
+    if (out != NULL)
+        clip_out_flush(out);
+    return status;
+}
+
+clip_status_t clip_cmd_parse_pipeline(const struct clip *self, char *cmd_line, struct clip_out *out, void *context, clip_pipeline_policy_t policy, struct clip_result *result)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(cmd_line != NULL);
+
+    struct clip_result local_result;
+    struct clip_result failed_result;
+    bool failed = false;
+    char *line = cmd_line;
+
+    if (result == NULL)
+        result = &local_result;
+
+    result->status = CLIP_STATUS_OK;
+    result->cmd = NULL;
+    result->error = CLIP_ARG_ERROR_NO_ERROR;
+    result->code = 0;
+    result->token = NULL;
+    result->offset = 0;
+
+    while (line != NULL) {
+        char *next = clip_utils_arg_split_command(line);
+
+        const char *ch = line;
+        while (*ch == ' ')
+            ch++;
+        if (*ch != '\0') {
+            clip_status_t status = clip_cmd_parse_line_bound(self, NULL, line, out, context, result, NULL);
+            if (result->token != NULL)
+                result->offset += line - cmd_line;
+
+            if (failed == false && clip_cmd_is_error(status)) {
+                failed = true;
+                failed_result = *result;
+                if (policy == CLIP_PIPELINE_STOP_ON_ERROR)
+                    break;
+            }
+        }
+        line = next;
     }
 
-    clip_notify_event_command_not_found(self, context, cmd, cmd_name);
+    // all responses go to the sink together
+    if (out != NULL)
+        clip_out_flush(out);
+
+    if (failed != false)
+        *result = failed_result;
+    return result->status;
+}
+
+bool clip_cmd_is_error(clip_status_t status)
+{
+    return status == CLIP_STATUS_COMMAND_NOT_FOUND || status == CLIP_STATUS_ARGUMENTS_ERROR || status == CLIP_STATUS_COMMAND_ERROR;
+}
+
+void clip_cmd_parse_line(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context)
+{
+    clip_cmd_parse_line_ex(self, cmd, cmd_line, NULL, context, NULL);
 }
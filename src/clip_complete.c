@@ -0,0 +1,319 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+///< keywords accepted by bool argument parser
+static const char *const g_clip_complete_bool_keywords[] = {"0", "1"};
+
+static void clip_complete_sift_down(const struct clip_command **list, size_t root, size_t num)
+{
+    while (2 * root + 1 < num) {
+        size_t child = 2 * root + 1;
+        if (child + 1 < num && strcmp(list[child]->name, list[child + 1]->name) < 0)
+            child++;
+        if (strcmp(list[root]->name, list[child]->name) >= 0)
+            return;
+        const struct clip_command *tmp = list[root];
+        list[root] = list[child];
+        list[child] = tmp;
+        root = child;
+    }
+}
+
+static void clip_complete_sort(const struct clip_command **list, size_t num)
+{
+    // heap sort (in place, without recursion and dynamic memory)
+    for (size_t i = num / 2; i > 0; i--)
+        clip_complete_sift_down(list, i - 1, num);
+
+    for (size_t end = num; end > 1; end--) {
+        const struct clip_command *tmp = list[0];
+        list[0] = list[end - 1];
+        list[end - 1] = tmp;
+        clip_complete_sift_down(list, 0, end - 1);
+    }
+}
+
+static bool clip_complete_build(struct clip_complete *self, const struct clip_command *parent, const struct clip_command **commands, size_t *pos)
+{
+    if (commands == NULL || *commands == NULL)
+        return true;
+
+    size_t id = clip_index_get_id(self->index, parent);
+    if (id >= self->ranges_num)
+        return false;
+
+    size_t head = clip_index_get_id(self->index, commands[0]);
+    if (head >= self->ranges_num)
+        return false;
+
+    // subcommands list shared by many commands (or reached again through shared command) is sorted once,
+    // it's found through range of its first command (lists starting with the same command are sorted separately)
+    if (self->ranges[head].list == commands) {
+        self->ranges[id].first = self->ranges[self->ranges[head].owner].first;
+        self->ranges[id].num = self->ranges[self->ranges[head].owner].num;
+        return true;
+    }
+
+    size_t num = 0;
+    while (commands[num] != NULL)
+        num++;
+
+    if (*pos + num > self->names_size)
+        return false;
+
+    memcpy(&self->names[*pos], commands, num * sizeof(*commands));
+    clip_complete_sort(&self->names[*pos], num);
+    self->ranges[id].first = *pos;
+    self->ranges[id].num = num;
+    if (self->ranges[head].list == NULL) {
+        self->ranges[head].list = commands;
+        self->ranges[head].owner = id;
+    }
+    *pos += num;
+
+    for (size_t i = 0; i < num; i++) {
+        if (clip_complete_build(self, commands[i], commands[i]->commands, pos) == false)
+            return false;
+    }
+    return true;
+}
+
+static size_t clip_complete_lower_bound(const struct clip_command **list, size_t num, const char *prefix, size_t len)
+{
+    size_t low = 0;
+    size_t high = num;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (strncmp(list[mid]->name, prefix, len) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static const struct clip_complete_range* clip_complete_get_range(const struct clip_complete *self, const struct clip_command *cmd)
+{
+    size_t id = clip_index_get_id(self->index, cmd);
+    return (id < self->ranges_num) ? &self->ranges[id] : NULL;
+}
+
+static const struct clip_command* clip_complete_find(const struct clip_complete *self, const struct clip_command *cmd, const char *name)
+{
+    const struct clip_complete_range *range = clip_complete_get_range(self, cmd);
+    if (range == NULL)
+        return NULL;
+
+    const struct clip_command **list = &self->names[range->first];
+    // terminating zero is compared too (exact name)
+    size_t i = clip_complete_lower_bound(list, range->num, name, strlen(name) + 1);
+    return (i < range->num && strcmp(list[i]->name, name) == 0) ? list[i] : NULL;
+}
+
+static const char* clip_complete_next_token(const char *ch, const char *end, char *token, size_t *token_len, bool *quoted, bool *overflow)
+{
+    // the same quotemarks and escape rules as in "clip_utils_arg_get_first" (escape sequences are not decoded)
+    bool escape = false;
+    size_t len = 0;
+
+    *quoted = false;
+    *overflow = false;
+
+    for (; ch < end; ch++) {
+        if (*quoted == false && *ch == ' ')
+            break;
+
+        if (escape == false && *ch == '\\') {
+            escape = true;
+            continue;
+        }
+
+        if (escape == false && *ch == '\"') {
+            *quoted = !*quoted;
+            continue;
+        }
+
+        escape = false;
+        if (len + 1 >= CLIP_CONFIG_COMPLETE_TOKEN_SIZE) {
+            *overflow = true;
+        } else {
+            token[len++] = *ch;
+        }
+    }
+
+    token[len] = '\0';
+    *token_len = len;
+    return ch;
+}
+
+static void clip_complete_add(struct clip_candidate *candidates, size_t size, struct clip_completion *result, clip_candidate_type_t type, const char *text, const struct clip_command *cmd, const struct clip_arg *arg)
+{
+    if (result->num < size) {
+        candidates[result->num].type = type;
+        candidates[result->num].text = text;
+        candidates[result->num].cmd = cmd;
+        candidates[result->num].arg = arg;
+    }
+    result->num++;
+}
+
+static void clip_complete_update_common(struct clip_completion *result, const char *first, const char *text)
+{
+    if (first == text) {
+        result->common = strlen(text);
+        return;
+    }
+
+    size_t i = result->prefix_len;
+    while (i < result->common && first[i] == text[i])
+        i++;
+    result->common = i;
+}
+
+static const struct clip_arg* clip_complete_get_arg(const struct clip_command *cmd, size_t arg_index)
+{
+    if (cmd->args == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < arg_index; i++) {
+        if (cmd->args[i] == NULL)
+            return NULL;
+    }
+    return cmd->args[arg_index];
+}
+
+bool clip_complete_init(struct clip_complete *self, const struct clip_index *index, const struct clip_command **names, size_t names_size, struct clip_complete_range *ranges, size_t ranges_num)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(index != NULL);
+    CLIP_CONFIG_ASSERT(names != NULL || names_size == 0);
+    CLIP_CONFIG_ASSERT(ranges != NULL);
+    CLIP_CONFIG_ASSERT(ranges_num > 0);
+
+    self->index = index;
+    self->names = names;
+    self->names_size = names_size;
+    self->ranges = ranges;
+    self->ranges_num = ranges_num;
+
+    for (size_t i = 0; i < ranges_num; i++) {
+        ranges[i].first = 0;
+        ranges[i].num = 0;
+        ranges[i].list = NULL;
+        ranges[i].owner = 0;
+    }
+
+    size_t pos = 0;
+    return clip_complete_build(self, NULL, index->clip->commands, &pos);
+}
+
+size_t clip_complete_line(const struct clip_complete *self, const char *line, size_t len, struct clip_candidate *candidates, size_t size, struct clip_completion *result)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(line != NULL || len == 0);
+    CLIP_CONFIG_ASSERT(candidates != NULL || size == 0);
+    CLIP_CONFIG_ASSERT(result != NULL);
+
+    memset(result, 0, sizeof(*result));
+
+    const char *ch = line;
+    const char *end = line + len;
+    const struct clip_command *cmd = NULL;
+    bool leaf = false;
+    size_t arg_index = 0;
+    char token[CLIP_CONFIG_COMPLETE_TOKEN_SIZE];
+    size_t token_len;
+    bool overflow;
+
+    while (true) {
+        while (ch < end && *ch == ' ')
+            ch++;
+
+        result->token = ch - line;
+        ch = clip_complete_next_token(ch, end, token, &token_len, &result->quoted, &overflow);
+        if (overflow)
+            return 0;
+
+        // the last token (not ended with space) is completed
+        if (ch == end)
+            break;
+
+        if (leaf) {
+            arg_index++;
+            continue;
+        }
+
+        cmd = clip_complete_find(self, cmd, token);
+        if (cmd == NULL)
+            return 0;
+        leaf = (cmd->commands == NULL || *cmd->commands == NULL);
+    }
+
+    result->prefix_len = token_len;
+    result->common = token_len;
+
+    const char *first = NULL;
+
+    if (leaf == false) {
+        const struct clip_complete_range *range = clip_complete_get_range(self, cmd);
+        if (range == NULL)
+            return 0;
+
+        const struct clip_command **list = &self->names[range->first];
+        for (size_t i = clip_complete_lower_bound(list, range->num, token, token_len); i < range->num; i++) {
+            if (strncmp(list[i]->name, token, token_len) != 0)
+                break;
+            if (first == NULL)
+                first = list[i]->name;
+            clip_complete_update_common(result, first, list[i]->name);
+            clip_complete_add(candidates, size, result, CLIP_CANDIDATE_COMMAND, list[i]->name, list[i], NULL);
+        }
+    } else {
+        const struct clip_arg *arg = clip_complete_get_arg(cmd, arg_index);
+        if (arg == NULL)
+            return 0;
+
+        if (arg->type == CLIP_ARG_TYPE_BOOL) {
+            for (size_t i = 0; i < sizeof(g_clip_complete_bool_keywords) / sizeof(g_clip_complete_bool_keywords[0]); i++) {
+                const char *keyword = g_clip_complete_bool_keywords[i];
+                if (strncmp(keyword, token, token_len) != 0)
+                    continue;
+                if (first == NULL)
+                    first = keyword;
+                clip_complete_update_common(result, first, keyword);
+                clip_complete_add(candidates, size, result, CLIP_CANDIDATE_KEYWORD, keyword, cmd, arg);
+            }
+        } else {
+            clip_complete_add(candidates, size, result, CLIP_CANDIDATE_ARGUMENT, NULL, cmd, arg);
+        }
+    }
+
+    return (result->num < size) ? result->num : size;
+}
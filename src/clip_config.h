@@ -45,4 +45,84 @@ SOFTWARE.
 #define CLIP_CONFIG_HELP_COMMAND "?"
 #endif
 
+#ifndef CLIP_CONFIG_CRC_TABLE_BITS
+///< size of CRC lookup tables index (4 - small nibble tables, 8 - fast 256-entries tables)
+#define CLIP_CONFIG_CRC_TABLE_BITS 4
+#endif
+
+#ifndef CLIP_CONFIG_EVENTS_DISABLED
+///< events removed at compile time, bitwise OR of CLIP_EVENT_MASK (notify calls are not compiled at all)
+#define CLIP_CONFIG_EVENTS_DISABLED 0
+#endif
+
+#ifndef CLIP_CONFIG_PROFILE_ENABLED
+///< latency profiler support (0 - profiler hooks are not compiled at all)
+#define CLIP_CONFIG_PROFILE_ENABLED 0
+#endif
+
+#ifndef CLIP_CONFIG_PROFILE_BUCKETS
+///< number of log2 buckets in every latency histogram (last bucket collects all longer samples)
+#define CLIP_CONFIG_PROFILE_BUCKETS 16
+#endif
+
+#ifndef CLIP_CONFIG_STATS_ENABLED
+///< statistics counters support (0 - counting hooks and built-in command are not compiled at all)
+#define CLIP_CONFIG_STATS_ENABLED 0
+#endif
+
+#ifndef CLIP_CONFIG_STATS_COMMAND
+///< special root command for dumping statistics counters (commands defined by user have priority)
+#define CLIP_CONFIG_STATS_COMMAND "stats"
+#endif
+
+#ifndef CLIP_CONFIG_TRACE_ENABLED
+///< trace ring buffer support (0 - trace hooks are not compiled at all)
+#define CLIP_CONFIG_TRACE_ENABLED 0
+#endif
+
+#ifndef CLIP_CONFIG_HELP_MAX_DEPTH
+///< maximum number of subcommands levels written by help writer (bounds its stack usage)
+#define CLIP_CONFIG_HELP_MAX_DEPTH 8
+#endif
+
+#ifndef CLIP_CONFIG_QUEUE_FENCE
+///< memory barrier between queue slot data (or trace record) and indexes access (on single-core MCU compiler barrier is enough)
+#define CLIP_CONFIG_QUEUE_FENCE() atomic_thread_fence(memory_order_seq_cst)
+#endif
+
+#ifndef CLIP_CONFIG_PIPELINE_SEPARATOR
+///< separator of commands in pipelined command line (see clip_cmd_parse_pipeline)
+#define CLIP_CONFIG_PIPELINE_SEPARATOR ';'
+#endif
+
+#ifndef CLIP_CONFIG_PIPELINE_ENABLED
+///< pipelined lines support in "clip_stream" and "clip_poll" input (0 - every line is single command)
+#define CLIP_CONFIG_PIPELINE_ENABLED 0
+#endif
+
+#ifndef CLIP_CONFIG_PIPELINE_POLICY
+///< error policy of pipelined lines in "clip_stream" and "clip_poll" input (see clip_pipeline_policy_t)
+#define CLIP_CONFIG_PIPELINE_POLICY CLIP_PIPELINE_STOP_ON_ERROR
+#endif
+
+#ifndef CLIP_CONFIG_EDITOR_ENABLED
+///< line editing in "clip_reader" (cursor keys, delete, history recall; 0 - editing code is not compiled at all)
+#define CLIP_CONFIG_EDITOR_ENABLED 0
+#endif
+
+#ifndef CLIP_CONFIG_SECTION_ENABLED
+///< root commands registration in linker section (GCC/Clang with ELF linker only, see CLIP_REGISTER_ROOT_COMMAND; 0 - not compiled at all)
+#define CLIP_CONFIG_SECTION_ENABLED 0
+#endif
+
+#ifndef CLIP_CONFIG_COMPLETE_TOKEN_SIZE
+///< size of completion buffer for single token (longer tokens are not completed)
+#define CLIP_CONFIG_COMPLETE_TOKEN_SIZE 32
+#endif
+
+#ifndef CLIP_CONFIG_COMPLETE_LIST_SIZE
+///< maximum number of candidates listed by line editor after tab key
+#define CLIP_CONFIG_COMPLETE_LIST_SIZE 16
+#endif
+
 #endif /* CLIP_CONFIG_H */
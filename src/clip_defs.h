@@ -25,7 +25,13 @@ SOFTWARE.
 #ifndef CLIP_DEFS_H
 #define CLIP_DEFS_H
 
+#include <limits.h>
+
 #include "clip_types.h"
+#include "clip_config.h"
+
+///< command callback return code which means "not finished yet, completion will be reported by clip_cmd_complete"
+#define CLIP_COMMAND_PENDING    INT_MIN
 
 ///< internal macro for defining subcommands
 #define _CLIP_DEF_SUBCOMMANDS()\
@@ -47,6 +53,12 @@ SOFTWARE.
 const struct clip_command var_name = {\
     _CLIP_DEF_COMMAND(cmd_name, cmd_description, callback_func)\
 
+///< public macro for defining root command with precomputed usage string (arguments part, see CLIP_USAGE_ARG)
+#define CLIP_DEF_ROOT_COMMAND_WITH_USAGE(var_name, cmd_name, cmd_description, callback_func, cmd_usage)\
+const struct clip_command var_name = {\
+    .usage = cmd_name cmd_usage,\
+    _CLIP_DEF_COMMAND(cmd_name, cmd_description, callback_func)\
+
 ///< public macro for finishing root command definition
 #define CLIP_DEF_ROOT_COMMAND_END_WITH_ARGS()\
         NULL,\
@@ -65,6 +77,18 @@ const struct clip_command var_name = {\
     &(const struct clip_command) {\
         _CLIP_DEF_COMMAND(cmd_name, cmd_description, callback_func)
 
+///< public macro for defining command with precomputed usage string (arguments part, see CLIP_USAGE_ARG)
+#define CLIP_DEF_COMMAND_WITH_USAGE(cmd_name, cmd_description, callback_func, cmd_usage)\
+    &(const struct clip_command) {\
+        .usage = cmd_name cmd_usage,\
+        _CLIP_DEF_COMMAND(cmd_name, cmd_description, callback_func)
+
+///< public macro for required argument part of precomputed usage string (type without prefix, e.g. UINT)
+#define CLIP_USAGE_ARG(arg_name, arg_type) " <" arg_name ":" #arg_type ">"
+
+///< public macro for optional argument part of precomputed usage string (type without prefix, e.g. UINT)
+#define CLIP_USAGE_OPT_ARG(arg_name, arg_type) " [" arg_name ":" #arg_type "]"
+
 ///< public macro for defining required argument
 #define CLIP_DEF_ARGUMENT(arg_name, arg_description, arg_type)\
     &(const struct clip_arg) {\
@@ -83,6 +107,37 @@ const struct clip_command var_name = {\
         .optional = true,\
     },\
 
+///< public macro for defining streamed argument (must be the last one, or followed only by its checksum)
+#define CLIP_DEF_STREAM_ARGUMENT(arg_name, arg_description, arg_stream)\
+    &(const struct clip_arg) {\
+        .name = arg_name,\
+        .description = arg_description,\
+        .type = CLIP_ARG_TYPE_HEXSTREAM,\
+        .optional = false,\
+        .stream = arg_stream,\
+    },\
+
+///< public macro for defining binary argument with integrity check (checksum must be the next UINT argument)
+#define CLIP_DEF_CHECKED_ARGUMENT(arg_name, arg_description, arg_type, arg_check)\
+    &(const struct clip_arg) {\
+        .name = arg_name,\
+        .description = arg_description,\
+        .type = arg_type,\
+        .optional = false,\
+        .check = arg_check,\
+    },\
+
+///< public macro for defining streamed argument with integrity check (checksum must be the next UINT argument)
+#define CLIP_DEF_CHECKED_STREAM_ARGUMENT(arg_name, arg_description, arg_stream, arg_check)\
+    &(const struct clip_arg) {\
+        .name = arg_name,\
+        .description = arg_description,\
+        .type = CLIP_ARG_TYPE_HEXSTREAM,\
+        .optional = false,\
+        .stream = arg_stream,\
+        .check = arg_check,\
+    },\
+
 ///< public macro for finishing command definition
 #define CLIP_DEF_COMMAND_END_WITH_ARGS()\
             NULL,\
@@ -109,6 +164,15 @@ const struct clip var_name = {\
     .event_callback = evt_callback,\
     .commands = (const struct clip_command**)&(const struct clip_command*[]) {\
 
+///< public macro for root definition with per-event handlers and event mask
+#define CLIP_DEF_ROOT_EX(var_name, usr_context, evt_callback, evt_handlers, evt_mask)\
+const struct clip var_name = {\
+    .context = usr_context,\
+    .event_callback = evt_callback,\
+    .event_mask = evt_mask,\
+    .event_handlers = evt_handlers,\
+    .commands = (const struct clip_command**)&(const struct clip_command*[]) {\
+
 ///< public macro for adding subcommands to root
 #define CLIP_DEF_ADD_ROOT_COMMAND(var_name)\
     var_name,\
@@ -119,4 +183,81 @@ const struct clip var_name = {\
     }\
 };\
 
+///< public macro for finishing root definition with additional fields (e.g. ".profile = &profile")
+#define CLIP_DEF_ROOT_END_WITH(...)\
+        NULL,\
+    },\
+    __VA_ARGS__\
+};\
+
+#if CLIP_CONFIG_SECTION_ENABLED && defined(__ELF__)
+///< public macro for registering root command in linker section (root is built by clip_section_init, see CLIP_CONFIG_SECTION_ENABLED)
+#define CLIP_REGISTER_ROOT_COMMAND(var_name)\
+static const struct clip_command *clip_section_##var_name __attribute__((used, section(CLIP_SECTION_NAME))) = &var_name;\
+
+#endif
+
+///< public macro for single event bit in event masks
+#define CLIP_EVENT_MASK(event) (1UL << (event))
+
+///< public macro for checking if event is compiled in (see CLIP_CONFIG_EVENTS_DISABLED)
+#define CLIP_EVENT_IS_COMPILED(event) ((CLIP_CONFIG_EVENTS_DISABLED & CLIP_EVENT_MASK(event)) == 0)
+
+///< public macro for checking if latency profiler is compiled in and attached to root
+#define CLIP_PROFILE_IS_ENABLED(clip) (CLIP_CONFIG_PROFILE_ENABLED && (clip)->profile != NULL)
+
+///< public macro for checking if statistics counters are compiled in and attached to root
+#define CLIP_STATS_IS_ENABLED(clip) (CLIP_CONFIG_STATS_ENABLED && (clip)->stats != NULL)
+
+///< public macro for checking if trace is compiled in and attached to root
+#define CLIP_TRACE_IS_ENABLED(clip) (CLIP_CONFIG_TRACE_ENABLED && (clip)->trace != NULL)
+
+///< public macro for checking if line editor is compiled in and history is attached to reader
+#define CLIP_HISTORY_IS_ENABLED(reader) (CLIP_CONFIG_EDITOR_ENABLED && (reader)->history != NULL)
+
+///< trace dump image magic (ascii "CLTR")
+#define CLIP_TRACE_DUMP_MAGIC   "CLTR"
+
+///< trace dump image format version
+#define CLIP_TRACE_DUMP_VERSION 1
+
+///< binary schema image magic (ascii "CLSC")
+#define CLIP_SCHEMA_MAGIC       "CLSC"
+
+///< schema format version (both json and binary)
+#define CLIP_SCHEMA_VERSION     1
+
+///< binary schema command flag: command has callback (may be called, not only a group of subcommands)
+#define CLIP_SCHEMA_FLAG_CALLABLE   0x01
+
+///< binary schema argument flag: argument is optional
+#define CLIP_SCHEMA_FLAG_OPTIONAL   0x01
+
+///< help writer depth for whole subtree (limited by CLIP_CONFIG_HELP_MAX_DEPTH)
+#define CLIP_HELP_DEPTH_ALL     ((size_t)-1)
+
+///< name of linker section with registered root commands (its bounds are __start_clip_commands and __stop_clip_commands)
+#define CLIP_SECTION_NAME       "clip_commands"
+
+///< maximum number of lines queue slots (difference of single byte indexes must tell full queue from empty one)
+#define CLIP_QUEUE_SLOTS_MAX_NUM    128
+
+///< value returned for commands which are not indexed
+#define CLIP_INDEX_INVALID_ID   ((size_t)-1)
+
+///< frame delimiter (COBS encoded frames never contain zero byte)
+#define CLIP_FRAME_DELIMITER    0x00
+
+///< size of request frame header: sequence number (u8), command ID (u16 LE)
+#define CLIP_FRAME_REQUEST_HEADER_SIZE  3
+
+///< size of response frame header: sequence number (u8), status (u8)
+#define CLIP_FRAME_RESPONSE_HEADER_SIZE 2
+
+///< response frame status for not final part of response (final frame status is clip_status_t)
+#define CLIP_FRAME_STATUS_MORE  0xFF
+
+///< maximum COBS encoding overhead for data of given size
+#define CLIP_FRAME_COBS_OVERHEAD(size)  ((size) / 254 + 1)
+
 #endif /* CLIP_DEFS_H */
@@ -0,0 +1,370 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+static uint32_t clip_frame_get_u32(const uint8_t *data, size_t size)
+{
+    uint32_t val = 0;
+
+    for (size_t i = 0; i < size; i++)
+        val |= (uint32_t)data[i] << (i << 3);
+    return val;
+}
+
+static void clip_frame_emit(struct clip_frame *self, uint8_t status, size_t size)
+{
+    uint8_t *frame = &self->tx[self->tx_reserve];
+
+    frame[0] = self->seq;
+    frame[1] = status;
+    size = clip_frame_cobs_encode(self->tx, frame, CLIP_FRAME_RESPONSE_HEADER_SIZE + size);
+    self->tx[size++] = CLIP_FRAME_DELIMITER;
+
+    if (self->sink != NULL)
+        self->sink(self, self->tx, size);
+}
+
+static void clip_frame_out_sink(struct clip_out *out, const char *data, size_t size)
+{
+    struct clip_frame *self = (struct clip_frame*)out->context;
+
+    // flushed during command call, so it's not the final part of response
+    while (size > 0) {
+        size_t chunk = (size < out->buf_size) ? size : out->buf_size;
+        if (data != out->buf)
+            memmove(out->buf, data, chunk);
+        clip_frame_emit(self, CLIP_FRAME_STATUS_MORE, chunk);
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+static void clip_frame_index_visitor(const struct clip_index *index, const struct clip_path *path, size_t id, void *context)
+{
+    struct clip_frame *self = (struct clip_frame*)context;
+
+    (void)index;
+    if (id < self->commands_num)
+        self->commands[id] = path->cmd;
+}
+
+static clip_arg_error_t clip_frame_type_error(clip_arg_type_t type)
+{
+    switch (type) {
+    case CLIP_ARG_TYPE_BOOL: return CLIP_ARG_ERROR_PARSE_BOOL;
+    case CLIP_ARG_TYPE_INT: return CLIP_ARG_ERROR_PARSE_INT;
+    case CLIP_ARG_TYPE_UINT: return CLIP_ARG_ERROR_PARSE_UINT;
+    case CLIP_ARG_TYPE_FLOAT: return CLIP_ARG_ERROR_PARSE_FLOAT;
+    case CLIP_ARG_TYPE_HEXARRAY:
+    case CLIP_ARG_TYPE_HEXSTREAM: return CLIP_ARG_ERROR_PARSE_HEXARRAY;
+    default: return CLIP_ARG_ERROR_TYPE_MISMATCH;
+    }
+}
+
+static bool clip_frame_is_hexarray(clip_arg_type_t type)
+{
+    return type == CLIP_ARG_TYPE_HEXARRAY || type == CLIP_ARG_TYPE_HEXSTREAM;
+}
+
+static bool clip_frame_decode_value(struct clip_arg_value *av, clip_arg_type_t type, uint8_t **data, const uint8_t *end)
+{
+    uint8_t *p = *data;
+    size_t left = end - p;
+    size_t len = 0;
+    uint32_t val = 0;
+
+    switch (type) {
+    case CLIP_ARG_TYPE_STRING:
+        // frame is zero-ended after its last byte, so the last string may be not terminated
+        end = memchr(p, '\0', left);
+        av->val_str = (char*)p;
+        *data = (end != NULL) ? (uint8_t*)end + 1 : p + left;
+        return true;
+
+    case CLIP_ARG_TYPE_BOOL:
+        if (left < 1 || p[0] > 1)
+            return false;
+        av->val_bool = (p[0] != 0);
+        *data = p + 1;
+        return true;
+
+    case CLIP_ARG_TYPE_INT:
+    case CLIP_ARG_TYPE_UINT:
+    case CLIP_ARG_TYPE_FLOAT:
+        if (left < sizeof(uint32_t))
+            return false;
+        val = clip_frame_get_u32(p, sizeof(uint32_t));
+        if (type == CLIP_ARG_TYPE_FLOAT) {
+            memcpy(&av->val_float, &val, sizeof(av->val_float));
+        } else {
+            av->val_uint = val;
+        }
+        *data = p + sizeof(uint32_t);
+        return true;
+
+    case CLIP_ARG_TYPE_HEXARRAY:
+    case CLIP_ARG_TYPE_HEXSTREAM:
+        if (left < 1)
+            return false;
+        if (p[0] & 0x80) {
+            size_t len_size = p[0] & 0x7F;
+            if (len_size > sizeof(uint32_t) || left < len_size + 1)
+                return false;
+            len = clip_frame_get_u32(&p[1], len_size);
+            left -= len_size + 1;
+            p += len_size + 1;
+        } else {
+            len = p[0];
+            left -= 1;
+            p += 1;
+        }
+        if (len > left)
+            return false;
+        av->type = CLIP_ARG_TYPE_HEXARRAY;
+        av->val_hexarray = *data;
+        *data = p + len;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static clip_arg_error_t clip_frame_decode_args(const struct clip_command *cmd, uint8_t *data, const uint8_t *end, size_t *argc, struct clip_arg_value argv[])
+{
+    clip_arg_error_t error = CLIP_ARG_ERROR_NO_ERROR;
+    bool no_more_required_args = false;
+    clip_arg_check_t check = CLIP_ARG_CHECK_NONE;
+    uint32_t crc = 0;
+
+    *argc = 0;
+    while (*argc < CLIP_CONFIG_ARGS_MAX_NUM) {
+        struct clip_arg_value *av = &argv[*argc];
+
+        av->type = CLIP_ARG_TYPE_STRING;
+        av->val_str = NULL;
+        if (data >= end)
+            break;
+
+        clip_arg_type_t type = (clip_arg_type_t)*data;
+        const struct clip_arg *ca = NULL;
+        if (no_more_required_args == false && cmd->args != NULL) {
+            ca = cmd->args[*argc];
+            if (ca == NULL)
+                no_more_required_args = true;
+        }
+
+        if (ca != NULL && type != ca->type && !(clip_frame_is_hexarray(type) && clip_frame_is_hexarray(ca->type))) {
+            error = CLIP_ARG_ERROR_TYPE_MISMATCH;
+            break;
+        }
+
+        data++;
+        av->type = type;
+        if (clip_frame_decode_value(av, type, &data, end) == false) {
+            error = clip_frame_type_error(type);
+            break;
+        }
+
+        if (ca != NULL && clip_frame_is_hexarray(ca->type) && ca->check != CLIP_ARG_CHECK_NONE) {
+            CLIP_CONFIG_ASSERT(clip_utils_arg_has_checksum(cmd->args, *argc));
+            uint8_t *bytes = NULL;
+            size_t size = clip_utils_arg_unpack_hexarray(&bytes, av->val_hexarray);
+            crc = clip_utils_crc_calc(ca->check, bytes, size);
+        }
+
+        error = clip_cmd_call_check_arg(ca, av, &check, crc);
+        if (error != CLIP_ARG_ERROR_NO_ERROR)
+            break;
+
+        (*argc)++;
+    }
+
+    // checked binary argument without following checksum argument
+    if (error == CLIP_ARG_ERROR_NO_ERROR && check != CLIP_ARG_CHECK_NONE)
+        error = CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS;
+
+    if (error != CLIP_ARG_ERROR_NO_ERROR) {
+        argv[*argc].type = CLIP_ARG_TYPE_STRING;
+        argv[*argc].val_str = NULL;
+    }
+    return error;
+}
+
+static void clip_frame_dispatch(struct clip_frame *self, size_t len)
+{
+    size_t argc = 0;
+    struct clip_arg_value argv[CLIP_CONFIG_ARGS_MAX_NUM] = {0};
+    struct clip_result result = {0};
+    const struct clip_command *cmd = NULL;
+    size_t id = self->rx[1] | ((size_t)self->rx[2] << 8);
+
+    self->seq = self->rx[0];
+    self->out.len = 0;
+
+    if (id > 0 && id < self->commands_num)
+        cmd = self->commands[id];
+
+    // group of subcommands can't be called (like in text, where subcommand name is missing)
+    if (cmd == NULL || (cmd->callback == NULL && cmd->commands != NULL)) {
+        clip_frame_emit(self, CLIP_STATUS_COMMAND_NOT_FOUND, 0);
+        return;
+    }
+
+    // zero after the last byte ends unterminated string (decoded frame is always shorter than encoded one)
+    self->rx[len] = '\0';
+    clip_arg_error_t error = clip_frame_decode_args(cmd, &self->rx[CLIP_FRAME_REQUEST_HEADER_SIZE], &self->rx[len], &argc, argv);
+
+    clip_cmd_call_decoded_args(self->clip, cmd, error, argc, argv, &self->out, self->context, &result);
+
+    if (result.status == CLIP_STATUS_ARGUMENTS_ERROR) {
+        self->out.buf[0] = (char)argc;
+        self->out.buf[1] = (char)result.error;
+        self->out.len = 2;
+    }
+    clip_frame_emit(self, result.status, self->out.len);
+    self->out.len = 0;
+}
+
+bool clip_frame_init(struct clip_frame *self, const struct clip *clip, const struct clip_index *index, const struct clip_command **commands, size_t commands_num, uint8_t *rx, size_t rx_size, uint8_t *tx, size_t tx_size, clip_frame_sink_t sink, void *context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(clip != NULL);
+    CLIP_CONFIG_ASSERT(index != NULL);
+    CLIP_CONFIG_ASSERT(commands != NULL || commands_num == 0);
+    CLIP_CONFIG_ASSERT(rx != NULL);
+    CLIP_CONFIG_ASSERT(tx != NULL);
+
+    memset(self, 0, sizeof(*self));
+    self->clip = clip;
+    self->commands = commands;
+    self->commands_num = commands_num;
+    self->rx = rx;
+    self->rx_size = rx_size;
+    self->tx = tx;
+    self->tx_size = tx_size;
+    self->sink = sink;
+    self->context = context;
+
+    // in place encoding writes at most one code byte per 254 bytes ahead of read position
+    self->tx_reserve = CLIP_FRAME_COBS_OVERHEAD(tx_size) + 1;
+    if (tx_size < self->tx_reserve + CLIP_FRAME_RESPONSE_HEADER_SIZE + 2 || index->count > commands_num)
+        return false;
+
+    clip_out_init(&self->out, (char*)&tx[self->tx_reserve + CLIP_FRAME_RESPONSE_HEADER_SIZE], tx_size - self->tx_reserve - CLIP_FRAME_RESPONSE_HEADER_SIZE, clip_frame_out_sink, self);
+
+    for (size_t i = 0; i < commands_num; i++)
+        commands[i] = NULL;
+    clip_index_walk(index, clip_frame_index_visitor, self);
+    return true;
+}
+
+size_t clip_frame_feed(struct clip_frame *self, const uint8_t *data, size_t size)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(data != NULL || size == 0);
+
+    size_t frames = 0;
+
+    while (size-- > 0) {
+        uint8_t byte = *data++;
+
+        if (byte != CLIP_FRAME_DELIMITER) {
+            if (self->rx_len < self->rx_size) {
+                self->rx[self->rx_len++] = byte;
+            } else {
+                self->rx_overflow = true;
+            }
+            continue;
+        }
+
+        size_t len = 0;
+        if (self->rx_overflow) {
+            self->dropped++;
+        } else if (self->rx_len > 0) {
+            // empty frames (repeated delimiters) are used for resynchronization, so they aren't counted
+            if (clip_frame_cobs_decode(self->rx, self->rx_len, &len) == false || len < CLIP_FRAME_REQUEST_HEADER_SIZE) {
+                self->dropped++;
+            } else {
+                clip_frame_dispatch(self, len);
+                frames++;
+            }
+        }
+        self->rx_len = 0;
+        self->rx_overflow = false;
+    }
+    return frames;
+}
+
+size_t clip_frame_cobs_encode(uint8_t *dst, const uint8_t *src, size_t size)
+{
+    CLIP_CONFIG_ASSERT(dst != NULL);
+    CLIP_CONFIG_ASSERT(src != NULL || size == 0);
+
+    size_t code_pos = 0;
+    size_t pos = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < size; i++) {
+        uint8_t byte = src[i];
+        if (byte != 0) {
+            dst[pos++] = byte;
+            code++;
+        }
+        if (byte == 0 || code == 0xFF) {
+            dst[code_pos] = code;
+            code_pos = pos++;
+            code = 1;
+        }
+    }
+    dst[code_pos] = code;
+    return pos;
+}
+
+bool clip_frame_cobs_decode(uint8_t *buf, size_t size, size_t *len)
+{
+    CLIP_CONFIG_ASSERT(buf != NULL || size == 0);
+    CLIP_CONFIG_ASSERT(len != NULL);
+
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < size) {
+        uint8_t code = buf[in++];
+        size_t block = code - 1;
+
+        if (code == 0 || block > size - in)
+            return false;
+        memmove(&buf[out], &buf[in], block);
+        out += block;
+        in += block;
+        if (code != 0xFF && in < size)
+            buf[out++] = 0;
+    }
+    *len = out;
+    return true;
+}
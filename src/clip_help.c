@@ -0,0 +1,104 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+static void clip_help_put_indent(struct clip_out *out, size_t indent)
+{
+    while (indent-- > 0)
+        clip_out_put_str(out, "  ");
+}
+
+static void clip_help_put_line(struct clip_out *out, const struct clip_command *cmd, size_t indent)
+{
+    clip_help_put_indent(out, indent);
+
+    clip_utils_arg_put_command_usage(out, cmd);
+    if (cmd->description != NULL) {
+        clip_out_put_str(out, " - ");
+        clip_out_put_str(out, cmd->description);
+    }
+    clip_out_put_str(out, "\n");
+}
+
+static void clip_help_put_levels(struct clip_out *out, const struct clip_command **commands, size_t indent, size_t depth)
+{
+    // iterative walk, stack usage is bounded by CLIP_CONFIG_HELP_MAX_DEPTH regardless of tree depth
+    const struct clip_command **stack[CLIP_CONFIG_HELP_MAX_DEPTH];
+    size_t level = 0;
+    bool clamped = false;
+
+    if (commands == NULL || depth == 0)
+        return;
+
+    if (depth > CLIP_CONFIG_HELP_MAX_DEPTH) {
+        depth = CLIP_CONFIG_HELP_MAX_DEPTH;
+        clamped = true;
+    }
+
+    stack[0] = commands;
+    while (true) {
+        const struct clip_command *cmd = *stack[level];
+
+        if (cmd == NULL) {
+            if (level == 0)
+                break;
+            level--;
+            continue;
+        }
+        stack[level]++;
+
+        clip_help_put_line(out, cmd, indent + level);
+
+        if (cmd->commands != NULL && *cmd->commands != NULL) {
+            if (level + 1 < depth) {
+                level++;
+                stack[level] = cmd->commands;
+            } else if (clamped) {
+                // subcommands cut by CLIP_CONFIG_HELP_MAX_DEPTH (not by requested depth) are marked
+                clip_help_put_indent(out, indent + level + 1);
+                clip_out_put_str(out, "...\n");
+            }
+        }
+    }
+}
+
+void clip_help_put_commands(struct clip_out *out, const struct clip_command **commands, size_t depth)
+{
+    if (out == NULL)
+        return;
+
+    clip_help_put_levels(out, commands, 0, depth);
+}
+
+void clip_help_put_command(struct clip_out *out, const struct clip_command *cmd, size_t depth)
+{
+    if (out == NULL)
+        return;
+
+    CLIP_CONFIG_ASSERT(cmd != NULL);
+
+    clip_help_put_line(out, cmd, 0);
+    clip_help_put_levels(out, cmd->commands, 1, depth);
+}
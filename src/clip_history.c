@@ -0,0 +1,153 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+static size_t clip_history_index(const struct clip_history *self, size_t offset)
+{
+    size_t index = self->tail + offset;
+    return (index >= self->size) ? index - self->size : index;
+}
+
+static void clip_history_drop_oldest(struct clip_history *self)
+{
+    size_t len = 0;
+    while (self->buf[clip_history_index(self, len)] != '\0')
+        len++;
+
+    self->tail = clip_history_index(self, len + 1);
+    self->used -= len + 1;
+    self->lines--;
+}
+
+static bool clip_history_is_newest(const struct clip_history *self, const char *line, size_t len)
+{
+    size_t pos;
+    size_t newest_len;
+
+    if (clip_history_find(self, 1, &pos, &newest_len) == false || newest_len != len)
+        return false;
+
+    for (size_t i = 0; i < len; i++) {
+        if (self->buf[pos] != line[i])
+            return false;
+        if (++pos == self->size)
+            pos = 0;
+    }
+    return true;
+}
+
+void clip_history_init(struct clip_history *self, char *buf, size_t size)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(buf != NULL);
+    CLIP_CONFIG_ASSERT(size > 0);
+
+    memset(self, 0, sizeof(*self));
+    self->buf = buf;
+    self->size = size;
+}
+
+void clip_history_add(struct clip_history *self, const char *line, size_t len)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(line != NULL);
+
+    if (len == 0 || len + 1 > self->size)
+        return;
+
+    if (clip_history_is_newest(self, line, len))
+        return;
+
+    while (self->size - self->used < len + 1)
+        clip_history_drop_oldest(self);
+
+    size_t pos = clip_history_index(self, self->used);
+    for (size_t i = 0; i < len; i++) {
+        self->buf[pos] = line[i];
+        if (++pos == self->size)
+            pos = 0;
+    }
+    self->buf[pos] = '\0';
+
+    self->used += len + 1;
+    self->lines++;
+}
+
+bool clip_history_find(const struct clip_history *self, size_t back, size_t *pos, size_t *len)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(pos != NULL);
+    CLIP_CONFIG_ASSERT(len != NULL);
+
+    if (back == 0 || back > self->lines)
+        return false;
+
+    size_t start = self->used;
+    size_t end = start;
+
+    for (size_t i = 0; i < back; i++) {
+        end = start - 1;
+        start = end;
+        while (start > 0 && self->buf[clip_history_index(self, start - 1)] != '\0')
+            start--;
+    }
+
+    *pos = clip_history_index(self, start);
+    *len = end - start;
+    return true;
+}
+
+size_t clip_history_copy(const struct clip_history *self, size_t pos, size_t len, char *buf, size_t buf_size)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(buf != NULL);
+    CLIP_CONFIG_ASSERT(buf_size > 0);
+
+    if (len > buf_size - 1)
+        len = buf_size - 1;
+
+    size_t first = self->size - pos;
+    if (first > len)
+        first = len;
+
+    memcpy(buf, &self->buf[pos], first);
+    memcpy(&buf[first], self->buf, len - first);
+    buf[len] = '\0';
+    return len;
+}
+
+void clip_history_put(const struct clip_history *self, size_t pos, size_t len, struct clip_out *out)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    size_t first = self->size - pos;
+    if (first > len)
+        first = len;
+
+    clip_out_put_bytes(out, &self->buf[pos], first);
+    clip_out_put_bytes(out, self->buf, len - first);
+}
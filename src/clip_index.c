@@ -0,0 +1,141 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+static inline size_t clip_index_hash(const struct clip_index *self, const struct clip_command *cmd)
+{
+    // pointers are aligned, so lower bits are dropped before multiplicative hashing
+    return (size_t)((((uintptr_t)cmd >> 3) * 2654435761UL) % self->size);
+}
+
+static bool clip_index_insert(struct clip_index *self, const struct clip_command *cmd)
+{
+    // at least one slot must stay free (it finishes probing)
+    if (self->count >= self->size)
+        return false;
+
+    size_t slot = clip_index_hash(self, cmd);
+    while (self->entries[slot].cmd != NULL) {
+        if (self->entries[slot].cmd == cmd)
+            return true;
+        slot = (slot + 1) % self->size;
+    }
+
+    self->entries[slot].cmd = cmd;
+    self->entries[slot].id = self->count++;
+    return true;
+}
+
+static bool clip_index_insert_recursive(struct clip_index *self, const struct clip_command **commands)
+{
+    if (commands == NULL)
+        return true;
+
+    while (*commands != NULL) {
+        if (clip_index_insert(self, *commands) == false)
+            return false;
+        if (clip_index_insert_recursive(self, (*commands)->commands) == false)
+            return false;
+        commands++;
+    }
+    return true;
+}
+
+bool clip_index_init(struct clip_index *self, const struct clip *clip, struct clip_index_entry *entries, size_t size)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(clip != NULL);
+    CLIP_CONFIG_ASSERT(entries != NULL);
+    CLIP_CONFIG_ASSERT(size > 0);
+
+    self->clip = clip;
+    self->entries = entries;
+    self->size = size;
+    // id 0 is reserved for root
+    self->count = 1;
+
+    for (size_t i = 0; i < size; i++) {
+        entries[i].cmd = NULL;
+        entries[i].id = 0;
+    }
+
+    return clip_index_insert_recursive(self, clip->commands);
+}
+
+size_t clip_index_get_id(const struct clip_index *self, const struct clip_command *cmd)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    if (cmd == NULL)
+        return 0;
+
+    size_t slot = clip_index_hash(self, cmd);
+    while (self->entries[slot].cmd != NULL) {
+        if (self->entries[slot].cmd == cmd)
+            return self->entries[slot].id;
+        slot = (slot + 1) % self->size;
+    }
+    return CLIP_INDEX_INVALID_ID;
+}
+
+const struct clip_command* clip_index_get_command(const struct clip_index *self, size_t id)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    for (size_t i = 0; i < self->size; i++) {
+        if (self->entries[i].cmd != NULL && self->entries[i].id == id)
+            return self->entries[i].cmd;
+    }
+    return NULL;
+}
+
+static void clip_index_walk_recursive(const struct clip_index *self, const struct clip_command **commands, const struct clip_path *parent, clip_index_visitor_t visitor, void *context)
+{
+    if (commands == NULL)
+        return;
+
+    while (*commands != NULL) {
+        const struct clip_path path = {
+            .cmd = *commands,
+            .parent = parent,
+        };
+        visitor(self, &path, clip_index_get_id(self, *commands), context);
+        clip_index_walk_recursive(self, (*commands)->commands, &path, visitor, context);
+        commands++;
+    }
+}
+
+void clip_index_walk(const struct clip_index *self, clip_index_visitor_t visitor, void *context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(visitor != NULL);
+
+    const struct clip_path root = {
+        .cmd = NULL,
+        .parent = NULL,
+    };
+    visitor(self, &root, 0, context);
+    clip_index_walk_recursive(self, self->clip->commands, NULL, visitor, context);
+}
@@ -24,11 +24,27 @@ SOFTWARE.
 
 #include "clip.h"
 
+static inline bool clip_notify_is_masked(const struct clip *self, clip_event_t event)
+{
+    return (self->event_mask & CLIP_EVENT_MASK(event)) != 0;
+}
+
 void clip_notify_event_help(const struct clip *self, void *context, const struct clip_command *cmd, const struct clip_command **commands)
 {
     CLIP_CONFIG_ASSERT(self != NULL);
     CLIP_CONFIG_ASSERT(commands != NULL);
 
+    if (clip_notify_is_masked(self, CLIP_EVENT_HELP))
+        return;
+
+    if (self->event_handlers != NULL && self->event_handlers->help != NULL) {
+        self->event_handlers->help(self, cmd, commands, context);
+        return;
+    }
+
+    if (self->event_callback == NULL)
+        return;
+
     union clip_event_arg event_arg = {
         .help = {
             .cmd = cmd,
@@ -36,8 +52,7 @@ void clip_notify_event_help(const struct clip *self, void *context, const struct
         }
     };
 
-    if (self->event_callback != NULL)
-        self->event_callback(self, CLIP_EVENT_HELP, &event_arg, context);
+    self->event_callback(self, CLIP_EVENT_HELP, &event_arg, context);
 }
 
 void clip_notify_event_command_not_found(const struct clip *self, void *context, const struct clip_command *cmd, const char *cmd_name)
@@ -45,6 +60,17 @@ void clip_notify_event_command_not_found(const struct clip *self, void *context,
     CLIP_CONFIG_ASSERT(self != NULL);
     CLIP_CONFIG_ASSERT(cmd_name != NULL);
 
+    if (clip_notify_is_masked(self, CLIP_EVENT_COMMAND_NOT_FOUND))
+        return;
+
+    if (self->event_handlers != NULL && self->event_handlers->command_not_found != NULL) {
+        self->event_handlers->command_not_found(self, cmd, cmd_name, context);
+        return;
+    }
+
+    if (self->event_callback == NULL)
+        return;
+
     union clip_event_arg event_arg = {
         .command_not_found = {
             .cmd = cmd,
@@ -52,8 +78,7 @@ void clip_notify_event_command_not_found(const struct clip *self, void *context,
         }
     };
 
-    if (self->event_callback != NULL)
-        self->event_callback(self, CLIP_EVENT_COMMAND_NOT_FOUND, &event_arg, context);
+    self->event_callback(self, CLIP_EVENT_COMMAND_NOT_FOUND, &event_arg, context);
 }
 
 void clip_notify_event_arguments_error(const struct clip *self, void *context, const struct clip_command *cmd, clip_arg_error_t error)
@@ -61,6 +86,17 @@ void clip_notify_event_arguments_error(const struct clip *self, void *context, c
     CLIP_CONFIG_ASSERT(self != NULL);
     CLIP_CONFIG_ASSERT(cmd != NULL);
 
+    if (clip_notify_is_masked(self, CLIP_EVENT_ARGUMENTS_ERROR))
+        return;
+
+    if (self->event_handlers != NULL && self->event_handlers->arguments_error != NULL) {
+        self->event_handlers->arguments_error(self, cmd, error, context);
+        return;
+    }
+
+    if (self->event_callback == NULL)
+        return;
+
     union clip_event_arg event_arg = {
         .arguments_error = {
             .cmd = cmd,
@@ -68,8 +104,7 @@ void clip_notify_event_arguments_error(const struct clip *self, void *context, c
         }
     };
 
-    if (self->event_callback != NULL)
-        self->event_callback(self, CLIP_EVENT_ARGUMENTS_ERROR, &event_arg, context);
+    self->event_callback(self, CLIP_EVENT_ARGUMENTS_ERROR, &event_arg, context);
 }
 
 void clip_notify_event_call_command_callback(const struct clip *self, void *context, const struct clip_command *cmd, const char *cmd_line)
@@ -78,6 +113,17 @@ void clip_notify_event_call_command_callback(const struct clip *self, void *cont
     CLIP_CONFIG_ASSERT(cmd != NULL);
     CLIP_CONFIG_ASSERT(cmd_line != NULL);
 
+    if (clip_notify_is_masked(self, CLIP_EVENT_CALL_COMMAND_CALLBACK))
+        return;
+
+    if (self->event_handlers != NULL && self->event_handlers->call_command_callback != NULL) {
+        self->event_handlers->call_command_callback(self, cmd, cmd_line, context);
+        return;
+    }
+
+    if (self->event_callback == NULL)
+        return;
+
     union clip_event_arg event_arg = {
         .call_command_callback = {
             .cmd = cmd,
@@ -85,6 +131,31 @@ void clip_notify_event_call_command_callback(const struct clip *self, void *cont
         }
     };
 
-    if (self->event_callback != NULL)
-        self->event_callback(self, CLIP_EVENT_CALL_COMMAND_CALLBACK, &event_arg, context);
+    self->event_callback(self, CLIP_EVENT_CALL_COMMAND_CALLBACK, &event_arg, context);
+}
+
+void clip_notify_event_command_complete(const struct clip *self, void *context, const struct clip_command *cmd, int code)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(cmd != NULL);
+
+    if (clip_notify_is_masked(self, CLIP_EVENT_COMMAND_COMPLETE))
+        return;
+
+    if (self->event_handlers != NULL && self->event_handlers->command_complete != NULL) {
+        self->event_handlers->command_complete(self, cmd, code, context);
+        return;
+    }
+
+    if (self->event_callback == NULL)
+        return;
+
+    union clip_event_arg event_arg = {
+        .command_complete = {
+            .cmd = cmd,
+            .code = code
+        }
+    };
+
+    self->event_callback(self, CLIP_EVENT_COMMAND_COMPLETE, &event_arg, context);
 }
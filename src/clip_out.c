@@ -0,0 +1,133 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+void clip_out_init(struct clip_out *self, char *buf, size_t buf_size, clip_out_sink_t sink, void *context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(buf != NULL || buf_size == 0);
+
+    self->buf = buf;
+    self->buf_size = buf_size;
+    self->len = 0;
+    self->sink = sink;
+    self->context = context;
+}
+
+void clip_out_flush(struct clip_out *self)
+{
+    if (self == NULL || self->len == 0)
+        return;
+
+    if (self->sink != NULL)
+        self->sink(self, self->buf, self->len);
+    self->len = 0;
+}
+
+void clip_out_put_bytes(struct clip_out *self, const void *data, size_t size)
+{
+    if (self == NULL || size == 0)
+        return;
+
+    CLIP_CONFIG_ASSERT(data != NULL);
+
+    if (self->len + size > self->buf_size) {
+        clip_out_flush(self);
+        if (size >= self->buf_size) {
+            // too big to be buffered, pass it directly to sink (without copying)
+            if (self->sink != NULL)
+                self->sink(self, (const char*)data, size);
+            return;
+        }
+    }
+
+    memcpy(&self->buf[self->len], data, size);
+    self->len += size;
+}
+
+void clip_out_put_str(struct clip_out *self, const char *str)
+{
+    if (self == NULL)
+        return;
+
+    CLIP_CONFIG_ASSERT(str != NULL);
+
+    clip_out_put_bytes(self, str, strlen(str));
+}
+
+void clip_out_put_u32(struct clip_out *self, uint32_t value)
+{
+    char tmp[10];
+    size_t i = sizeof(tmp);
+
+    if (self == NULL)
+        return;
+
+    do {
+        tmp[--i] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    clip_out_put_bytes(self, &tmp[i], sizeof(tmp) - i);
+}
+
+void clip_out_put_hex(struct clip_out *self, const uint8_t *data, size_t size)
+{
+    char tmp[32];
+
+    if (self == NULL)
+        return;
+
+    CLIP_CONFIG_ASSERT(data != NULL || size == 0);
+
+    while (size > 0) {
+        size_t n = (size < sizeof(tmp) / 2) ? size : sizeof(tmp) / 2;
+        clip_utils_hex_from_buf(tmp, data, n);
+        clip_out_put_bytes(self, tmp, n * 2);
+        data += n;
+        size -= n;
+    }
+}
+
+void clip_out_put_path(struct clip_out *self, const struct clip_path *path)
+{
+    if (self == NULL)
+        return;
+
+    CLIP_CONFIG_ASSERT(path != NULL);
+
+    if (path->cmd == NULL) {
+        clip_out_put_str(self, ".");
+        return;
+    }
+
+    if (path->parent != NULL) {
+        clip_out_put_path(self, path->parent);
+        clip_out_put_str(self, " ");
+    }
+    clip_out_put_str(self, path->cmd->name);
+}
@@ -0,0 +1,149 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+///< structure contains histograms dump state
+struct clip_profile_dump_context {
+    const struct clip_profile *self;            ///< dumped profiler
+    struct clip_out *out;                       ///< response writer for the dump
+};
+
+static const char *clip_profile_stage_names[CLIP_PROFILE_STAGE_NUM] = {
+    [CLIP_PROFILE_STAGE_TOKENIZE] = "tokenize",
+    [CLIP_PROFILE_STAGE_LOOKUP] = "lookup",
+    [CLIP_PROFILE_STAGE_ARGS] = "args",
+    [CLIP_PROFILE_STAGE_CALLBACK] = "callback",
+};
+
+static inline size_t clip_profile_get_bucket(uint32_t ticks)
+{
+    size_t bucket = 0;
+    while (ticks != 0 && bucket < CLIP_CONFIG_PROFILE_BUCKETS - 1) {
+        ticks >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void clip_profile_init(struct clip_profile *self, const struct clip_index *index, struct clip_profile_entry *entries, size_t entries_num, clip_profile_time_t time, void *time_context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(index != NULL);
+    CLIP_CONFIG_ASSERT(entries != NULL || entries_num == 0);
+    CLIP_CONFIG_ASSERT(time != NULL);
+
+    self->index = index;
+    self->entries = entries;
+    self->entries_num = entries_num;
+    self->time = time;
+    self->time_context = time_context;
+
+    clip_profile_reset(self);
+}
+
+void clip_profile_reset(struct clip_profile *self)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    if (self->entries_num > 0)
+        memset(self->entries, 0, self->entries_num * sizeof(struct clip_profile_entry));
+}
+
+uint32_t clip_profile_now(const struct clip_profile *self)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    return self->time(self->time_context);
+}
+
+void clip_profile_record(struct clip_profile *self, const struct clip_command *cmd, clip_profile_stage_t stage, uint32_t ticks)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(stage < CLIP_PROFILE_STAGE_NUM);
+
+    size_t id = clip_index_get_id(self->index, cmd);
+    if (id >= self->entries_num)
+        return;
+
+    uint32_t *bucket = &self->entries[id].buckets[stage][clip_profile_get_bucket(ticks)];
+    if (*bucket != UINT32_MAX)
+        (*bucket)++;
+}
+
+uint32_t clip_profile_lap(struct clip_profile *self, const struct clip_command *cmd, clip_profile_stage_t stage, uint32_t start)
+{
+    uint32_t now = clip_profile_now(self);
+    clip_profile_record(self, cmd, stage, now - start);
+    return now;
+}
+
+static void clip_profile_dump_entry(const struct clip_index *index, const struct clip_path *path, size_t id, void *context)
+{
+    const struct clip_profile_dump_context *ctx = (const struct clip_profile_dump_context*)context;
+
+    if (id >= ctx->self->entries_num)
+        return;
+
+    for (size_t stage = 0; stage < CLIP_PROFILE_STAGE_NUM; stage++) {
+        const uint32_t *buckets = ctx->self->entries[id].buckets[stage];
+        bool empty = true;
+        for (size_t i = 0; i < CLIP_CONFIG_PROFILE_BUCKETS; i++) {
+            if (buckets[i] != 0) {
+                empty = false;
+                break;
+            }
+        }
+        if (empty)
+            continue;
+
+        clip_out_put_path(ctx->out, path);
+        clip_out_put_str(ctx->out, " ");
+        clip_out_put_str(ctx->out, clip_profile_stage_names[stage]);
+        clip_out_put_str(ctx->out, ":");
+        for (size_t i = 0; i < CLIP_CONFIG_PROFILE_BUCKETS; i++) {
+            if (buckets[i] == 0)
+                continue;
+            // bucket is labeled with its lower bound
+            clip_out_put_str(ctx->out, " ");
+            clip_out_put_u32(ctx->out, (i == 0) ? 0 : (1UL << (i - 1)));
+            clip_out_put_str(ctx->out, (i == 0) ? ":" : "+:");
+            clip_out_put_u32(ctx->out, buckets[i]);
+        }
+        clip_out_put_str(ctx->out, "\n");
+    }
+}
+
+void clip_profile_dump(const struct clip_profile *self, struct clip_out *out)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    const struct clip_profile_dump_context ctx = {
+        .self = self,
+        .out = out,
+    };
+    clip_index_walk(self->index, clip_profile_dump_entry, (void*)&ctx);
+}
@@ -0,0 +1,170 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+static char* clip_queue_slot(const struct clip_queue *self, clip_queue_index_t index)
+{
+    return &self->buf[(index & (self->slots_num - 1)) * self->slot_size];
+}
+
+static size_t clip_queue_depth(clip_queue_index_t head, clip_queue_index_t tail)
+{
+    // indexes are free running modulo 256 (slots number divides it)
+    return (clip_queue_index_t)(head - tail);
+}
+
+void clip_queue_init(struct clip_queue *self, char *buf, size_t slot_size, size_t slots_num)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(buf != NULL);
+    CLIP_CONFIG_ASSERT(slot_size > 1);
+    CLIP_CONFIG_ASSERT(slots_num > 0 && (slots_num & (slots_num - 1)) == 0);
+    CLIP_CONFIG_ASSERT(slots_num <= CLIP_QUEUE_SLOTS_MAX_NUM);
+
+    memset(self, 0, sizeof(*self));
+    self->buf = buf;
+    self->slot_size = slot_size;
+    self->slots_num = slots_num;
+    self->state = CLIP_QUEUE_STATE_LINE;
+}
+
+static void clip_queue_publish(struct clip_queue *self)
+{
+    if (self->len > self->max_len)
+        self->max_len = self->len;
+
+    switch (self->state) {
+    case CLIP_QUEUE_STATE_FULL:
+        self->dropped_full++;
+        break;
+
+    case CLIP_QUEUE_STATE_TOO_LONG:
+        self->dropped_long++;
+        break;
+
+    case CLIP_QUEUE_STATE_LINE:
+    default: {
+        clip_queue_index_t head = self->head;
+        clip_queue_slot(self, head)[self->len] = '\0';
+        // line data must be visible to consumer before the slot is published
+        CLIP_CONFIG_QUEUE_FENCE();
+        self->head = (clip_queue_index_t)(head + 1);
+
+        size_t depth = clip_queue_depth(head + 1, self->tail);
+        if (depth > self->max_depth)
+            self->max_depth = depth;
+        break;
+    }
+    }
+}
+
+void clip_queue_push_char(struct clip_queue *self, char ch)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    if (ch == '\r')
+        return;
+
+    if (ch == '\n') {
+        if (self->len > 0)
+            clip_queue_publish(self);
+        self->len = 0;
+        self->state = CLIP_QUEUE_STATE_LINE;
+        return;
+    }
+
+    if (self->len == 0) {
+        // slot is chosen when line begins, so it can't be released in the middle of the line
+        if (clip_queue_depth(self->head, self->tail) >= self->slots_num)
+            self->state = CLIP_QUEUE_STATE_FULL;
+        // consumer must finish with the slot before it is overwritten
+        CLIP_CONFIG_QUEUE_FENCE();
+    }
+
+    if (self->state == CLIP_QUEUE_STATE_LINE && self->len + 1 >= self->slot_size)
+        self->state = CLIP_QUEUE_STATE_TOO_LONG;
+
+    // length of dropped lines is counted too, to know the needed slot size
+    if (self->state == CLIP_QUEUE_STATE_LINE)
+        clip_queue_slot(self, self->head)[self->len] = ch;
+    self->len++;
+}
+
+void clip_queue_push(struct clip_queue *self, const char *data, size_t size)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(data != NULL);
+
+    while (size-- > 0)
+        clip_queue_push_char(self, *data++);
+}
+
+char* clip_queue_front(struct clip_queue *self)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    clip_queue_index_t tail = self->tail;
+    if (tail == self->head)
+        return NULL;
+
+    // slot data is read after its publication is seen
+    CLIP_CONFIG_QUEUE_FENCE();
+    return clip_queue_slot(self, tail);
+}
+
+void clip_queue_pop(struct clip_queue *self)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(self->tail != self->head);
+
+    // slot data is no longer used when it's released to producer
+    CLIP_CONFIG_QUEUE_FENCE();
+    self->tail = (clip_queue_index_t)(self->tail + 1);
+}
+
+size_t clip_poll(const struct clip *self, struct clip_queue *queue, struct clip_out *out, void *context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(queue != NULL);
+
+    size_t count = 0;
+    size_t pending = clip_queue_depth(queue->head, queue->tail);
+
+    while (count < pending) {
+        char *line = clip_queue_front(queue);
+        if (CLIP_CONFIG_PIPELINE_ENABLED) {
+            clip_cmd_parse_pipeline(self, line, out, context, CLIP_CONFIG_PIPELINE_POLICY, NULL);
+        } else {
+            clip_cmd_parse_line_ex(self, NULL, line, out, context, NULL);
+        }
+        clip_queue_pop(queue);
+        count++;
+    }
+
+    return count;
+}
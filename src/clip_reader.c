@@ -0,0 +1,424 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+///< ANSI escape sequence of erasing line from cursor to end
+#define CLIP_READER_ERASE_TO_END    "\x1B[K"
+
+static void clip_reader_echo(struct clip_reader *self, const char *str)
+{
+    if (self->echo != NULL)
+        clip_out_put_str(self->echo, str);
+}
+
+static void clip_reader_echo_bytes(struct clip_reader *self, const char *data, size_t size)
+{
+    if (self->echo != NULL)
+        clip_out_put_bytes(self->echo, data, size);
+}
+
+static void clip_reader_echo_left(struct clip_reader *self, size_t num)
+{
+    if (self->echo == NULL)
+        return;
+
+    // single backspaces are shorter than escape sequence for short moves
+    if (num > 3) {
+        clip_out_put_str(self->echo, "\x1B[");
+        clip_out_put_u32(self->echo, (uint32_t)num);
+        clip_out_put_str(self->echo, "D");
+        return;
+    }
+    while (num-- > 0)
+        clip_out_put_str(self->echo, "\b");
+}
+
+static void clip_reader_insert(struct clip_reader *self, char ch)
+{
+    size_t tail = self->len - self->cursor;
+
+    memmove(&self->buf[self->cursor + 1], &self->buf[self->cursor], tail);
+    self->buf[self->cursor] = ch;
+    self->len++;
+
+    clip_reader_echo_bytes(self, &self->buf[self->cursor], tail + 1);
+    clip_reader_echo_left(self, tail);
+    self->cursor++;
+}
+
+static void clip_reader_delete(struct clip_reader *self)
+{
+    size_t tail = self->len - self->cursor - 1;
+
+    memmove(&self->buf[self->cursor], &self->buf[self->cursor + 1], tail);
+    self->len--;
+
+    clip_reader_echo_bytes(self, &self->buf[self->cursor], tail);
+    clip_reader_echo(self, " ");
+    clip_reader_echo_left(self, tail + 1);
+}
+
+static void clip_reader_backspace(struct clip_reader *self)
+{
+    self->cursor--;
+    clip_reader_echo_left(self, 1);
+    clip_reader_delete(self);
+}
+
+static void clip_reader_insert_str(struct clip_reader *self, const char *str, size_t len)
+{
+    for (size_t i = 0; i < len && self->len + 1 < self->buf_size; i++)
+        clip_reader_insert(self, str[i]);
+}
+
+static void clip_reader_show(struct clip_reader *self, size_t shown_cursor, size_t shown_len)
+{
+    size_t len;
+
+    clip_reader_echo_left(self, shown_cursor);
+    if (self->recall > 0) {
+        clip_history_put(self->history, self->recall_pos, self->recall_len, self->echo);
+        len = self->recall_len;
+    } else {
+        clip_reader_echo_bytes(self, self->buf, self->len);
+        len = self->len;
+    }
+    if (len < shown_len)
+        clip_reader_echo(self, CLIP_READER_ERASE_TO_END);
+    if (self->recall == 0)
+        clip_reader_echo_left(self, self->len - self->cursor);
+}
+
+static void clip_reader_recall(struct clip_reader *self, size_t recall)
+{
+    size_t pos = 0;
+    size_t len = 0;
+
+    if (recall > 0 && clip_history_find(self->history, recall, &pos, &len) == false)
+        return;
+
+    size_t shown_cursor = (self->recall > 0) ? self->recall_len : self->cursor;
+    size_t shown_len = (self->recall > 0) ? self->recall_len : self->len;
+
+    self->recall = recall;
+    self->recall_pos = pos;
+    self->recall_len = len;
+    clip_reader_show(self, shown_cursor, shown_len);
+}
+
+static void clip_reader_select(struct clip_reader *self)
+{
+    if (self->recall == 0)
+        return;
+
+    size_t shown_len = self->recall_len;
+
+    self->len = clip_history_copy(self->history, self->recall_pos, self->recall_len, self->buf, self->buf_size);
+    self->cursor = self->len;
+    self->recall = 0;
+
+    // line truncated by smaller buffer needs to be redrawn
+    if (self->len < shown_len)
+        clip_reader_show(self, shown_len, shown_len);
+}
+
+static void clip_reader_list(struct clip_reader *self, const struct clip_candidate *candidates, size_t num, size_t total)
+{
+    clip_reader_echo(self, "\r\n");
+    for (size_t i = 0; i < num; i++) {
+        if (candidates[i].text != NULL) {
+            clip_reader_echo(self, candidates[i].text);
+        } else {
+            clip_reader_echo(self, "<");
+            clip_reader_echo(self, candidates[i].arg->name);
+            clip_reader_echo(self, ":");
+            clip_reader_echo(self, clip_utils_arg_get_type_string(candidates[i].arg->type));
+            clip_reader_echo(self, ">");
+        }
+        clip_reader_echo(self, "  ");
+    }
+    if (total > num)
+        clip_reader_echo(self, "...");
+    clip_reader_echo(self, "\r\n");
+
+    if (self->prompt != NULL)
+        clip_reader_echo(self, self->prompt);
+    clip_reader_echo_bytes(self, self->buf, self->len);
+    clip_reader_echo_left(self, self->len - self->cursor);
+}
+
+static void clip_reader_complete(struct clip_reader *self)
+{
+    struct clip_candidate candidates[CLIP_CONFIG_COMPLETE_LIST_SIZE];
+    struct clip_completion result;
+
+    size_t num = clip_complete_line(self->complete, self->buf, self->cursor, candidates, CLIP_CONFIG_COMPLETE_LIST_SIZE, &result);
+    if (result.num == 0)
+        return;
+
+    const char *text = candidates[0].text;
+    // typed token may be quoted or escaped, then it's replaced by the whole candidate
+    bool plain = (self->cursor - result.token == result.prefix_len);
+
+    if (result.num == 1 && text != NULL) {
+        bool quote = (strchr(text, ' ') != NULL);
+        if (plain && quote == false) {
+            clip_reader_insert_str(self, &text[result.prefix_len], strlen(text) - result.prefix_len);
+        } else {
+            while (self->cursor > result.token)
+                clip_reader_backspace(self);
+            if (quote)
+                clip_reader_insert_str(self, "\"", 1);
+            clip_reader_insert_str(self, text, strlen(text));
+            if (quote)
+                clip_reader_insert_str(self, "\"", 1);
+        }
+        clip_reader_insert_str(self, " ", 1);
+        return;
+    }
+
+    size_t extra = result.common - result.prefix_len;
+    if (text != NULL && plain && extra > 0 && memchr(&text[result.prefix_len], ' ', extra) == NULL) {
+        clip_reader_insert_str(self, &text[result.prefix_len], extra);
+        return;
+    }
+
+    clip_reader_list(self, candidates, num, result.num);
+}
+
+static void clip_reader_key(struct clip_reader *self, char key, char param)
+{
+    if (self->too_long)
+        return;
+
+    if (key == '~') {
+        // "ESC [ n ~" keys (vt220 style)
+        if (param == '1' || param == '7') {
+            key = 'H';
+        } else if (param == '4' || param == '8') {
+            key = 'F';
+        } else if (param == '3') {
+            key = 'P';
+        } else {
+            return;
+        }
+    }
+
+    switch (key) {
+    case 'A':
+        if (CLIP_HISTORY_IS_ENABLED(self))
+            clip_reader_recall(self, self->recall + 1);
+        return;
+    case 'B':
+        if (CLIP_HISTORY_IS_ENABLED(self) && self->recall > 0)
+            clip_reader_recall(self, self->recall - 1);
+        return;
+    default:
+        break;
+    }
+
+    clip_reader_select(self);
+
+    switch (key) {
+    case 'C':
+        if (self->cursor < self->len) {
+            clip_reader_echo_bytes(self, &self->buf[self->cursor], 1);
+            self->cursor++;
+        }
+        break;
+    case 'D':
+        if (self->cursor > 0) {
+            clip_reader_echo_left(self, 1);
+            self->cursor--;
+        }
+        break;
+    case 'H':
+        clip_reader_echo_left(self, self->cursor);
+        self->cursor = 0;
+        break;
+    case 'F':
+        clip_reader_echo_bytes(self, &self->buf[self->cursor], self->len - self->cursor);
+        self->cursor = self->len;
+        break;
+    case 'P':
+        if (self->cursor < self->len)
+            clip_reader_delete(self);
+        break;
+    default:
+        break;
+    }
+}
+
+static bool clip_reader_edit(struct clip_reader *self, char ch)
+{
+    switch (self->esc) {
+    case CLIP_READER_ESC_START:
+        self->esc = (ch == '[' || ch == 'O') ? CLIP_READER_ESC_CSI : CLIP_READER_ESC_NONE;
+        return true;
+
+    case CLIP_READER_ESC_CSI:
+        // parameter bytes (only the first digit is needed), final byte ends the sequence
+        if (ch >= '0' && ch <= '?') {
+            if (self->esc_param == '\0')
+                self->esc_param = ch;
+            return true;
+        }
+        self->esc = CLIP_READER_ESC_NONE;
+        clip_reader_key(self, ch, self->esc_param);
+        return true;
+
+    default:
+        break;
+    }
+
+    if (ch == '\x1B') {
+        self->esc = CLIP_READER_ESC_START;
+        self->esc_param = '\0';
+        return true;
+    }
+
+    if (ch == '\t' && self->complete != NULL) {
+        if (self->too_long == false) {
+            clip_reader_select(self);
+            clip_reader_complete(self);
+        }
+        return true;
+    }
+
+    // every other key works on edited copy of recalled line
+    if (ch != '\r' && ch != '\n' && self->too_long == false)
+        clip_reader_select(self);
+    return false;
+}
+
+void clip_reader_init(struct clip_reader *self, char *buf, size_t buf_size, struct clip_out *echo)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(buf != NULL);
+    CLIP_CONFIG_ASSERT(buf_size > 0);
+
+    memset(self, 0, sizeof(*self));
+    self->buf = buf;
+    self->buf_size = buf_size;
+    self->echo = echo;
+}
+
+void clip_reader_set_history(struct clip_reader *self, struct clip_history *history)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    self->history = history;
+    self->recall = 0;
+}
+
+void clip_reader_set_complete(struct clip_reader *self, const struct clip_complete *complete)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    self->complete = complete;
+}
+
+char* clip_reader_put_char(struct clip_reader *self, char ch)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    bool cr = self->cr;
+    self->cr = (ch == '\r');
+
+    if (ch == '\n' && cr)
+        return NULL;
+
+    if (CLIP_CONFIG_EDITOR_ENABLED && clip_reader_edit(self, ch))
+        return NULL;
+
+    if (ch == '\r' || ch == '\n') {
+        if (CLIP_CONFIG_EDITOR_ENABLED)
+            clip_reader_select(self);
+        clip_reader_echo(self, "\r\n");
+        size_t len = self->len;
+        self->len = 0;
+        self->cursor = 0;
+        if (self->too_long) {
+            self->too_long = false;
+            self->dropped_long++;
+            return NULL;
+        }
+        // empty lines are not dispatched (nothing to call)
+        if (len == 0)
+            return NULL;
+        self->buf[len] = '\0';
+        if (CLIP_HISTORY_IS_ENABLED(self))
+            clip_history_add(self->history, self->buf, len);
+        return self->buf;
+    }
+
+    if (ch == '\b' || ch == '\x7F') {
+        if (self->cursor > 0 && self->too_long == false)
+            clip_reader_backspace(self);
+        return NULL;
+    }
+
+    if ((unsigned char)ch < ' ' && ch != '\t')
+        return NULL;
+
+    if (self->too_long)
+        return NULL;
+
+    if (self->len + 1 >= self->buf_size) {
+        self->too_long = true;
+        return NULL;
+    }
+
+    clip_reader_insert(self, ch);
+    return NULL;
+}
+
+size_t clip_reader_feed(struct clip_reader *self, const struct clip *clip, const char *data, size_t size, struct clip_out *out, void *context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(clip != NULL);
+    CLIP_CONFIG_ASSERT(data != NULL || size == 0);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        char *line = clip_reader_put_char(self, data[i]);
+        if (line == NULL)
+            continue;
+
+        clip_out_flush(self->echo);
+        if (CLIP_CONFIG_PIPELINE_ENABLED) {
+            clip_cmd_parse_pipeline(clip, line, out, context, CLIP_CONFIG_PIPELINE_POLICY, NULL);
+        } else {
+            clip_cmd_parse_line_ex(clip, NULL, line, out, context, NULL);
+        }
+        count++;
+    }
+
+    clip_out_flush(self->echo);
+    return count;
+}
@@ -0,0 +1,207 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+static const char* clip_schema_get_check_string(clip_arg_check_t check)
+{
+    switch (check) {
+    case CLIP_ARG_CHECK_CRC16: return "CRC16";
+    case CLIP_ARG_CHECK_CRC32: return "CRC32";
+    default: return "NONE";
+    }
+}
+
+static size_t clip_schema_count_commands(const struct clip_command **commands)
+{
+    size_t count = 0;
+
+    while (commands != NULL && commands[count] != NULL)
+        count++;
+    return count;
+}
+
+static size_t clip_schema_count_args(const struct clip_arg **args)
+{
+    size_t count = 0;
+
+    while (args != NULL && args[count] != NULL)
+        count++;
+    return count;
+}
+
+static void clip_schema_put_json_str(struct clip_out *out, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+    const char *start = str;
+
+    clip_out_put_str(out, "\"");
+    for (; *str != '\0'; str++) {
+        unsigned char ch = (unsigned char)*str;
+        if (ch >= 0x20 && ch != '\"' && ch != '\\')
+            continue;
+
+        // plain chars are written in chunks, only escaped ones one by one
+        clip_out_put_bytes(out, start, str - start);
+        start = str + 1;
+
+        if (ch == '\"' || ch == '\\') {
+            char esc[2] = {'\\', (char)ch};
+            clip_out_put_bytes(out, esc, sizeof(esc));
+        } else {
+            char esc[6] = {'\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0x0F]};
+            clip_out_put_bytes(out, esc, sizeof(esc));
+        }
+    }
+    clip_out_put_bytes(out, start, str - start);
+    clip_out_put_str(out, "\"");
+}
+
+static void clip_schema_put_json_commands(struct clip_out *out, const struct clip_index *index, const struct clip_command **commands)
+{
+    clip_out_put_str(out, "[");
+    for (const struct clip_command **cmd = commands; *cmd != NULL; cmd++) {
+        if (cmd != commands)
+            clip_out_put_str(out, ",");
+
+        clip_out_put_str(out, "{\"id\":");
+        clip_out_put_u32(out, clip_index_get_id(index, *cmd));
+        clip_out_put_str(out, ",\"name\":");
+        clip_schema_put_json_str(out, (*cmd)->name);
+        if ((*cmd)->description != NULL) {
+            clip_out_put_str(out, ",\"description\":");
+            clip_schema_put_json_str(out, (*cmd)->description);
+        }
+        if ((*cmd)->callback != NULL)
+            clip_out_put_str(out, ",\"callable\":true");
+
+        if (clip_schema_count_args((*cmd)->args) > 0) {
+            clip_out_put_str(out, ",\"args\":[");
+            for (const struct clip_arg **arg = (*cmd)->args; *arg != NULL; arg++) {
+                if (arg != (*cmd)->args)
+                    clip_out_put_str(out, ",");
+
+                clip_out_put_str(out, "{\"name\":");
+                clip_schema_put_json_str(out, (*arg)->name);
+                if ((*arg)->description != NULL) {
+                    clip_out_put_str(out, ",\"description\":");
+                    clip_schema_put_json_str(out, (*arg)->description);
+                }
+                clip_out_put_str(out, ",\"type\":\"");
+                clip_out_put_str(out, clip_utils_arg_get_type_string((*arg)->type));
+                clip_out_put_str(out, (*arg)->optional ? "\",\"optional\":true" : "\"");
+                if ((*arg)->check != CLIP_ARG_CHECK_NONE) {
+                    clip_out_put_str(out, ",\"check\":\"");
+                    clip_out_put_str(out, clip_schema_get_check_string((*arg)->check));
+                    clip_out_put_str(out, "\"");
+                }
+                clip_out_put_str(out, "}");
+            }
+            clip_out_put_str(out, "]");
+        }
+
+        if (clip_schema_count_commands((*cmd)->commands) > 0) {
+            clip_out_put_str(out, ",\"commands\":");
+            clip_schema_put_json_commands(out, index, (*cmd)->commands);
+        }
+        clip_out_put_str(out, "}");
+    }
+    clip_out_put_str(out, "]");
+}
+
+static void clip_schema_put_u16(struct clip_out *out, size_t value)
+{
+    uint8_t buf[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+
+    clip_out_put_bytes(out, buf, sizeof(buf));
+}
+
+static void clip_schema_put_bin_str(struct clip_out *out, const char *str)
+{
+    // zero terminated, NULL string is written as empty one
+    if (str != NULL)
+        clip_out_put_str(out, str);
+    clip_out_put_bytes(out, "", 1);
+}
+
+static void clip_schema_put_bin_commands(struct clip_out *out, const struct clip_index *index, const struct clip_command **commands)
+{
+    clip_schema_put_u16(out, clip_schema_count_commands(commands));
+    if (commands == NULL)
+        return;
+
+    for (const struct clip_command **cmd = commands; *cmd != NULL; cmd++) {
+        clip_schema_put_u16(out, clip_index_get_id(index, *cmd));
+        clip_schema_put_bin_str(out, (*cmd)->name);
+        clip_schema_put_bin_str(out, (*cmd)->description);
+
+        uint8_t flags = ((*cmd)->callback != NULL) ? CLIP_SCHEMA_FLAG_CALLABLE : 0;
+        clip_out_put_bytes(out, &flags, 1);
+
+        clip_schema_put_u16(out, clip_schema_count_args((*cmd)->args));
+        if ((*cmd)->args != NULL) {
+            for (const struct clip_arg **arg = (*cmd)->args; *arg != NULL; arg++) {
+                clip_schema_put_bin_str(out, (*arg)->name);
+                clip_schema_put_bin_str(out, (*arg)->description);
+
+                uint8_t desc[3] = {(uint8_t)(*arg)->type, (uint8_t)(*arg)->check, (*arg)->optional ? CLIP_SCHEMA_FLAG_OPTIONAL : 0};
+                clip_out_put_bytes(out, desc, sizeof(desc));
+            }
+        }
+
+        clip_schema_put_bin_commands(out, index, (*cmd)->commands);
+    }
+}
+
+void clip_schema_put_json(struct clip_out *out, const struct clip_index *index)
+{
+    if (out == NULL)
+        return;
+
+    CLIP_CONFIG_ASSERT(index != NULL);
+    CLIP_CONFIG_ASSERT(index->clip->commands != NULL);
+
+    clip_out_put_str(out, "{\"version\":");
+    clip_out_put_u32(out, CLIP_SCHEMA_VERSION);
+    clip_out_put_str(out, ",\"help\":");
+    clip_schema_put_json_str(out, CLIP_CONFIG_HELP_COMMAND);
+    clip_out_put_str(out, ",\"commands\":");
+    clip_schema_put_json_commands(out, index, index->clip->commands);
+    clip_out_put_str(out, "}");
+}
+
+void clip_schema_put_binary(struct clip_out *out, const struct clip_index *index)
+{
+    if (out == NULL)
+        return;
+
+    CLIP_CONFIG_ASSERT(index != NULL);
+    CLIP_CONFIG_ASSERT(index->clip->commands != NULL);
+
+    uint8_t version = CLIP_SCHEMA_VERSION;
+    clip_out_put_bytes(out, CLIP_SCHEMA_MAGIC, 4);
+    clip_out_put_bytes(out, &version, 1);
+    clip_schema_put_bin_str(out, CLIP_CONFIG_HELP_COMMAND);
+    clip_schema_put_bin_commands(out, index, index->clip->commands);
+}
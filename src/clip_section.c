@@ -0,0 +1,79 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+#if CLIP_CONFIG_SECTION_ENABLED && !defined(__ELF__)
+#error "CLIP_CONFIG_SECTION_ENABLED requires ELF target (section bounds symbols are defined by ELF linkers)"
+#endif
+
+#if CLIP_CONFIG_SECTION_ENABLED && defined(__ELF__)
+
+///< bounds of linker section (defined by linker for sections with C identifier names)
+extern const struct clip_command *__start_clip_commands[];
+extern const struct clip_command *__stop_clip_commands[];
+
+// list terminator (sorted to the end), it also keeps the section defined when no command is registered
+static const struct clip_command *clip_section_end __attribute__((used, section(CLIP_SECTION_NAME))) = NULL;
+
+static int clip_section_compare(const struct clip_command *a, const struct clip_command *b)
+{
+    if (a == NULL || b == NULL)
+        return (a == NULL) - (b == NULL);
+    return strcmp(a->name, b->name);
+}
+
+bool clip_section_init(struct clip *self)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    const struct clip_command **commands = __start_clip_commands;
+    size_t num = __stop_clip_commands - __start_clip_commands;
+    bool unique = true;
+
+    // insertion sort in place (registration order is random, but it's done only once)
+    for (size_t i = 1; i < num; i++) {
+        const struct clip_command *cmd = commands[i];
+        size_t j = i;
+        while (j > 0 && clip_section_compare(commands[j - 1], cmd) > 0) {
+            commands[j] = commands[j - 1];
+            j--;
+        }
+        commands[j] = cmd;
+    }
+
+    for (size_t i = 1; i + 1 < num; i++) {
+        if (clip_section_compare(commands[i - 1], commands[i]) == 0)
+            unique = false;
+    }
+
+    (void)clip_section_end;
+    self->commands = commands;
+    self->commands_num = num - 1;
+    return unique;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+void clip_session_init(struct clip_session *self, const struct clip *clip, char *buf, size_t buf_size, uint8_t *chunk, size_t chunk_size, char *out_buf, size_t out_size, clip_out_sink_t sink, void *context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(clip != NULL);
+
+    self->clip = clip;
+    self->context = context;
+
+    clip_out_init(&self->out, out_buf, out_size, sink, context);
+    clip_stream_init(&self->stream, clip, buf, buf_size, chunk, chunk_size);
+    self->stream.out = &self->out;
+}
+
+void clip_session_feed(struct clip_session *self, const char *data, size_t size)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    clip_stream_feed(&self->stream, data, size, self->context);
+}
+
+clip_status_t clip_session_dispatch(struct clip_session *self, char *cmd_line, struct clip_result *result)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    return clip_cmd_parse_line_ex(self->clip, NULL, cmd_line, &self->out, self->context, result);
+}
@@ -0,0 +1,127 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+///< structure contains counters dump state
+struct clip_stats_dump_context {
+    const struct clip_stats *self;              ///< dumped statistics
+    struct clip_out *out;                       ///< response writer for the dump
+};
+
+static const char *clip_stats_counter_names[CLIP_STATS_COUNTER_NUM] = {
+    [CLIP_STATS_COUNTER_CALLS] = "calls",
+    [CLIP_STATS_COUNTER_ARGUMENTS_ERRORS] = "arg_errors",
+    [CLIP_STATS_COUNTER_NOT_FOUND] = "not_found",
+};
+
+void clip_stats_init(struct clip_stats *self, const struct clip_index *index, struct clip_stats_entry *entries, size_t entries_num)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(index != NULL);
+    CLIP_CONFIG_ASSERT(entries != NULL || entries_num == 0);
+
+    self->index = index;
+    self->entries = entries;
+    self->entries_num = entries_num;
+
+    clip_stats_reset(self);
+}
+
+void clip_stats_reset(struct clip_stats *self)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    if (self->entries_num > 0)
+        memset(self->entries, 0, self->entries_num * sizeof(struct clip_stats_entry));
+}
+
+void clip_stats_inc(struct clip_stats *self, const struct clip_command *cmd, clip_stats_counter_t counter)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(counter < CLIP_STATS_COUNTER_NUM);
+
+    size_t id = clip_index_get_id(self->index, cmd);
+    if (id >= self->entries_num)
+        return;
+
+    uint32_t *value = &self->entries[id].counters[counter];
+    if (*value != UINT32_MAX)
+        (*value)++;
+}
+
+const struct clip_stats_entry* clip_stats_get(const struct clip_stats *self, const struct clip_command *cmd)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    size_t id = clip_index_get_id(self->index, cmd);
+    if (id >= self->entries_num)
+        return NULL;
+
+    return &self->entries[id];
+}
+
+static void clip_stats_dump_entry(const struct clip_index *index, const struct clip_path *path, size_t id, void *context)
+{
+    const struct clip_stats_dump_context *ctx = (const struct clip_stats_dump_context*)context;
+
+    if (id >= ctx->self->entries_num)
+        return;
+
+    const uint32_t *counters = ctx->self->entries[id].counters;
+    bool empty = true;
+    for (size_t i = 0; i < CLIP_STATS_COUNTER_NUM; i++) {
+        if (counters[i] != 0) {
+            empty = false;
+            break;
+        }
+    }
+    if (empty)
+        return;
+
+    clip_out_put_path(ctx->out, path);
+    clip_out_put_str(ctx->out, ":");
+    for (size_t i = 0; i < CLIP_STATS_COUNTER_NUM; i++) {
+        if (counters[i] == 0)
+            continue;
+        clip_out_put_str(ctx->out, " ");
+        clip_out_put_str(ctx->out, clip_stats_counter_names[i]);
+        clip_out_put_str(ctx->out, "=");
+        clip_out_put_u32(ctx->out, counters[i]);
+    }
+    clip_out_put_str(ctx->out, "\n");
+}
+
+void clip_stats_dump(const struct clip_stats *self, struct clip_out *out)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    const struct clip_stats_dump_context ctx = {
+        .self = self,
+        .out = out,
+    };
+    clip_index_walk(self->index, clip_stats_dump_entry, (void*)&ctx);
+}
@@ -0,0 +1,333 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <string.h>
+
+static bool clip_stream_is_leaf(const struct clip_command *cmd)
+{
+    return cmd != NULL && (cmd->commands == NULL || *cmd->commands == NULL);
+}
+
+static bool clip_stream_next_token(const char *buf, size_t len, size_t *pos, size_t *token, size_t *token_len)
+{
+    bool quotemark = false;
+    bool escape = false;
+
+    while (*pos < len && buf[*pos] == ' ')
+        (*pos)++;
+    if (*pos >= len)
+        return false;
+
+    *token = *pos;
+    while (*pos < len) {
+        char ch = buf[*pos];
+        if (quotemark == false && escape == false && ch == ' ')
+            break;
+        if (escape == false && ch == '\\') {
+            escape = true;
+        } else {
+            if (escape == false && ch == '\"')
+                quotemark = !quotemark;
+            escape = false;
+        }
+        (*pos)++;
+    }
+    *token_len = *pos - *token;
+    return true;
+}
+
+static bool clip_stream_find_stream_arg(struct clip_stream *self, size_t *args_offset, size_t *arg_index)
+{
+    const struct clip_command* *commands = self->clip->commands;
+    const struct clip_command *cmd = NULL;
+    size_t pos = 0;
+    size_t token = 0;
+    size_t token_len = 0;
+
+    while (clip_stream_is_leaf(cmd) == false) {
+        if (clip_stream_next_token(self->buf, self->len, &pos, &token, &token_len) == false)
+            return false;
+
+        cmd = NULL;
+        while (*commands != NULL) {
+            if (strncmp(&self->buf[token], (*commands)->name, token_len) == 0 && (*commands)->name[token_len] == '\0') {
+                cmd = *commands;
+                break;
+            }
+            commands++;
+        }
+        if (cmd == NULL)
+            return false;
+        commands = cmd->commands;
+    }
+
+    if (cmd->args == NULL)
+        return false;
+
+    while (pos < self->len && self->buf[pos] == ' ')
+        pos++;
+    *args_offset = pos;
+    *arg_index = 0;
+    while (clip_stream_next_token(self->buf, self->len, &pos, &token, &token_len) != false) {
+        if (cmd->args[*arg_index] == NULL)
+            return false;
+        (*arg_index)++;
+    }
+
+    if (cmd->args[*arg_index] == NULL || cmd->args[*arg_index]->type != CLIP_ARG_TYPE_HEXSTREAM)
+        return false;
+
+    self->cmd = cmd;
+    self->arg = cmd->args[*arg_index];
+    return true;
+}
+
+static void clip_stream_begin(struct clip_stream *self, void *context)
+{
+    size_t args_offset = 0;
+    size_t arg_index = 0;
+    size_t argc = 0;
+    struct clip_arg_value argv[CLIP_CONFIG_ARGS_MAX_NUM] = {0};
+
+    if (clip_stream_find_stream_arg(self, &args_offset, &arg_index) == false)
+        return;
+
+    self->buf[self->len] = '\0';
+    if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_CALL_COMMAND_CALLBACK))
+        clip_notify_event_call_command_callback(self->clip, context, self->cmd, &self->buf[args_offset]);
+
+    clip_arg_error_t error = clip_cmd_call_parse_args(self->cmd, &self->buf[args_offset], &argc, argv);
+    if (error == CLIP_ARG_ERROR_NO_ERROR && argc != arg_index)
+        error = CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS;
+    if (CLIP_TRACE_IS_ENABLED(self->clip))
+        clip_trace_write(self->clip->trace, CLIP_TRACE_EVENT_ARGS, self->cmd, error);
+
+    if (error != CLIP_ARG_ERROR_NO_ERROR) {
+        if (CLIP_STATS_IS_ENABLED(self->clip))
+            clip_stats_inc(self->clip->stats, self->cmd, CLIP_STATS_COUNTER_ARGUMENTS_ERRORS);
+        if (CLIP_EVENT_IS_COMPILED(CLIP_EVENT_ARGUMENTS_ERROR))
+            clip_notify_event_arguments_error(self->clip, context, self->cmd, error);
+        self->state = CLIP_STREAM_STATE_DISCARD;
+        return;
+    }
+
+    self->chunk_len = 0;
+    self->size = 0;
+    self->crc = clip_utils_crc_init(self->arg->check);
+    clip_utils_hex_decoder_reset(&self->decoder);
+    self->state = CLIP_STREAM_STATE_DATA;
+
+    if (CLIP_STATS_IS_ENABLED(self->clip))
+        clip_stats_inc(self->clip->stats, self->cmd, CLIP_STATS_COUNTER_CALLS);
+    if (self->arg->stream != NULL && self->arg->stream->begin != NULL)
+        self->arg->stream->begin(self->clip, self->cmd, argc, argv, self->out, context);
+    if (CLIP_TRACE_IS_ENABLED(self->clip))
+        clip_trace_write(self->clip->trace, CLIP_TRACE_EVENT_CALLBACK, self->cmd, 0);
+}
+
+static void clip_stream_flush(struct clip_stream *self, void *context)
+{
+    if (self->chunk_len == 0)
+        return;
+
+    self->size += self->chunk_len;
+    if (self->arg->stream != NULL && self->arg->stream->data != NULL)
+        self->arg->stream->data(self->clip, self->cmd, self->chunk, self->chunk_len, self->out, context);
+    self->chunk_len = 0;
+}
+
+static void clip_stream_end(struct clip_stream *self, clip_arg_error_t error, void *context)
+{
+    if (error == CLIP_ARG_ERROR_NO_ERROR) {
+        clip_stream_flush(self, context);
+    } else {
+        self->chunk_len = 0;
+    }
+
+    if (self->arg->stream != NULL && self->arg->stream->end != NULL)
+        self->arg->stream->end(self->clip, self->cmd, self->size, error, self->out, context);
+    clip_out_flush(self->out);
+}
+
+static void clip_stream_check(struct clip_stream *self, void *context)
+{
+    char *arg = NULL;
+    struct clip_arg_value av = {0};
+    clip_arg_error_t error = CLIP_ARG_ERROR_NO_ERROR;
+
+    self->buf[self->len] = '\0';
+    clip_utils_arg_get_first(&arg, self->buf);
+    if (*arg == '\0') {
+        error = CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS;
+    } else if (clip_utils_parse_uint(&av, arg) == false) {
+        error = CLIP_ARG_ERROR_PARSE_UINT;
+    } else if (av.val_uint != clip_utils_crc_final(self->arg->check, self->crc)) {
+        error = CLIP_ARG_ERROR_CHECKSUM;
+    }
+    clip_stream_end(self, error, context);
+}
+
+static void clip_stream_reset(struct clip_stream *self)
+{
+    self->len = 0;
+    self->quotemark = false;
+    self->escape = false;
+    self->pipelined = false;
+    self->state = CLIP_STREAM_STATE_LINE;
+}
+
+static void clip_stream_feed_line(struct clip_stream *self, const char ch, void *context)
+{
+    if (ch == '\n') {
+        self->buf[self->len] = '\0';
+        if (self->len > 0 && CLIP_CONFIG_PIPELINE_ENABLED) {
+            clip_cmd_parse_pipeline(self->clip, self->buf, self->out, context, CLIP_CONFIG_PIPELINE_POLICY, NULL);
+        } else if (self->len > 0) {
+            clip_cmd_parse_line_ex(self->clip, NULL, self->buf, self->out, context, NULL);
+        }
+        clip_stream_reset(self);
+        return;
+    }
+
+    if (CLIP_CONFIG_PIPELINE_ENABLED && self->quotemark == false && self->escape == false && ch == CLIP_CONFIG_PIPELINE_SEPARATOR)
+        self->pipelined = true;
+
+    if (self->pipelined == false && self->quotemark == false && self->escape == false && ch == ' ') {
+        clip_stream_begin(self, context);
+        if (self->state != CLIP_STREAM_STATE_LINE)
+            return;
+    }
+
+    if (self->escape == false && ch == '\\') {
+        self->escape = true;
+    } else {
+        if (self->escape == false && ch == '\"')
+            self->quotemark = !self->quotemark;
+        self->escape = false;
+    }
+
+    if (self->len + 1 >= self->buf_size) {
+        self->state = CLIP_STREAM_STATE_DISCARD;
+        return;
+    }
+    self->buf[self->len++] = ch;
+}
+
+static void clip_stream_feed_tail(struct clip_stream *self, const char ch, void *context)
+{
+    if (ch == '\n') {
+        if (self->state == CLIP_STREAM_STATE_TAIL)
+            clip_stream_check(self, context);
+        clip_stream_reset(self);
+        return;
+    }
+
+    if (self->state == CLIP_STREAM_STATE_TAIL && self->len + 1 < self->buf_size)
+        self->buf[self->len++] = ch;
+}
+
+static void clip_stream_feed_data(struct clip_stream *self, const char ch, void *context)
+{
+    // repeated spaces before data are skipped (like in "clip_utils_arg_get_first")
+    if (ch == ' ' && self->size == 0 && self->chunk_len == 0 && self->decoder.half == false)
+        return;
+
+    if (ch == ' ' || ch == '\n') {
+        if (self->decoder.half != false) {
+            clip_stream_end(self, CLIP_ARG_ERROR_PARSE_HEXARRAY, context);
+            self->state = CLIP_STREAM_STATE_DISCARD;
+        } else if (self->arg->check == CLIP_ARG_CHECK_NONE) {
+            clip_stream_end(self, CLIP_ARG_ERROR_NO_ERROR, context);
+            self->state = CLIP_STREAM_STATE_DISCARD;
+        } else {
+            clip_stream_flush(self, context);
+            self->len = 0;
+            self->state = CLIP_STREAM_STATE_TAIL;
+        }
+        if (ch == '\n')
+            clip_stream_feed_tail(self, ch, context);
+        return;
+    }
+
+    size_t chunk_len = self->chunk_len;
+    if (clip_utils_hex_decoder_feed(&self->decoder, self->chunk, &self->chunk_len, ch) == false) {
+        clip_stream_end(self, CLIP_ARG_ERROR_PARSE_HEXARRAY, context);
+        self->state = CLIP_STREAM_STATE_DISCARD;
+        return;
+    }
+
+    if (self->chunk_len != chunk_len)
+        self->crc = clip_utils_crc_update(self->arg->check, self->crc, self->chunk[chunk_len]);
+
+    if (self->chunk_len >= self->chunk_size)
+        clip_stream_flush(self, context);
+}
+
+void clip_stream_init(struct clip_stream *self, const struct clip *clip, char *buf, size_t buf_size, uint8_t *chunk, size_t chunk_size)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(clip != NULL);
+    CLIP_CONFIG_ASSERT(buf != NULL);
+    CLIP_CONFIG_ASSERT(buf_size > 0);
+    CLIP_CONFIG_ASSERT(chunk != NULL);
+    CLIP_CONFIG_ASSERT(chunk_size > 0);
+
+    memset(self, 0, sizeof(*self));
+    self->clip = clip;
+    self->buf = buf;
+    self->buf_size = buf_size;
+    self->chunk = chunk;
+    self->chunk_size = chunk_size;
+    clip_stream_reset(self);
+}
+
+void clip_stream_feed(struct clip_stream *self, const char *data, size_t size, void *context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(data != NULL);
+
+    while (size-- > 0) {
+        char ch = *data++;
+        if (ch == '\r')
+            continue;
+
+        switch (self->state) {
+        case CLIP_STREAM_STATE_LINE:
+            clip_stream_feed_line(self, ch, context);
+            break;
+
+        case CLIP_STREAM_STATE_DATA:
+            clip_stream_feed_data(self, ch, context);
+            break;
+
+        case CLIP_STREAM_STATE_TAIL:
+        case CLIP_STREAM_STATE_DISCARD:
+        default:
+            clip_stream_feed_tail(self, ch, context);
+            break;
+        }
+    }
+}
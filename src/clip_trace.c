@@ -0,0 +1,143 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+#include <stdatomic.h>
+
+static void clip_trace_put_le(struct clip_out *out, uint32_t value, size_t size)
+{
+    uint8_t buf[4];
+
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = (uint8_t)value;
+        value >>= 8;
+    }
+    clip_out_put_bytes(out, buf, size);
+}
+
+struct clip_trace_names {
+    struct clip_out *out;
+    size_t count;
+};
+
+static void clip_trace_dump_name(const struct clip_index *index, const struct clip_path *path, size_t id, void *context)
+{
+    struct clip_trace_names *names = (struct clip_trace_names*)context;
+
+    // names table is indexed by ID (shared command is walked once per parent, not indexed command has no ID)
+    if (id != names->count)
+        return;
+
+    if (names->out != NULL) {
+        clip_out_put_path(names->out, path);
+        clip_out_put_bytes(names->out, "", 1);
+    }
+    names->count++;
+}
+
+void clip_trace_init(struct clip_trace *self, const struct clip_index *index, struct clip_trace_record *records, size_t size, clip_trace_time_t time, void *time_context)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(index != NULL);
+    CLIP_CONFIG_ASSERT(records != NULL);
+    CLIP_CONFIG_ASSERT(size > 0 && (size & (size - 1)) == 0);
+    CLIP_CONFIG_ASSERT(time != NULL);
+
+    self->index = index;
+    self->records = records;
+    self->size = size;
+    self->head = 0;
+    self->time = time;
+    self->time_context = time_context;
+}
+
+void clip_trace_write(struct clip_trace *self, clip_trace_event_t event, const struct clip_command *cmd, int32_t code)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    uint32_t head = self->head;
+    struct clip_trace_record *record = &self->records[head & (self->size - 1)];
+
+    record->timestamp = self->time(self->time_context);
+    record->code = code;
+    record->id = (uint16_t)clip_index_get_id(self->index, cmd);
+    record->event = (uint8_t)event;
+    record->reserved = 0;
+
+    // record is published after it is completely written
+    CLIP_CONFIG_QUEUE_FENCE();
+    self->head = head + 1;
+}
+
+size_t clip_trace_read(const struct clip_trace *self, struct clip_trace_record *records, size_t max)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+    CLIP_CONFIG_ASSERT(records != NULL || max == 0);
+
+    uint32_t head = self->head;
+    CLIP_CONFIG_QUEUE_FENCE();
+    size_t count = (head < self->size) ? head : self->size;
+    if (count > max)
+        count = max;
+
+    for (size_t i = 0; i < count; i++)
+        records[i] = self->records[(head - count + i) & (self->size - 1)];
+    return count;
+}
+
+void clip_trace_dump(const struct clip_trace *self, struct clip_out *out)
+{
+    CLIP_CONFIG_ASSERT(self != NULL);
+
+    uint32_t head = self->head;
+    CLIP_CONFIG_QUEUE_FENCE();
+    size_t count = (head < self->size) ? head : self->size;
+    struct clip_trace_names names = {
+        .out = NULL,
+        .count = 0,
+    };
+
+    // names are counted first, table length precedes them
+    clip_index_walk(self->index, clip_trace_dump_name, &names);
+
+    clip_out_put_bytes(out, CLIP_TRACE_DUMP_MAGIC, 4);
+    clip_trace_put_le(out, CLIP_TRACE_DUMP_VERSION, 1);
+    clip_trace_put_le(out, sizeof(struct clip_trace_record), 1);
+    clip_trace_put_le(out, names.count, 2);
+    clip_trace_put_le(out, count, 4);
+
+    names.out = out;
+    names.count = 0;
+    clip_index_walk(self->index, clip_trace_dump_name, &names);
+
+    for (size_t i = 0; i < count; i++) {
+        const struct clip_trace_record *record = &self->records[(head - count + i) & (self->size - 1)];
+        clip_trace_put_le(out, record->timestamp, 4);
+        clip_trace_put_le(out, (uint32_t)record->code, 4);
+        clip_trace_put_le(out, record->id, 2);
+        clip_trace_put_le(out, record->event, 1);
+        clip_trace_put_le(out, record->reserved, 1);
+    }
+}
@@ -27,6 +27,9 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
+
+#include "clip_config.h"
 
 ///< forward declaration of main clip structure
 struct clip;
@@ -43,6 +46,7 @@ typedef enum {
     CLIP_EVENT_COMMAND_NOT_FOUND,       ///< event for notifing unsupported command
     CLIP_EVENT_ARGUMENTS_ERROR,         ///< event for notifing command arguments error
     CLIP_EVENT_CALL_COMMAND_CALLBACK,   ///< event for notifing command call
+    CLIP_EVENT_COMMAND_COMPLETE,        ///< event for notifing pending command completion
 } clip_event_t;
 
 ///< enum contains argument value types
@@ -53,8 +57,27 @@ typedef enum {
     CLIP_ARG_TYPE_UINT,                 ///< unsigned integer (uint32_t)
     CLIP_ARG_TYPE_FLOAT,                ///< float number (float)
     CLIP_ARG_TYPE_HEXARRAY,             ///< array of bytes (ascii hex encoded)
+    CLIP_ARG_TYPE_HEXSTREAM,            ///< array of bytes delivered in chunks (ascii hex encoded, must be last)
 } clip_arg_type_t;
 
+///< enum contains command line stream reader states
+typedef enum {
+    CLIP_STREAM_STATE_LINE,             ///< collecting command line in buffer
+    CLIP_STREAM_STATE_DATA,             ///< decoding streamed argument data
+    CLIP_STREAM_STATE_TAIL,             ///< streamed argument finished, collecting its checksum until end of line
+    CLIP_STREAM_STATE_DISCARD,          ///< line rejected, discarding chars until end of line
+} clip_stream_state_t;
+
+///< enum contains lines queue producer states
+typedef enum {
+    CLIP_QUEUE_STATE_LINE,              ///< collecting line in free slot
+    CLIP_QUEUE_STATE_FULL,              ///< line dropped (all slots were taken), discarding chars until end of line
+    CLIP_QUEUE_STATE_TOO_LONG,          ///< line dropped (it doesn't fit in slot), discarding chars until end of line
+} clip_queue_state_t;
+
+///< type of lines queue indexes (single byte is read and written with one access on every target, 8-bit MCU too)
+typedef uint8_t clip_queue_index_t;
+
 ///< enum contains argument error type
 typedef enum {
     CLIP_ARG_ERROR_NO_ERROR,                ///< no error
@@ -64,14 +87,80 @@ typedef enum {
     CLIP_ARG_ERROR_PARSE_UINT,              ///< unsigned integer parsing error
     CLIP_ARG_ERROR_PARSE_FLOAT,             ///< float number parsing error
     CLIP_ARG_ERROR_PARSE_HEXARRAY,          ///< ascii hex array parsing error
+    CLIP_ARG_ERROR_CHECKSUM,                ///< binary data checksum mismatch
+    CLIP_ARG_ERROR_TYPE_MISMATCH,           ///< argument type doesn't match descriptor (binary frames)
 } clip_arg_error_t;
 
+///< enum contains command line dispatch status
+typedef enum {
+    CLIP_STATUS_OK,                         ///< command called (and returned 0)
+    CLIP_STATUS_HELP,                       ///< help command called
+    CLIP_STATUS_COMMAND_NOT_FOUND,          ///< command not found
+    CLIP_STATUS_ARGUMENTS_ERROR,            ///< command arguments error
+    CLIP_STATUS_COMMAND_ERROR,              ///< command called and returned non-zero code
+    CLIP_STATUS_PENDING,                    ///< command called and returned CLIP_COMMAND_PENDING (completed later)
+    CLIP_STATUS_BOUND,                      ///< command and its arguments bound, but not called yet (see clip_cmd_bind)
+} clip_status_t;
+
+///< enum contains error policy of pipelined command line (commands separated by CLIP_CONFIG_PIPELINE_SEPARATOR)
+typedef enum {
+    CLIP_PIPELINE_STOP_ON_ERROR,            ///< commands following the first failed one are skipped
+    CLIP_PIPELINE_CONTINUE,                 ///< all commands are called, regardless of errors
+} clip_pipeline_policy_t;
+
+///< enum contains binary argument integrity check types
+typedef enum {
+    CLIP_ARG_CHECK_NONE,                    ///< no integrity check
+    CLIP_ARG_CHECK_CRC16,                   ///< CRC-16/CCITT-FALSE of data in the next (UINT) argument
+    CLIP_ARG_CHECK_CRC32,                   ///< CRC-32 (IEEE 802.3) of data in the next (UINT) argument
+} clip_arg_check_t;
+
+///< enum contains command dispatch stages measured by profiler
+typedef enum {
+    CLIP_PROFILE_STAGE_TOKENIZE,            ///< splitting command name from command line (measured per tree node)
+    CLIP_PROFILE_STAGE_LOOKUP,              ///< searching command name in subcommands list (measured per tree node)
+    CLIP_PROFILE_STAGE_ARGS,                ///< parsing command arguments
+    CLIP_PROFILE_STAGE_CALLBACK,            ///< command callback (or stream begin callback)
+    CLIP_PROFILE_STAGE_NUM,                 ///< number of stages
+} clip_profile_stage_t;
+
+///< enum contains per-command statistics counters
+typedef enum {
+    CLIP_STATS_COUNTER_CALLS,               ///< command callback calls (or streamed argument starts)
+    CLIP_STATS_COUNTER_ARGUMENTS_ERRORS,    ///< rejected command arguments
+    CLIP_STATS_COUNTER_NOT_FOUND,           ///< not found subcommands (counted for parent node, root for first level)
+    CLIP_STATS_COUNTER_NUM,                 ///< number of counters
+} clip_stats_counter_t;
+
+///< enum contains trace record types
+typedef enum {
+    CLIP_TRACE_EVENT_LINE,                  ///< command line dispatch started (root ID)
+    CLIP_TRACE_EVENT_LOOKUP,                ///< command found (found command ID)
+    CLIP_TRACE_EVENT_NOT_FOUND,             ///< command not found (parent command ID)
+    CLIP_TRACE_EVENT_HELP,                  ///< help command called (parent command ID)
+    CLIP_TRACE_EVENT_ARGS,                  ///< command arguments parsed (code is clip_arg_error_t)
+    CLIP_TRACE_EVENT_CALLBACK,              ///< command callback returned (code is returned value)
+    CLIP_TRACE_EVENT_DONE,                  ///< command line dispatch finished (code is clip_status_t)
+    CLIP_TRACE_EVENT_COMPLETE,              ///< pending command completed (code is completion code)
+} clip_trace_event_t;
+
+///< forward declaration for clip streamed argument callbacks structure
+struct clip_arg_stream;
+
 ///< structure contains argument descriptor (may by const and static)
 struct clip_arg {
     const char *name;                   ///< argument name
     const char *description;            ///< argument description (not used internally)
     clip_arg_type_t type;               ///< argument value type
     bool optional;                      ///< optional argument flag
+    const struct clip_arg_stream *stream;   ///< streamed data callbacks (only for CLIP_ARG_TYPE_HEXSTREAM)
+    clip_arg_check_t check;             ///< integrity check of binary data (only for CLIP_ARG_TYPE_HEXARRAY and CLIP_ARG_TYPE_HEXSTREAM)
+};
+
+///< structure contains state of incremental ascii hex decoder
+struct clip_hex_decoder {
+    uint8_t value;                      ///< upper nibble of currently decoded byte
+    bool half;                          ///< flag set when upper nibble is already decoded
 };
 
 ///< structure contains parsed argument value in union format
@@ -105,19 +194,91 @@ union clip_event_arg {
         const struct clip_command *cmd;             ///< pointer to command which was called
         const char *cmd_line;                       ///< command line used as a command arguments (not parsed yet)
     } call_command_callback;                        ///< structure with arguments for CLIP_EVENT_CALL_COMMAND_CALLBACK
+    struct {
+        const struct clip_command *cmd;             ///< pointer to command which was pending
+        int code;                                   ///< completion code (0 - success)
+    } command_complete;                             ///< structure with arguments for CLIP_EVENT_COMMAND_COMPLETE
 };
 
-///< alias for function pointer with command call callback (fired on successully parsed arguments)
-typedef void (*clip_command_callback_t)(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context);
+///< structure contains command line dispatch result
+struct clip_result {
+    clip_status_t status;                   ///< dispatch status
+    const struct clip_command *cmd;         ///< command which finished dispatch (called command, or parent of not found command, NULL for root)
+    clip_arg_error_t error;                 ///< argument error (for CLIP_STATUS_ARGUMENTS_ERROR)
+    int code;                               ///< code returned by command callback (0 - success)
+    const char *token;                      ///< token at which dispatch stopped (not found command name or wrong argument, may be NULL)
+    size_t offset;                          ///< offset of token in command line passed to "clip_cmd_parse_line_ex" (or "clip_cmd_parse_pipeline")
+};
+
+///< forward declaration for response writer structure
+struct clip_out;
+
+///< alias for function pointer with command call callback (fired on successully parsed arguments, returns 0 on success)
+typedef int (*clip_command_callback_t)(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
 
 ///< alias for function pointer with event call callback (fired on events)
 typedef void (*clip_event_callback_t)(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context);
 
+///< alias for function pointer with stream begin callback (fired when arguments before streamed argument are parsed)
+typedef void (*clip_stream_begin_callback_t)(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
+
+///< alias for function pointer with stream data callback (fired on every decoded chunk of streamed argument)
+typedef void (*clip_stream_data_callback_t)(const struct clip *self, const struct clip_command *cmd, const uint8_t *data, size_t size, struct clip_out *out, void *context);
+
+///< alias for function pointer with stream end callback (fired when streamed argument is finished or broken)
+typedef void (*clip_stream_end_callback_t)(const struct clip *self, const struct clip_command *cmd, size_t size, clip_arg_error_t error, struct clip_out *out, void *context);
+
+///< structure contains streamed argument callbacks (may be const and static)
+struct clip_arg_stream {
+    clip_stream_begin_callback_t begin;     ///< called once, before first data chunk
+    clip_stream_data_callback_t data;       ///< called for every decoded data chunk
+    clip_stream_end_callback_t end;         ///< called once, after last data chunk (with total size and error status)
+};
+
+///< alias for function pointer with CLIP_EVENT_HELP handler
+typedef void (*clip_event_help_callback_t)(const struct clip *self, const struct clip_command *cmd, const struct clip_command **commands, void *context);
+
+///< alias for function pointer with CLIP_EVENT_COMMAND_NOT_FOUND handler
+typedef void (*clip_event_command_not_found_callback_t)(const struct clip *self, const struct clip_command *cmd, const char *cmd_name, void *context);
+
+///< alias for function pointer with CLIP_EVENT_ARGUMENTS_ERROR handler
+typedef void (*clip_event_arguments_error_callback_t)(const struct clip *self, const struct clip_command *cmd, clip_arg_error_t error, void *context);
+
+///< alias for function pointer with CLIP_EVENT_CALL_COMMAND_CALLBACK handler
+typedef void (*clip_event_call_command_callback_t)(const struct clip *self, const struct clip_command *cmd, const char *cmd_line, void *context);
+
+///< alias for function pointer with CLIP_EVENT_COMMAND_COMPLETE handler
+typedef void (*clip_event_command_complete_callback_t)(const struct clip *self, const struct clip_command *cmd, int code, void *context);
+
+///< structure contains per-event handlers (may be const and static, NULL handler falls back to generic event callback)
+struct clip_event_handlers {
+    clip_event_help_callback_t help;                                    ///< CLIP_EVENT_HELP handler
+    clip_event_command_not_found_callback_t command_not_found;          ///< CLIP_EVENT_COMMAND_NOT_FOUND handler
+    clip_event_arguments_error_callback_t arguments_error;              ///< CLIP_EVENT_ARGUMENTS_ERROR handler
+    clip_event_call_command_callback_t call_command_callback;           ///< CLIP_EVENT_CALL_COMMAND_CALLBACK handler
+    clip_event_command_complete_callback_t command_complete;            ///< CLIP_EVENT_COMMAND_COMPLETE handler
+};
+
+///< forward declaration for latency profiler structure
+struct clip_profile;
+
+///< forward declaration for statistics counters structure
+struct clip_stats;
+
+///< forward declaration for trace ring buffer structure
+struct clip_trace;
+
 ///< structure contains root clip handler descriptor (may be const and static)
 struct clip {
     void *context;                          ///< generic pointer used as global context (accessible in all callbacks)
     clip_event_callback_t event_callback;   ///< pointer to event callback function
     const struct clip_command **commands;   ///< list of root commands (last item is NULL)
+    uint32_t event_mask;                    ///< masked out (not notified) events, see CLIP_EVENT_MASK (0 - all events notified)
+    const struct clip_event_handlers *event_handlers;   ///< optional per-event handlers (may be NULL)
+    struct clip_profile *profile;           ///< optional latency profiler (may be NULL, used only with CLIP_CONFIG_PROFILE_ENABLED)
+    struct clip_stats *stats;               ///< optional statistics counters (may be NULL, used only with CLIP_CONFIG_STATS_ENABLED)
+    struct clip_trace *trace;               ///< optional trace ring buffer (may be NULL, used only with CLIP_CONFIG_TRACE_ENABLED)
+    size_t commands_num;                    ///< number of root commands if list is sorted by names (binary search lookup, 0 - linear search)
 };
 
 ///< structure contains command/subcommand descriptor (may be const and static)
@@ -128,6 +289,268 @@ struct clip_command {
     clip_command_callback_t callback;       ///< command call callback function pointer
     const struct clip_command **commands;   ///< list of optional subcommands (may be NULL or last item is NULL)
     const struct clip_arg **args;           ///< list of optional arguments (may be NULL or last item is NULL)
+    const char *usage;                      ///< optional precomputed usage string (may be NULL, generated on demand then)
+    size_t commands_num;                    ///< number of subcommands if list is sorted by names (binary search lookup, 0 - linear search)
+};
+
+///< structure contains command line stream reader (must be mutable, one per input source)
+struct clip_stream {
+    const struct clip *clip;                ///< pointer to root clip handler
+    char *buf;                              ///< buffer for command line (or its head, before streamed argument)
+    size_t buf_size;                        ///< size of command line buffer
+    size_t len;                             ///< number of chars stored in command line buffer
+    uint8_t *chunk;                         ///< buffer for decoded streamed argument data
+    size_t chunk_size;                      ///< size of decoded data buffer (maximum chunk size)
+    size_t chunk_len;                       ///< number of bytes stored in decoded data buffer
+    size_t size;                            ///< total number of decoded bytes of current streamed argument
+    clip_stream_state_t state;              ///< current reader state
+    bool quotemark;                         ///< quotemark tracking (for finding arguments boundaries)
+    bool escape;                            ///< escape char tracking (for finding arguments boundaries)
+    bool pipelined;                         ///< line contains commands separator (streamed arguments are not supported then)
+    const struct clip_command *cmd;         ///< command which receives streamed argument
+    const struct clip_arg *arg;             ///< streamed argument descriptor
+    struct clip_hex_decoder decoder;        ///< incremental ascii hex decoder
+    uint32_t crc;                           ///< integrity check value of streamed data (computed while decoding)
+    struct clip_out *out;                   ///< optional response writer passed to callbacks (NULL after init, may be set by user)
+};
+
+///< alias for function pointer with response writer sink (fired when buffered response is flushed)
+typedef void (*clip_out_sink_t)(struct clip_out *self, const char *data, size_t size);
+
+///< structure contains buffered response writer (must be mutable, one per output session)
+struct clip_out {
+    char *buf;                              ///< buffer for response data (may be NULL for unbuffered writer)
+    size_t buf_size;                        ///< size of response buffer
+    size_t len;                             ///< number of chars stored in response buffer
+    clip_out_sink_t sink;                   ///< output sink (may be NULL)
+    void *context;                          ///< generic pointer for sink usage
+};
+
+///< structure contains pending command completion token (must be mutable, owned by user, one per pending operation)
+struct clip_pending {
+    const struct clip *clip;                ///< pointer to root clip handler (NULL when nothing is pending)
+    const struct clip_command *cmd;         ///< pending command
+    struct clip_out *out;                   ///< response writer used for completion response (may be NULL)
+    void *context;                          ///< generic pointer passed to completion event
+};
+
+///< structure contains single command index slot
+struct clip_index_entry {
+    const struct clip_command *cmd;         ///< indexed command (NULL for free slot)
+    size_t id;                              ///< command ID (commands tree order, 0 is reserved for root)
+};
+
+///< structure contains commands index, which maps const command descriptors to IDs (must be mutable, may be shared)
+struct clip_index {
+    const struct clip *clip;                ///< pointer to indexed root clip handler
+    struct clip_index_entry *entries;       ///< hash table of indexed commands
+    size_t size;                            ///< number of hash table slots (must be bigger than number of commands)
+    size_t count;                           ///< number of assigned IDs (commands and root)
+};
+
+///< structure contains command path (linked from command to its parent, usually allocated on stack while walking commands tree)
+struct clip_path {
+    const struct clip_command *cmd;         ///< command (NULL for root)
+    const struct clip_path *parent;         ///< parent command path (NULL for root and root commands)
+};
+
+///< alias for function pointer with commands index visitor (called for root and every indexed command)
+typedef void (*clip_index_visitor_t)(const struct clip_index *index, const struct clip_path *path, size_t id, void *context);
+
+///< alias for function pointer with profiler time source (returns free running cycles or time ticks counter)
+typedef uint32_t (*clip_profile_time_t)(void *context);
+
+///< structure contains latency histograms of single command (log2 buckets, bucket 0 for 0 ticks, bucket N for 2^(N-1)..2^N-1 ticks)
+struct clip_profile_entry {
+    uint32_t buckets[CLIP_PROFILE_STAGE_NUM][CLIP_CONFIG_PROFILE_BUCKETS];  ///< number of samples in every bucket (saturated)
+};
+
+///< structure contains latency profiler (must be mutable)
+struct clip_profile {
+    const struct clip_index *index;         ///< commands index (maps commands to histograms table)
+    struct clip_profile_entry *entries;     ///< histograms table (indexed by command ID)
+    size_t entries_num;                     ///< number of histograms table entries (commands with bigger ID are not profiled)
+    clip_profile_time_t time;               ///< time source
+    void *time_context;                     ///< generic pointer for time source usage
+};
+
+///< structure contains statistics counters of single command
+struct clip_stats_entry {
+    uint32_t counters[CLIP_STATS_COUNTER_NUM];  ///< counters values (saturated)
+};
+
+///< structure contains statistics counters (must be mutable)
+struct clip_stats {
+    const struct clip_index *index;         ///< commands index (maps commands to counters table)
+    struct clip_stats_entry *entries;       ///< counters table (indexed by command ID)
+    size_t entries_num;                     ///< number of counters table entries (commands with bigger ID are not counted)
+};
+
+///< structure contains single trace record (fixed size, 12 bytes)
+struct clip_trace_record {
+    uint32_t timestamp;                     ///< time source ticks
+    int32_t code;                           ///< event specific code (error, status or callback return value)
+    uint16_t id;                            ///< command ID (0xFFFF for not indexed command)
+    uint8_t event;                          ///< record type (clip_trace_event_t)
+    uint8_t reserved;                       ///< reserved (0)
+};
+
+///< alias for function pointer with trace time source (returns free running cycles or time ticks counter)
+typedef uint32_t (*clip_trace_time_t)(void *context);
+
+///< structure contains trace ring buffer (must be mutable, single writer - dispatch context, oldest records are overwritten)
+struct clip_trace {
+    const struct clip_index *index;         ///< commands index (maps commands to IDs stored in records)
+    struct clip_trace_record *records;      ///< records buffer
+    size_t size;                            ///< number of records in buffer (must be power of 2)
+    volatile uint32_t head;                 ///< number of written records (free running, published after record is written)
+    clip_trace_time_t time;                 ///< time source
+    void *time_context;                     ///< generic pointer for time source usage
+};
+
+///< structure contains parsed command ready to be called later, possibly from other thread (see clip_cmd_bind)
+struct clip_bound_command {
+    const struct clip *clip;                ///< root clip handler
+    const struct clip_command *cmd;         ///< command to call
+    void *context;                          ///< context passed to command callback
+    size_t argc;                            ///< number of parsed arguments
+    size_t stream_index;                    ///< index of streamed argument (equal to argc if there is none)
+    struct clip_arg_value argv[CLIP_CONFIG_ARGS_MAX_NUM];   ///< parsed arguments values (pointing into bound command line)
+};
+
+///< structure contains summary of batch execution (see clip_batch_run)
+struct clip_batch_result {
+    size_t lines;                           ///< number of dispatched lines (empty and comment lines are not counted)
+    size_t errors;                          ///< number of failed lines
+    size_t error_line;                      ///< number of the first failed line (counted from 1, 0 if there was no error)
+    size_t size;                            ///< number of processed script bytes (smaller than script size if batch was stopped)
+};
+
+///< alias for function pointer with batch line report (called after every dispatched line, e.g. for per-command counters)
+typedef void (*clip_batch_report_t)(const struct clip *self, size_t line_no, const struct clip_result *result, void *context);
+
+///< structure contains lock-free single-producer/single-consumer lines queue (e.g. UART interrupt -> main loop)
+struct clip_queue {
+    char *buf;                              ///< slots buffer (slots_num * slot_size bytes)
+    size_t slot_size;                       ///< size of single slot (longest accepted line + 1)
+    size_t slots_num;                       ///< number of slots (must be power of 2, not greater than CLIP_QUEUE_SLOTS_MAX_NUM)
+    volatile clip_queue_index_t head;       ///< number of pushed lines (free running modulo 256, written only by producer)
+    volatile clip_queue_index_t tail;       ///< number of dispatched lines (free running modulo 256, written only by consumer)
+    size_t len;                             ///< length of line being received (producer)
+    clip_queue_state_t state;               ///< producer state
+    volatile uint32_t dropped_full;         ///< number of lines dropped because all slots were taken (more slots needed)
+    volatile uint32_t dropped_long;         ///< number of lines dropped because they didn't fit in slot (bigger slots needed)
+    volatile size_t max_depth;              ///< maximum number of lines waiting for dispatch (slots really used)
+    volatile size_t max_len;                ///< length of the longest received line (slot size really needed - 1)
+};
+
+///< enum contains type of completion candidate
+typedef enum {
+    CLIP_CANDIDATE_COMMAND,                 ///< subcommand name
+    CLIP_CANDIDATE_KEYWORD,                 ///< argument value keyword (e.g. "0" and "1" of bool argument)
+    CLIP_CANDIDATE_ARGUMENT,                ///< argument hint (name and type, there is no text to insert)
+} clip_candidate_type_t;
+
+///< enum contains state of escape sequences parser of line editor (e.g. "ESC [ A" sent by up arrow key)
+typedef enum {
+    CLIP_READER_ESC_NONE,                   ///< no escape sequence
+    CLIP_READER_ESC_START,                  ///< ESC received
+    CLIP_READER_ESC_CSI,                    ///< ESC and '[' (or 'O') received, waiting for parameter or final char
+} clip_reader_esc_t;
+
+///< structure contains sorted subcommands list range of single command
+struct clip_complete_range {
+    size_t first;                           ///< index of the first subcommand in sorted names table
+    size_t num;                             ///< number of subcommands (0 for command without subcommands)
+    const struct clip_command **list;       ///< source list starting with this command (recorded on first visit of the list)
+    size_t owner;                           ///< ID of command which range describes sorted "list"
+};
+
+///< structure contains completion index (every subcommands list sorted by names, for binary search of prefixes)
+struct clip_complete {
+    const struct clip_index *index;         ///< commands index (maps commands to ranges table)
+    const struct clip_command **names;      ///< sorted names table (all subcommands lists, one after another)
+    size_t names_size;                      ///< size of sorted names table (sum of distinct subcommands lists lengths)
+    struct clip_complete_range *ranges;     ///< subcommands list ranges table (indexed by command ID, 0 is root)
+    size_t ranges_num;                      ///< number of ranges table entries (usually index "count")
+};
+
+///< structure contains single completion candidate
+struct clip_candidate {
+    clip_candidate_type_t type;             ///< candidate type
+    const char *text;                       ///< candidate text (command name or keyword, NULL for argument hint)
+    const struct clip_command *cmd;         ///< candidate command (or command which owns completed argument)
+    const struct clip_arg *arg;             ///< completed argument (NULL for command candidate)
+};
+
+///< structure contains summary of line completion
+struct clip_completion {
+    size_t token;                           ///< offset of completed (last) token in line
+    size_t prefix_len;                      ///< length of already typed part of completed token (without quotemarks and escapes)
+    bool quoted;                            ///< completed token is inside open quotemark
+    size_t num;                             ///< total number of candidates (may be bigger than candidates table size)
+    size_t common;                          ///< length of common part of all candidates texts (at least prefix_len)
+};
+
+///< structure contains command line history stored in fixed-size byte ring (zero-ended lines, oldest lines are overwritten)
+struct clip_history {
+    char *buf;                              ///< ring buffer
+    size_t size;                            ///< size of ring buffer
+    size_t tail;                            ///< index of the oldest line
+    size_t used;                            ///< number of used bytes (including lines terminating zeros)
+    size_t lines;                           ///< number of stored lines
+};
+
+///< structure contains interactive line reader state (fixed buffer, e.g. for serial terminal)
+struct clip_reader {
+    char *buf;                              ///< buffer for command line
+    size_t buf_size;                        ///< size of command line buffer (longest accepted line + 1)
+    size_t len;                             ///< number of chars stored in command line buffer
+    bool too_long;                          ///< current line doesn't fit in buffer (discarding chars until end of line)
+    bool cr;                                ///< last char was '\r' (following '\n' is skipped)
+    struct clip_out *echo;                  ///< optional writer for echo of typed chars (NULL - no echo)
+    uint32_t dropped_long;                  ///< number of lines dropped because they didn't fit in buffer
+    size_t cursor;                          ///< cursor position in edited line (CLIP_CONFIG_EDITOR_ENABLED)
+    clip_reader_esc_t esc;                  ///< escape sequences parser state (CLIP_CONFIG_EDITOR_ENABLED)
+    char esc_param;                         ///< numeric parameter of escape sequence, e.g. '3' of "ESC [ 3 ~" (CLIP_CONFIG_EDITOR_ENABLED)
+    struct clip_history *history;           ///< optional lines history (NULL - no history, CLIP_CONFIG_EDITOR_ENABLED)
+    size_t recall;                          ///< number of history steps back of shown line (0 - edited line is shown)
+    size_t recall_pos;                      ///< ring index of shown history line (not copied until it's edited or accepted)
+    size_t recall_len;                      ///< length of shown history line
+    const struct clip_complete *complete;   ///< optional completion index used by tab key (NULL - tab is inserted, CLIP_CONFIG_EDITOR_ENABLED)
+    const char *prompt;                     ///< optional prompt echoed when line is redrawn after candidates list (NULL after init, may be set by user)
+};
+
+///< structure contains state of single console session (must be mutable, one per concurrently served client)
+struct clip_session {
+    const struct clip *clip;                ///< root clip handler (const, may be shared by many sessions and threads)
+    struct clip_stream stream;              ///< command line assembly and streamed arguments state
+    struct clip_out out;                    ///< buffered responses writer (its context is session context)
+    void *context;                          ///< session context passed to callbacks, events and output sink
+};
+
+struct clip_frame;
+
+///< alias for function pointer with frames sink (fired with single COBS encoded response frame, including 0x00 delimiter)
+typedef void (*clip_frame_sink_t)(struct clip_frame *self, const uint8_t *data, size_t size);
+
+///< structure contains binary framed transport state (COBS framed requests and responses, must be mutable, one per link)
+struct clip_frame {
+    const struct clip *clip;                ///< root clip handler
+    const struct clip_command **commands;   ///< commands table indexed by ID (filled from "clip_index" at init)
+    size_t commands_num;                    ///< number of commands table entries
+    uint8_t *rx;                            ///< buffer for received frame (COBS decoded in place)
+    size_t rx_size;                         ///< size of receive buffer (longest accepted encoded frame)
+    size_t rx_len;                          ///< number of bytes stored in receive buffer
+    bool rx_overflow;                       ///< current frame doesn't fit in buffer (discarding bytes until delimiter)
+    uint8_t *tx;                            ///< buffer for response frame (COBS encoded in place)
+    size_t tx_size;                         ///< size of transmit buffer
+    size_t tx_reserve;                      ///< space for COBS overhead in front of response frame
+    struct clip_out out;                    ///< response writer passed to commands (its buffer is payload part of transmit buffer)
+    clip_frame_sink_t sink;                 ///< frames sink (may be NULL)
+    void *context;                          ///< context passed to callbacks, events and frames sink
+    uint8_t seq;                            ///< sequence number of currently served request (copied to responses)
+    uint32_t dropped;                       ///< number of dropped frames (too long, broken COBS encoding or too short header)
 };
 
 #endif /* CLIP_TYPES_H */
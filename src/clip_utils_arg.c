@@ -25,7 +25,6 @@ SOFTWARE.
 #include "clip.h"
 
 #include <string.h>
-#include <stdio.h>
 
 char* clip_utils_arg_get_first(char **arg, char *cmd_line)
 {
@@ -82,6 +81,30 @@ char* clip_utils_arg_get_first(char **arg, char *cmd_line)
     return ch;
 }
 
+char* clip_utils_arg_split_command(char *cmd_line)
+{
+    CLIP_CONFIG_ASSERT(cmd_line != NULL);
+
+    bool escape = false;
+    bool quotemark = false;
+
+    /* the same quotemarks and escape rules as in "clip_utils_arg_get_first" */
+    for (char *ch = cmd_line; *ch != '\0'; ch++) {
+        if (escape != false) {
+            escape = false;
+        } else if (*ch == '\\') {
+            escape = true;
+        } else if (*ch == '\"') {
+            quotemark = !quotemark;
+        } else if (quotemark == false && *ch == CLIP_CONFIG_PIPELINE_SEPARATOR) {
+            *ch = '\0';
+            return ch + 1;
+        }
+    }
+
+    return NULL;
+}
+
 const char* clip_utils_arg_get_type_string(clip_arg_type_t type)
 {
     switch (type) {
@@ -91,6 +114,7 @@ const char* clip_utils_arg_get_type_string(clip_arg_type_t type)
     case CLIP_ARG_TYPE_UINT: return "UINT";
     case CLIP_ARG_TYPE_FLOAT: return "FLOAT";
     case CLIP_ARG_TYPE_HEXARRAY: return "HEXARRAY";
+    case CLIP_ARG_TYPE_HEXSTREAM: return "HEXSTREAM";
     default: return "UNKNOWN";
     }
 }
@@ -105,6 +129,8 @@ const char* clip_utils_arg_get_error_string(clip_arg_error_t error)
     case CLIP_ARG_ERROR_PARSE_UINT: return "UNSIGNED INTEGER PARSING ERROR";
     case CLIP_ARG_ERROR_PARSE_FLOAT: return "FLOAT NUMBER PARSING ERROR";
     case CLIP_ARG_ERROR_PARSE_HEXARRAY: return "ASCII HEX ARRAY PARSING ERROR";
+    case CLIP_ARG_ERROR_CHECKSUM: return "CHECKSUM MISMATCH";
+    case CLIP_ARG_ERROR_TYPE_MISMATCH: return "TYPE MISMATCH";
     default: return "UNKNOWN";
     }
 }
@@ -121,31 +147,65 @@ char* clip_utils_arg_update_buf(char *buf, size_t *buf_size, size_t *out_size, s
     return buf;
 }
 
-size_t clip_utils_arg_get_command_usage_string(char *buf, size_t buf_size, const struct clip_command *cmd)
+struct clip_utils_arg_usage_buf {
+    char *buf;                          ///< output buffer
+    size_t buf_size;                    ///< output buffer size
+    size_t len;                         ///< full usage length (may be greater than buffer)
+};
+
+static void clip_utils_arg_usage_sink(struct clip_out *self, const char *data, size_t size)
 {
-    size_t out_size = 0;
-    size_t size = 0;
+    struct clip_utils_arg_usage_buf *usage = (struct clip_utils_arg_usage_buf*)self->context;
 
+    for (size_t i = 0; i < size; i++, usage->len++) {
+        if (usage->len + 1 < usage->buf_size)
+            usage->buf[usage->len] = data[i];
+    }
+}
+
+void clip_utils_arg_put_command_usage(struct clip_out *out, const struct clip_command *cmd)
+{
     CLIP_CONFIG_ASSERT(cmd != NULL);
 
-    size = snprintf(buf, buf_size, "%s ", cmd->name);
-    buf = clip_utils_arg_update_buf(buf, &buf_size, &out_size, size);
+    if (cmd->usage != NULL) {
+        clip_out_put_str(out, cmd->usage);
+        return;
+    }
+
+    clip_out_put_str(out, cmd->name);
 
     const struct clip_arg* *args = cmd->args;
     if (args != NULL) {
         while (*args != NULL) {
-            if (args != cmd->args) {
-                strncat(buf, " ", buf_size);
-                buf = clip_utils_arg_update_buf(buf, &buf_size, &out_size, 1);
-            }
-            const char *fmt = (*args)->optional ? "[%s:%s]" : "<%s:%s>";
-            size = snprintf(buf, buf_size, fmt, (*args)->name, clip_utils_arg_get_type_string((*args)->type));
-            buf = clip_utils_arg_update_buf(buf, &buf_size, &out_size, size);
+            clip_out_put_str(out, (*args)->optional ? " [" : " <");
+            clip_out_put_str(out, (*args)->name);
+            clip_out_put_str(out, ":");
+            clip_out_put_str(out, clip_utils_arg_get_type_string((*args)->type));
+            clip_out_put_str(out, (*args)->optional ? "]" : ">");
             args++;
         }
     }
-    
-    return out_size;
+}
+
+size_t clip_utils_arg_get_command_usage_string(char *buf, size_t buf_size, const struct clip_command *cmd)
+{
+    CLIP_CONFIG_ASSERT(buf != NULL || buf_size == 0);
+    CLIP_CONFIG_ASSERT(cmd != NULL);
+
+    struct clip_utils_arg_usage_buf usage = {
+        .buf = buf,
+        .buf_size = buf_size,
+        .len = 0,
+    };
+    struct clip_out out;
+
+    // unbuffered writer passes every chunk directly to the sink
+    clip_out_init(&out, NULL, 0, clip_utils_arg_usage_sink, &usage);
+    clip_utils_arg_put_command_usage(&out, cmd);
+
+    if (buf_size > 0)
+        buf[(usage.len < buf_size) ? usage.len : buf_size - 1] = '\0';
+    return usage.len;
 }
 
 size_t clip_utils_arg_unpack_hexarray(uint8_t **data, clip_hexarray_t hex_array)
@@ -168,3 +228,12 @@ size_t clip_utils_arg_unpack_hexarray(uint8_t **data, clip_hexarray_t hex_array)
     *data = &hex_array[len_size + 1];
     return len;
 }
+
+bool clip_utils_arg_has_checksum(const struct clip_arg **args, size_t index)
+{
+    CLIP_CONFIG_ASSERT(args != NULL);
+    CLIP_CONFIG_ASSERT(args[index] != NULL);
+
+    const struct clip_arg *next = args[index + 1];
+    return args[index]->check == CLIP_ARG_CHECK_NONE || (next != NULL && next->type == CLIP_ARG_TYPE_UINT && next->optional == false);
+}
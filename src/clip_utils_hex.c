@@ -94,3 +94,34 @@ bool clip_utils_hex_to_buf(uint8_t *buf, const char *hex, size_t hex_size)
     }
     return true;
 }
+
+void clip_utils_hex_decoder_reset(struct clip_hex_decoder *decoder)
+{
+    CLIP_CONFIG_ASSERT(decoder != NULL);
+
+    decoder->value = 0;
+    decoder->half = false;
+}
+
+bool clip_utils_hex_decoder_feed(struct clip_hex_decoder *decoder, uint8_t *buf, size_t *buf_len, const char ch)
+{
+    bool s;
+    uint8_t n;
+
+    CLIP_CONFIG_ASSERT(decoder != NULL);
+    CLIP_CONFIG_ASSERT(buf != NULL);
+    CLIP_CONFIG_ASSERT(buf_len != NULL);
+
+    s = clip_utils_hex_char_to_nibble(&n, ch);
+    if (s == false)
+        return false;
+
+    if (decoder->half == false) {
+        decoder->value = n << 4;
+        decoder->half = true;
+    } else {
+        buf[(*buf_len)++] = decoder->value | n;
+        decoder->half = false;
+    }
+    return true;
+}
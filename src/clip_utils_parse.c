@@ -92,15 +92,25 @@ bool clip_utils_parse_float(struct clip_arg_value *argv, const char *arg)
 }
 
 bool clip_utils_parse_hexarray(struct clip_arg_value *argv, char *arg)
+{
+    return clip_utils_parse_hexarray_crc(argv, arg, CLIP_ARG_CHECK_NONE, NULL);
+}
+
+bool clip_utils_parse_hexarray_crc(struct clip_arg_value *argv, char *arg, clip_arg_check_t check, uint32_t *crc)
 {
     bool s;
     uint8_t tmp[sizeof(uint32_t)] = {0};
     size_t len = 0;
     uint8_t *header = NULL;
     uint8_t *data = NULL;
+    uint32_t c = 0;
 
     CLIP_CONFIG_ASSERT(argv != NULL);
     CLIP_CONFIG_ASSERT(arg != NULL);
+    CLIP_CONFIG_ASSERT(check == CLIP_ARG_CHECK_NONE || crc != NULL);
+
+    if (check != CLIP_ARG_CHECK_NONE)
+        c = clip_utils_crc_init(check);
 
     size_t asciihex_len = strlen(arg);
     if (asciihex_len & 1)
@@ -115,6 +125,8 @@ bool clip_utils_parse_hexarray(struct clip_arg_value *argv, char *arg)
             s = clip_utils_hex_to_buf(&tmp[i], &arg[i << 1], 2);
             if (s == false)
                 return false;
+            if (check != CLIP_ARG_CHECK_NONE)
+                c = clip_utils_crc_update(check, c, tmp[i]);
         }
 
         if (len <= sizeof(tmp)) {
@@ -131,6 +143,8 @@ bool clip_utils_parse_hexarray(struct clip_arg_value *argv, char *arg)
                 s = clip_utils_hex_to_buf(&b, &arg[i << 1], 2);
                 if (s == false)
                     return false;
+                if (check != CLIP_ARG_CHECK_NONE)
+                    c = clip_utils_crc_update(check, c, b);
                 data[i] = b;
             }
         }
@@ -140,6 +154,9 @@ bool clip_utils_parse_hexarray(struct clip_arg_value *argv, char *arg)
         }
     }
 
+    if (check != CLIP_ARG_CHECK_NONE)
+        *crc = clip_utils_crc_final(check, c);
+
     argv->type = CLIP_ARG_TYPE_HEXARRAY;
     argv->val_hexarray = (clip_hexarray_t)&arg[0];
     return true;
@@ -33,14 +33,20 @@ SOFTWARE.
 
 struct ClipCmdCall_Mock : public Mock<ClipCmdCall_Mock>
 {
-    MOCK_METHOD(void, clip_cmd_call_command_callback, (const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context), ());
+    MOCK_METHOD(void, clip_cmd_call_command_callback, (const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result), ());
+    MOCK_METHOD(void, clip_cmd_call_bind_command, (const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context, struct clip_result *result, struct clip_bound_command *bound), ());
 };
 
 extern "C" {
 
-void clip_cmd_call_command_callback(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context)
+void clip_cmd_call_command_callback(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result)
 {
-    ClipCmdCall_Mock::get()->clip_cmd_call_command_callback(self, cmd, cmd_line, context);
+    ClipCmdCall_Mock::get()->clip_cmd_call_command_callback(self, cmd, cmd_line, out, context, result);
+}
+
+void clip_cmd_call_bind_command(const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context, struct clip_result *result, struct clip_bound_command *bound)
+{
+    ClipCmdCall_Mock::get()->clip_cmd_call_bind_command(self, cmd, cmd_line, context, result, bound);
 }
 
 }
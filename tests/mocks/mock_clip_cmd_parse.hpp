@@ -34,6 +34,7 @@ SOFTWARE.
 struct ClipCmdParse_Mock : public Mock<ClipCmdParse_Mock>
 {
     MOCK_METHOD(void, clip_cmd_parse_line, (const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context), ());
+    MOCK_METHOD(clip_status_t, clip_cmd_parse_line_ex, (const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result), ());
 };
 
 extern "C" {
@@ -43,4 +44,9 @@ void clip_cmd_parse_line(const struct clip *self, const struct clip_command *cmd
     ClipCmdParse_Mock::get()->clip_cmd_parse_line(self, cmd, cmd_line, context);
 }
 
+clip_status_t clip_cmd_parse_line_ex(const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result)
+{
+    return ClipCmdParse_Mock::get()->clip_cmd_parse_line_ex(self, cmd, cmd_line, out, context, result);
+}
+
 }
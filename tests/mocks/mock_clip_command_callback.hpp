@@ -33,14 +33,14 @@ SOFTWARE.
 
 struct ClipCommandCallback_Mock : public Mock<ClipCommandCallback_Mock>
 {
-    MOCK_METHOD(void, clip_command_callback, (const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context), ());
+    MOCK_METHOD(int, clip_command_callback, (const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context), ());
 };
 
 extern "C" {
 
-void test_clip_command_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context)
+int test_clip_command_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
 {
-    return ClipCommandCallback_Mock::get()->clip_command_callback(self, cmd, argc, argv, context);
+    return ClipCommandCallback_Mock::get()->clip_command_callback(self, cmd, argc, argv, out, context);
 }
 
 }
@@ -52,6 +52,10 @@ MATCHER_P2(IsEqualClipEventArg_CallCommandCallback, cmd, cmd_line, "Equality mat
     return std::tie(arg->call_command_callback.cmd, arg->call_command_callback.cmd_line) == std::tie(cmd, cmd_line);
 }
 
+MATCHER_P2(IsEqualClipEventArg_CommandComplete, cmd, code, "Equality matcher for clip_event_arg.command_complete") {
+    return std::tie(arg->command_complete.cmd, arg->command_complete.code) == std::tie(cmd, code);
+}
+
 extern "C" {
 
 void test_clip_event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context)
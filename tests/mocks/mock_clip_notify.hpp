@@ -37,6 +37,7 @@ struct ClipNotify_Mock : public Mock<ClipNotify_Mock>
     MOCK_METHOD(void, clip_notify_event_command_not_found, (const struct clip *self, void *context, const struct clip_command *cmd, const char *cmd_name), ());
     MOCK_METHOD(void, clip_notify_event_arguments_error, (const struct clip *self, void *context, const struct clip_command *cmd, clip_arg_error_t error), ());
     MOCK_METHOD(void, clip_notify_event_call_command_callback, (const struct clip *self, void *context, const struct clip_command *cmd, const char *cmd_line), ());
+    MOCK_METHOD(void, clip_notify_event_command_complete, (const struct clip *self, void *context, const struct clip_command *cmd, int code), ());
 };
 
 extern "C" {
@@ -61,4 +62,9 @@ void clip_notify_event_call_command_callback(const struct clip *self, void *cont
     ClipNotify_Mock::get()->clip_notify_event_call_command_callback(self, context, cmd, cmd_line);
 }
 
+void clip_notify_event_command_complete(const struct clip *self, void *context, const struct clip_command *cmd, int code)
+{
+    ClipNotify_Mock::get()->clip_notify_event_command_complete(self, context, cmd, code);
+}
+
 }
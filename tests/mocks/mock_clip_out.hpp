@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock.hpp"
+
+struct ClipOut_Mock : public Mock<ClipOut_Mock>
+{
+    MOCK_METHOD(void, clip_out_init, (struct clip_out *self, char *buf, size_t buf_size, clip_out_sink_t sink, void *context), ());
+    MOCK_METHOD(void, clip_out_flush, (struct clip_out *self), ());
+    MOCK_METHOD(void, clip_out_put_bytes, (struct clip_out *self, const void *data, size_t size), ());
+    MOCK_METHOD(void, clip_out_put_str, (struct clip_out *self, const char *str), ());
+    MOCK_METHOD(void, clip_out_put_u32, (struct clip_out *self, uint32_t value), ());
+    MOCK_METHOD(void, clip_out_put_hex, (struct clip_out *self, const uint8_t *data, size_t size), ());
+};
+
+extern "C" {
+
+void clip_out_init(struct clip_out *self, char *buf, size_t buf_size, clip_out_sink_t sink, void *context)
+{
+    ClipOut_Mock::get()->clip_out_init(self, buf, buf_size, sink, context);
+}
+
+void clip_out_flush(struct clip_out *self)
+{
+    ClipOut_Mock::get()->clip_out_flush(self);
+}
+
+void clip_out_put_bytes(struct clip_out *self, const void *data, size_t size)
+{
+    ClipOut_Mock::get()->clip_out_put_bytes(self, data, size);
+}
+
+void clip_out_put_str(struct clip_out *self, const char *str)
+{
+    ClipOut_Mock::get()->clip_out_put_str(self, str);
+}
+
+void clip_out_put_u32(struct clip_out *self, uint32_t value)
+{
+    ClipOut_Mock::get()->clip_out_put_u32(self, value);
+}
+
+void clip_out_put_hex(struct clip_out *self, const uint8_t *data, size_t size)
+{
+    ClipOut_Mock::get()->clip_out_put_hex(self, data, size);
+}
+
+}
@@ -0,0 +1,58 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock.hpp"
+
+struct ClipStreamCallback_Mock : public Mock<ClipStreamCallback_Mock>
+{
+    MOCK_METHOD(void, clip_stream_begin_callback, (const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context), ());
+    MOCK_METHOD(void, clip_stream_data_callback, (const struct clip *self, const struct clip_command *cmd, std::vector<uint8_t> data, struct clip_out *out, void *context), ());
+    MOCK_METHOD(void, clip_stream_end_callback, (const struct clip *self, const struct clip_command *cmd, size_t size, clip_arg_error_t error, struct clip_out *out, void *context), ());
+};
+
+extern "C" {
+
+void test_clip_stream_begin_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    ClipStreamCallback_Mock::get()->clip_stream_begin_callback(self, cmd, argc, argv, out, context);
+}
+
+void test_clip_stream_data_callback(const struct clip *self, const struct clip_command *cmd, const uint8_t *data, size_t size, struct clip_out *out, void *context)
+{
+    ClipStreamCallback_Mock::get()->clip_stream_data_callback(self, cmd, std::vector<uint8_t>(data, data + size), out, context);
+}
+
+void test_clip_stream_end_callback(const struct clip *self, const struct clip_command *cmd, size_t size, clip_arg_error_t error, struct clip_out *out, void *context)
+{
+    ClipStreamCallback_Mock::get()->clip_stream_end_callback(self, cmd, size, error, out, context);
+}
+
+}
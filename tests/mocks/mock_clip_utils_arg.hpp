@@ -34,10 +34,12 @@ SOFTWARE.
 struct ClipUtilsArg_Mock : public Mock<ClipUtilsArg_Mock>
 {
     MOCK_METHOD(char*, clip_utils_arg_get_first, (char **arg, char *cmd_line), ());
+    MOCK_METHOD(char*, clip_utils_arg_split_command, (char *cmd_line), ());
     MOCK_METHOD(const char*, clip_utils_arg_get_type_string, (clip_arg_type_t type), ());
     MOCK_METHOD(char*, clip_utils_arg_update_buf, (char *buf, size_t *buf_size, size_t *out_size, size_t size), ());
     MOCK_METHOD(size_t, clip_utils_arg_get_command_usage_string, (char *buf, size_t buf_size, const struct clip_command *cmd), ());
     MOCK_METHOD(size_t, clip_utils_arg_unpack_hexarray, (uint8_t **data, clip_hexarray_t hex_array), ());
+    MOCK_METHOD(bool, clip_utils_arg_has_checksum, (const struct clip_arg **args, size_t index), ());
 };
 
 extern "C" {
@@ -47,6 +49,11 @@ char* clip_utils_arg_get_first(char **arg, char *cmd_line)
     return ClipUtilsArg_Mock::get()->clip_utils_arg_get_first(arg, cmd_line);
 }
 
+char* clip_utils_arg_split_command(char *cmd_line)
+{
+    return ClipUtilsArg_Mock::get()->clip_utils_arg_split_command(cmd_line);
+}
+
 const char* clip_utils_arg_get_type_string(clip_arg_type_t type)
 {
     return ClipUtilsArg_Mock::get()->clip_utils_arg_get_type_string(type);
@@ -67,4 +74,9 @@ size_t clip_utils_arg_unpack_hexarray(uint8_t **data, clip_hexarray_t hex_array)
     return ClipUtilsArg_Mock::get()->clip_utils_arg_unpack_hexarray(data, hex_array);
 }
 
+bool clip_utils_arg_has_checksum(const struct clip_arg **args, size_t index)
+{
+    return ClipUtilsArg_Mock::get()->clip_utils_arg_has_checksum(args, index);
+}
+
 }
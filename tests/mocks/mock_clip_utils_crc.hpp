@@ -0,0 +1,64 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock.hpp"
+
+struct ClipUtilsCrc_Mock : public Mock<ClipUtilsCrc_Mock>
+{
+    MOCK_METHOD(uint32_t, clip_utils_crc_init, (clip_arg_check_t check), ());
+    MOCK_METHOD(uint32_t, clip_utils_crc_update, (clip_arg_check_t check, uint32_t crc, const uint8_t byte), ());
+    MOCK_METHOD(uint32_t, clip_utils_crc_final, (clip_arg_check_t check, uint32_t crc), ());
+    MOCK_METHOD(uint32_t, clip_utils_crc_calc, (clip_arg_check_t check, const uint8_t *data, size_t size), ());
+};
+
+extern "C" {
+
+uint32_t clip_utils_crc_init(clip_arg_check_t check)
+{
+    return ClipUtilsCrc_Mock::get()->clip_utils_crc_init(check);
+}
+
+uint32_t clip_utils_crc_update(clip_arg_check_t check, uint32_t crc, const uint8_t byte)
+{
+    return ClipUtilsCrc_Mock::get()->clip_utils_crc_update(check, crc, byte);
+}
+
+uint32_t clip_utils_crc_final(clip_arg_check_t check, uint32_t crc)
+{
+    return ClipUtilsCrc_Mock::get()->clip_utils_crc_final(check, crc);
+}
+
+uint32_t clip_utils_crc_calc(clip_arg_check_t check, const uint8_t *data, size_t size)
+{
+    return ClipUtilsCrc_Mock::get()->clip_utils_crc_calc(check, data, size);
+}
+
+}
@@ -38,6 +38,7 @@ struct ClipUtilsParse_Mock : public Mock<ClipUtilsParse_Mock>
     MOCK_METHOD(bool, clip_utils_parse_uint, (struct clip_arg_value *argv, const char *arg), ());
     MOCK_METHOD(bool, clip_utils_parse_float, (struct clip_arg_value *argv, const char *arg), ());
     MOCK_METHOD(bool, clip_utils_parse_hexarray, (struct clip_arg_value *argv, char *arg), ());
+    MOCK_METHOD(bool, clip_utils_parse_hexarray_crc, (struct clip_arg_value *argv, char *arg, clip_arg_check_t check, uint32_t *crc), ());
 };
 
 extern "C" {
@@ -67,4 +68,9 @@ bool clip_utils_parse_hexarray(struct clip_arg_value *argv, char *arg)
     return ClipUtilsParse_Mock::get()->clip_utils_parse_hexarray(argv, arg);
 }
 
+bool clip_utils_parse_hexarray_crc(struct clip_arg_value *argv, char *arg, clip_arg_check_t check, uint32_t *crc)
+{
+    return ClipUtilsParse_Mock::get()->clip_utils_parse_hexarray_crc(argv, arg, check, crc);
+}
+
 }
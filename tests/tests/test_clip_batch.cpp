@@ -0,0 +1,181 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "clip.h"
+
+#include "mock_clip_event_callback.hpp"
+#include "mock_clip_command_callback.hpp"
+#include "mock_clip_stream_callback.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::InSequence;
+
+extern "C" const struct clip g_clip;
+
+MATCHER_P(IsCommand_Name, cmd_name, "Equality matcher for command name")
+{
+    return strcmp(arg->name, cmd_name) == 0;
+}
+
+static std::vector<std::tuple<size_t, clip_status_t, size_t>> g_reports;
+
+static void test_clip_batch_report(const struct clip *self, size_t line_no, const struct clip_result *result, void *context)
+{
+    g_reports.push_back({line_no, result->status, result->offset});
+}
+
+static int put_command_name(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    clip_out_put_str(out, cmd->name);
+    clip_out_put_str(out, ";");
+    return 0;
+}
+
+class ClipBatchTest : public Test
+{
+protected:
+    char out_buf[64];
+    struct clip_out out;
+
+    virtual void SetUp()
+    {
+        ClipEventCallback_Mock::create();
+        ClipCommandCallback_Mock::create();
+        ClipStreamCallback_Mock::create();
+        ClipOutSink_Mock::create();
+
+        g_reports.clear();
+        clip_out_init(&out, out_buf, sizeof(out_buf), test_clip_out_sink, nullptr);
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, _, _, (void*)12345678))
+            .Times(::testing::AnyNumber());
+    }
+
+    virtual void TearDown()
+    {
+        ClipEventCallback_Mock::destroy();
+        ClipCommandCallback_Mock::destroy();
+        ClipStreamCallback_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+};
+
+TEST_F(ClipBatchTest, clip_batch_run__allLines)
+{
+    std::string script = "# comment\r\nmem read 1 2\r\n\r\n  \tmem read 5 6\n\n   # indented comment\nmem read 3 4";
+    struct clip_batch_result result;
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+
+    // std::string keeps terminating zero after the last line
+    EXPECT_TRUE(clip_batch_run(&g_clip, script.data(), script.length(), &out, (void*)12345678, CLIP_PIPELINE_STOP_ON_ERROR, test_clip_batch_report, &result));
+
+    EXPECT_EQ(result.lines, 3U);
+    EXPECT_EQ(result.errors, 0U);
+    EXPECT_EQ(result.error_line, 0U);
+    EXPECT_EQ(result.size, script.length());
+    EXPECT_EQ(g_reports, (std::vector<std::tuple<size_t, clip_status_t, size_t>>{
+        {2, CLIP_STATUS_OK, 0},
+        {4, CLIP_STATUS_OK, 0},
+        {7, CLIP_STATUS_OK, 0},
+    }));
+}
+
+TEST_F(ClipBatchTest, clip_batch_run__stopOnError)
+{
+    std::string script = "mem read 1 2\nmem read x 2\nmem read 3 4\n";
+    struct clip_batch_result result;
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+
+    EXPECT_FALSE(clip_batch_run(&g_clip, script.data(), script.length(), &out, (void*)12345678, CLIP_PIPELINE_STOP_ON_ERROR, test_clip_batch_report, &result));
+
+    EXPECT_EQ(result.lines, 2U);
+    EXPECT_EQ(result.errors, 1U);
+    EXPECT_EQ(result.error_line, 2U);
+    EXPECT_EQ(result.size, 26U);
+    EXPECT_EQ(g_reports, (std::vector<std::tuple<size_t, clip_status_t, size_t>>{
+        {1, CLIP_STATUS_OK, 0},
+        {2, CLIP_STATUS_ARGUMENTS_ERROR, 9},
+    }));
+}
+
+TEST_F(ClipBatchTest, clip_batch_run__continueOnError)
+{
+    std::string script = "mem read 1 2\nmem bad\nmem read x 2\nmem read 3 4\n";
+    struct clip_batch_result result;
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+
+    EXPECT_FALSE(clip_batch_run(&g_clip, script.data(), script.length(), &out, (void*)12345678, CLIP_PIPELINE_CONTINUE, test_clip_batch_report, &result));
+
+    EXPECT_EQ(result.lines, 4U);
+    EXPECT_EQ(result.errors, 2U);
+    EXPECT_EQ(result.error_line, 2U);
+    EXPECT_EQ(result.size, script.length());
+    EXPECT_EQ(g_reports, (std::vector<std::tuple<size_t, clip_status_t, size_t>>{
+        {1, CLIP_STATUS_OK, 0},
+        {2, CLIP_STATUS_COMMAND_NOT_FOUND, 4},
+        {3, CLIP_STATUS_ARGUMENTS_ERROR, 9},
+        {4, CLIP_STATUS_OK, 0},
+    }));
+}
+
+TEST_F(ClipBatchTest, clip_batch_run__emptyScript)
+{
+    char script[1] = {'\0'};
+
+    EXPECT_TRUE(clip_batch_run(&g_clip, script, 0, &out, (void*)12345678, CLIP_PIPELINE_STOP_ON_ERROR, nullptr, nullptr));
+}
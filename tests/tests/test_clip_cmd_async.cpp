@@ -0,0 +1,116 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock_clip_notify.hpp"
+#include "mock_clip_out.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::InSequence;
+
+class ClipCmdAsyncTest : public Test
+{
+protected:
+    struct clip_pending token;
+
+    virtual void SetUp()
+    {
+        ClipNotify_Mock::create();
+        ClipOut_Mock::create();
+
+        token = {};
+    }
+
+    virtual void TearDown()
+    {
+        ClipOut_Mock::destroy();
+        ClipNotify_Mock::destroy();
+    }
+};
+
+TEST_F(ClipCmdAsyncTest, clip_cmd_pend)
+{
+    EXPECT_FALSE(clip_cmd_is_pending(&token));
+
+    int code = clip_cmd_pend(&token, (struct clip*)123, (struct clip_command*)456, (struct clip_out*)789, (void*)11223344);
+
+    EXPECT_EQ(code, CLIP_COMMAND_PENDING);
+    EXPECT_TRUE(clip_cmd_is_pending(&token));
+    EXPECT_EQ(token.clip, (struct clip*)123);
+    EXPECT_EQ(token.cmd, (struct clip_command*)456);
+    EXPECT_EQ(token.out, (struct clip_out*)789);
+    EXPECT_EQ(token.context, (void*)11223344);
+}
+
+TEST_F(ClipCmdAsyncTest, clip_cmd_complete)
+{
+    InSequence s;
+
+    clip_cmd_pend(&token, (struct clip*)123, (struct clip_command*)456, (struct clip_out*)789, (void*)11223344);
+
+    EXPECT_CALL(*ClipOut_Mock::get(), clip_out_flush((struct clip_out*)789));
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_command_complete((struct clip*)123, (void*)11223344, (struct clip_command*)456, -5));
+
+    clip_cmd_complete(&token, -5);
+
+    EXPECT_FALSE(clip_cmd_is_pending(&token));
+}
+
+TEST_F(ClipCmdAsyncTest, clip_cmd_complete__noOut)
+{
+    clip_cmd_pend(&token, (struct clip*)123, (struct clip_command*)456, nullptr, (void*)11223344);
+
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_command_complete((struct clip*)123, (void*)11223344, (struct clip_command*)456, 0));
+
+    clip_cmd_complete(&token, 0);
+
+    EXPECT_FALSE(clip_cmd_is_pending(&token));
+}
+
+TEST_F(ClipCmdAsyncTest, clip_cmd_complete__pendAgainFromEvent)
+{
+    InSequence s;
+
+    clip_cmd_pend(&token, (struct clip*)123, (struct clip_command*)456, (struct clip_out*)789, (void*)11223344);
+
+    EXPECT_CALL(*ClipOut_Mock::get(), clip_out_flush((struct clip_out*)789));
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_command_complete((struct clip*)123, (void*)11223344, (struct clip_command*)456, 0))
+        .WillOnce(Invoke([this](const struct clip *self, void *context, const struct clip_command *cmd, int code) {
+            EXPECT_FALSE(clip_cmd_is_pending(&token));
+            clip_cmd_pend(&token, self, (struct clip_command*)654, nullptr, context);
+        }));
+
+    clip_cmd_complete(&token, 0);
+
+    EXPECT_TRUE(clip_cmd_is_pending(&token));
+    EXPECT_EQ(token.cmd, (struct clip_command*)654);
+    EXPECT_EQ(token.out, nullptr);
+}
@@ -31,6 +31,7 @@ SOFTWARE.
 #include "mock_clip_utils_arg.hpp"
 #include "mock_clip_utils_parse.hpp"
 #include "mock_clip_command_callback.hpp"
+#include "mock_clip_out.hpp"
 
 using ::testing::_;
 using ::testing::Test;
@@ -46,6 +47,7 @@ protected:
         ClipUtilsArg_Mock::create();
         ClipUtilsParse_Mock::create();
         ClipCommandCallback_Mock::create();
+        ClipOut_Mock::create();
     }
 
     virtual void TearDown()
@@ -54,6 +56,7 @@ protected:
         ClipUtilsArg_Mock::destroy();
         ClipUtilsParse_Mock::destroy();
         ClipCommandCallback_Mock::destroy();
+        ClipOut_Mock::destroy();
     }
 };
 
@@ -63,7 +66,7 @@ TEST_F(ClipCmdCallTest, clip_cmd_call_command_callback__noArgs)
     cmd.callback = test_clip_command_callback;
     const char *line = "test";
 
-    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback((struct clip*)123, &cmd, 0, _, (void*)11223344));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback((struct clip*)123, &cmd, 0, _, _, (void*)11223344));
     EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_call_command_callback((struct clip*)123, (void*)11223344, &cmd, line));
     EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)line))
         .WillOnce(Invoke([](char **cmd_name, char *cmd_line)->char* {
@@ -71,5 +74,205 @@ TEST_F(ClipCmdCallTest, clip_cmd_call_command_callback__noArgs)
             return (char*)"\0";
         }));
     
-    clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)line, (void*)11223344);
+    struct clip_result result = {};
+    clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)line, nullptr, (void*)11223344, &result);
+    EXPECT_EQ(result.status, CLIP_STATUS_OK);
+    EXPECT_EQ(result.cmd, &cmd);
+    EXPECT_EQ(result.code, 0);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_call_command_callback__commandError)
+{
+    struct clip_command cmd = {};
+    cmd.callback = test_clip_command_callback;
+    const char *line = "test";
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback((struct clip*)123, &cmd, 0, _, _, (void*)11223344))
+        .WillOnce(Return(-5));
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_call_command_callback((struct clip*)123, (void*)11223344, &cmd, line));
+    EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)line))
+        .WillOnce(Invoke([](char **cmd_name, char *cmd_line)->char* {
+            *cmd_name = (char*)"\0";
+            return (char*)"\0";
+        }));
+
+    struct clip_result result = {};
+    clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)line, nullptr, (void*)11223344, &result);
+    EXPECT_EQ(result.status, CLIP_STATUS_COMMAND_ERROR);
+    EXPECT_EQ(result.cmd, &cmd);
+    EXPECT_EQ(result.code, -5);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_call_command_callback__pending)
+{
+    struct clip_command cmd = {};
+    cmd.callback = test_clip_command_callback;
+    const char *line = "test";
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback((struct clip*)123, &cmd, 0, _, (struct clip_out*)789, (void*)11223344))
+        .WillOnce(Return(CLIP_COMMAND_PENDING));
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_call_command_callback((struct clip*)123, (void*)11223344, &cmd, line));
+    EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)line))
+        .WillOnce(Invoke([](char **cmd_name, char *cmd_line)->char* {
+            *cmd_name = (char*)"\0";
+            return (char*)"\0";
+        }));
+
+    struct clip_result result = {};
+    clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)line, (struct clip_out*)789, (void*)11223344, &result);
+    EXPECT_EQ(result.status, CLIP_STATUS_PENDING);
+    EXPECT_EQ(result.cmd, &cmd);
+    EXPECT_EQ(result.code, CLIP_COMMAND_PENDING);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_call_command_callback__argumentsError)
+{
+    const struct clip_arg arg = {"value", nullptr, CLIP_ARG_TYPE_UINT, false, nullptr, CLIP_ARG_CHECK_NONE};
+    const struct clip_arg *args[2] = {&arg, nullptr};
+    struct clip_command cmd = {};
+    cmd.callback = test_clip_command_callback;
+    cmd.args = args;
+    const char *line = "test";
+    const char *token = "abc";
+
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_call_command_callback((struct clip*)123, (void*)11223344, &cmd, line));
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_arguments_error((struct clip*)123, (void*)11223344, &cmd, CLIP_ARG_ERROR_PARSE_UINT));
+    EXPECT_CALL(*ClipUtilsParse_Mock::get(), clip_utils_parse_uint(_, token))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)line))
+        .WillOnce(Invoke([=](char **cmd_name, char *cmd_line)->char* {
+            *cmd_name = (char*)token;
+            return (char*)"\0";
+        }));
+
+    struct clip_result result = {};
+    clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)line, nullptr, (void*)11223344, &result);
+    EXPECT_EQ(result.status, CLIP_STATUS_ARGUMENTS_ERROR);
+    EXPECT_EQ(result.cmd, &cmd);
+    EXPECT_EQ(result.error, CLIP_ARG_ERROR_PARSE_UINT);
+    EXPECT_EQ(result.token, token);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_call_bind_command__noArgs)
+{
+    struct clip_command cmd = {};
+    cmd.callback = test_clip_command_callback;
+    const char *line = "test";
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_call_command_callback((struct clip*)123, (void*)11223344, &cmd, line));
+    EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)line))
+        .WillOnce(Invoke([](char **cmd_name, char *cmd_line)->char* {
+            *cmd_name = (char*)"\0";
+            return (char*)"\0";
+        }));
+
+    struct clip_result result = {};
+    struct clip_bound_command bound = {};
+    clip_cmd_call_bind_command((struct clip*)123, &cmd, (char*)line, (void*)11223344, &result, &bound);
+    EXPECT_EQ(result.status, CLIP_STATUS_BOUND);
+    EXPECT_EQ(result.cmd, &cmd);
+    EXPECT_EQ(bound.clip, (struct clip*)123);
+    EXPECT_EQ(bound.cmd, &cmd);
+    EXPECT_EQ(bound.context, (void*)11223344);
+    EXPECT_EQ(bound.argc, 0);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_call_bind_command__argumentsError)
+{
+    const struct clip_arg arg = {"value", nullptr, CLIP_ARG_TYPE_UINT, false, nullptr, CLIP_ARG_CHECK_NONE};
+    const struct clip_arg *args[2] = {&arg, nullptr};
+    struct clip_command cmd = {};
+    cmd.callback = test_clip_command_callback;
+    cmd.args = args;
+    const char *line = "test";
+    const char *token = "abc";
+
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_call_command_callback((struct clip*)123, (void*)11223344, &cmd, line));
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_arguments_error((struct clip*)123, (void*)11223344, &cmd, CLIP_ARG_ERROR_PARSE_UINT));
+    EXPECT_CALL(*ClipUtilsParse_Mock::get(), clip_utils_parse_uint(_, token))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)line))
+        .WillOnce(Invoke([token](char **cmd_name, char *cmd_line)->char* {
+            *cmd_name = (char*)token;
+            return (char*)"\0";
+        }));
+
+    struct clip_result result = {};
+    struct clip_bound_command bound = {};
+    clip_cmd_call_bind_command((struct clip*)123, &cmd, (char*)line, (void*)11223344, &result, &bound);
+    EXPECT_EQ(result.status, CLIP_STATUS_ARGUMENTS_ERROR);
+    EXPECT_EQ(result.error, CLIP_ARG_ERROR_PARSE_UINT);
+    EXPECT_EQ(result.token, token);
+    EXPECT_EQ(bound.cmd, nullptr);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_invoke)
+{
+    struct clip_command cmd = {};
+    cmd.callback = test_clip_command_callback;
+
+    struct clip_bound_command bound = {};
+    bound.clip = (struct clip*)123;
+    bound.cmd = &cmd;
+    bound.context = (void*)11223344;
+    bound.argc = 0;
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback((struct clip*)123, &cmd, 0, _, (struct clip_out*)789, (void*)11223344))
+        .WillOnce(Return(-3));
+    EXPECT_CALL(*ClipOut_Mock::get(), clip_out_flush((struct clip_out*)789));
+
+    EXPECT_EQ(clip_cmd_invoke(&bound, (struct clip_out*)789), -3);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_invoke__noOut)
+{
+    struct clip_command cmd = {};
+    cmd.callback = test_clip_command_callback;
+
+    struct clip_bound_command bound = {};
+    bound.clip = (struct clip*)123;
+    bound.cmd = &cmd;
+    bound.context = (void*)11223344;
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback((struct clip*)123, &cmd, 0, _, nullptr, (void*)11223344));
+    EXPECT_CALL(*ClipOut_Mock::get(), clip_out_flush(_)).Times(0);
+
+    EXPECT_EQ(clip_cmd_invoke(&bound, nullptr), 0);
+}
+
+TEST_F(ClipCmdCallTest, clip_cmd_call_check_arg)
+{
+    struct clip_arg data = {};
+    data.type = CLIP_ARG_TYPE_HEXARRAY;
+    data.check = CLIP_ARG_CHECK_CRC16;
+    struct clip_arg crc = {};
+    crc.type = CLIP_ARG_TYPE_UINT;
+    struct clip_arg text = {};
+    text.type = CLIP_ARG_TYPE_STRING;
+
+    struct clip_arg_value av = {};
+    clip_arg_check_t check = CLIP_ARG_CHECK_NONE;
+
+    // checked binary argument followed by matching checksum
+    EXPECT_EQ(clip_cmd_call_check_arg(&data, &av, &check, 0), CLIP_ARG_ERROR_NO_ERROR);
+    EXPECT_EQ(check, CLIP_ARG_CHECK_CRC16);
+    av.type = CLIP_ARG_TYPE_UINT;
+    av.val_uint = 0x1234;
+    EXPECT_EQ(clip_cmd_call_check_arg(&crc, &av, &check, 0x1234), CLIP_ARG_ERROR_NO_ERROR);
+    EXPECT_EQ(check, CLIP_ARG_CHECK_NONE);
+
+    // not checked UINT argument
+    EXPECT_EQ(clip_cmd_call_check_arg(&crc, &av, &check, 0), CLIP_ARG_ERROR_NO_ERROR);
+
+    // wrong checksum
+    check = CLIP_ARG_CHECK_CRC16;
+    EXPECT_EQ(clip_cmd_call_check_arg(&crc, &av, &check, 0x1235), CLIP_ARG_ERROR_CHECKSUM);
+
+    // checksum argument missing
+    check = CLIP_ARG_CHECK_CRC16;
+    EXPECT_EQ(clip_cmd_call_check_arg(&text, &av, &check, 0x1234), CLIP_ARG_ERROR_CHECKSUM);
+    check = CLIP_ARG_CHECK_CRC16;
+    EXPECT_EQ(clip_cmd_call_check_arg(nullptr, &av, &check, 0x1234), CLIP_ARG_ERROR_CHECKSUM);
+    EXPECT_EQ(check, CLIP_ARG_CHECK_NONE);
 }
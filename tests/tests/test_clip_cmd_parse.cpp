@@ -30,11 +30,13 @@ SOFTWARE.
 #include "mock_clip_notify.hpp"
 #include "mock_clip_utils_arg.hpp"
 #include "mock_clip_cmd_call.hpp"
+#include "mock_clip_out.hpp"
 
 using ::testing::_;
 using ::testing::Test;
 using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::InSequence;
 
 class ClipCmdParseTest : public Test
 {
@@ -44,6 +46,7 @@ protected:
         ClipNotify_Mock::create();
         ClipUtilsArg_Mock::create();
         ClipCmdCall_Mock::create();
+        ClipOut_Mock::create();
     }
 
     virtual void TearDown()
@@ -51,6 +54,7 @@ protected:
         ClipNotify_Mock::destroy();
         ClipUtilsArg_Mock::destroy();
         ClipCmdCall_Mock::destroy();
+        ClipOut_Mock::destroy();
     }
 };
 
@@ -59,7 +63,7 @@ TEST_F(ClipCmdParseTest, clip_cmd_parse_line__callCommandCallback)
     struct clip_command cmd = {};
     const struct clip_command *commands[1] = {nullptr};
 
-    EXPECT_CALL(*ClipCmdCall_Mock::get(), clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)456, (void*)11223344))
+    EXPECT_CALL(*ClipCmdCall_Mock::get(), clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)456, _, (void*)11223344, _))
         .Times(2);
 
     cmd.commands = nullptr;
@@ -79,7 +83,7 @@ TEST_F(ClipCmdParseTest, clip_cmd_parse_line__callCommandCallback_nested)
     const char *name = "test";
     const char *ret_name = "abcd";
 
-    EXPECT_CALL(*ClipCmdCall_Mock::get(), clip_cmd_call_command_callback((struct clip*)123, &subcmd, (char*)ret_name, (void*)11223344));
+    EXPECT_CALL(*ClipCmdCall_Mock::get(), clip_cmd_call_command_callback((struct clip*)123, &subcmd, (char*)ret_name, _, (void*)11223344, _));
 
     EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)456))
         .WillOnce(Invoke([=](char **cmd_name, char *cmd_line)->char* {
@@ -100,7 +104,7 @@ TEST_F(ClipCmdParseTest, clip_cmd_parse_line__notifyEventHelp_notRoot)
     EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_help((struct clip*)123, (void*)11223344, &cmd, commands));
     EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)456))
         .WillOnce(Invoke([](char **cmd_name, char *cmd_line)->char* {
-            *cmd_name = CLIP_CONFIG_HELP_COMMAND;
+            *cmd_name = (char*)CLIP_CONFIG_HELP_COMMAND;
             return (char*)"\0";
         }));
 
@@ -117,7 +121,7 @@ TEST_F(ClipCmdParseTest, clip_cmd_parse_line__notifyEventHelp_root)
     EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_help(&self, (void*)11223344, nullptr, commands));
     EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, (char*)456))
         .WillOnce(Invoke([](char **cmd_name, char *cmd_line)->char* {
-            *cmd_name = CLIP_CONFIG_HELP_COMMAND;
+            *cmd_name = (char*)CLIP_CONFIG_HELP_COMMAND;
             return (char*)"\0";
         }));
 
@@ -161,3 +165,64 @@ TEST_F(ClipCmdParseTest, clip_cmd_parse_line__notifyEventCommandNotFound_root)
 
     clip_cmd_parse_line(&self, nullptr, (char*)456, (void*)11223344);
 }
+
+TEST_F(ClipCmdParseTest, clip_cmd_parse_line_ex__result)
+{
+    struct clip self = {};
+    struct clip_command subcmd = {};
+    subcmd.name = "aaa";
+    const struct clip_command *commands[2] = {&subcmd, nullptr};
+    self.commands = commands;
+    char line[] = "xx test";
+    char *name = &line[3];
+
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_command_not_found(&self, (void*)11223344, nullptr, name));
+    EXPECT_CALL(*ClipNotify_Mock::get(), clip_notify_event_help(&self, (void*)11223344, nullptr, commands));
+    EXPECT_CALL(*ClipUtilsArg_Mock::get(), clip_utils_arg_get_first(_, line))
+        .WillOnce(Invoke([=](char **cmd_name, char *cmd_line)->char* {
+            *cmd_name = name;
+            return (char*)"\0";
+        }))
+        .WillOnce(Invoke([=](char **cmd_name, char *cmd_line)->char* {
+            *cmd_name = (char*)CLIP_CONFIG_HELP_COMMAND;
+            return (char*)"\0";
+        }));
+
+    struct clip_result result = {};
+    EXPECT_EQ(clip_cmd_parse_line_ex(&self, nullptr, line, nullptr, (void*)11223344, &result), CLIP_STATUS_COMMAND_NOT_FOUND);
+    EXPECT_EQ(result.status, CLIP_STATUS_COMMAND_NOT_FOUND);
+    EXPECT_EQ(result.cmd, nullptr);
+    EXPECT_EQ(result.token, name);
+    EXPECT_EQ(result.offset, 3U);
+
+    EXPECT_EQ(clip_cmd_parse_line_ex(&self, nullptr, line, nullptr, (void*)11223344, nullptr), CLIP_STATUS_HELP);
+}
+
+TEST_F(ClipCmdParseTest, clip_cmd_parse_line_ex__flushOut)
+{
+    struct clip_command cmd = {};
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipCmdCall_Mock::get(), clip_cmd_call_command_callback((struct clip*)123, &cmd, (char*)456, (struct clip_out*)789, (void*)11223344, _));
+    EXPECT_CALL(*ClipOut_Mock::get(), clip_out_flush((struct clip_out*)789));
+
+    clip_cmd_parse_line_ex((struct clip*)123, &cmd, (char*)456, (struct clip_out*)789, (void*)11223344, nullptr);
+}
+
+TEST_F(ClipCmdParseTest, clip_cmd_bind__bindCommand)
+{
+    struct clip_command cmd = {};
+    struct clip_bound_command bound = {};
+
+    EXPECT_CALL(*ClipCmdCall_Mock::get(), clip_cmd_call_command_callback(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*ClipCmdCall_Mock::get(), clip_cmd_call_bind_command((struct clip*)123, &cmd, (char*)456, (void*)11223344, _, &bound))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, char *cmd_line, void *context, struct clip_result *result, struct clip_bound_command *bound) {
+            result->status = CLIP_STATUS_BOUND;
+        }));
+    EXPECT_CALL(*ClipOut_Mock::get(), clip_out_flush((struct clip_out*)789));
+
+    struct clip_result result = {};
+    EXPECT_EQ(clip_cmd_bind((struct clip*)123, &cmd, (char*)456, (struct clip_out*)789, (void*)11223344, &bound, &result), CLIP_STATUS_BOUND);
+    EXPECT_EQ(result.status, CLIP_STATUS_BOUND);
+}
@@ -0,0 +1,239 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "clip.h"
+
+using ::testing::Test;
+
+class ClipCompleteTest : public Test
+{
+protected:
+    struct clip_arg arg_pin = {};
+    struct clip_arg arg_state = {};
+    const struct clip_arg *set_args[3] = {&arg_pin, &arg_state, nullptr};
+    const struct clip_arg *get_args[2] = {&arg_pin, nullptr};
+
+    struct clip_command cmd_gpio = {};
+    struct clip_command cmd_gpio_set = {};
+    struct clip_command cmd_gpio_get = {};
+    struct clip_command cmd_go = {};
+    struct clip_command cmd_adc = {};
+    struct clip_command cmd_led = {};
+    struct clip_command cmd_led_on = {};
+    struct clip_command cmd_led_off = {};
+    const struct clip_command *gpio_commands[3] = {&cmd_gpio_set, &cmd_gpio_get, nullptr};
+    const struct clip_command *led_commands[3] = {&cmd_led_on, &cmd_led_off, nullptr};
+    const struct clip_command *root_commands[5] = {&cmd_gpio, &cmd_led, &cmd_go, &cmd_adc, nullptr};
+    struct clip clip = {};
+
+    struct clip_index_entry entries[32];
+    struct clip_index index;
+    const struct clip_command *names[16];
+    struct clip_complete_range ranges[16];
+    struct clip_complete complete;
+
+    virtual void SetUp()
+    {
+        arg_pin.name = "pin";
+        arg_pin.type = CLIP_ARG_TYPE_UINT;
+        arg_state.name = "state";
+        arg_state.type = CLIP_ARG_TYPE_BOOL;
+        cmd_gpio.name = "gpio";
+        cmd_gpio_set.name = "set";
+        cmd_gpio_get.name = "get";
+        cmd_go.name = "go";
+        cmd_adc.name = "adc";
+        cmd_led.name = "led strip";
+        cmd_led_on.name = "on";
+        cmd_led_off.name = "off";
+        cmd_gpio.commands = gpio_commands;
+        cmd_gpio_set.args = set_args;
+        cmd_gpio_get.args = get_args;
+        cmd_led.commands = led_commands;
+        clip.commands = root_commands;
+
+        ASSERT_TRUE(clip_index_init(&index, &clip, entries, 32));
+        ASSERT_TRUE(clip_complete_init(&complete, &index, names, 16, ranges, 16));
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    std::vector<std::string> candidates(const std::string &line, struct clip_completion *result = nullptr)
+    {
+        struct clip_candidate table[8];
+        struct clip_completion local_result;
+        if (result == nullptr)
+            result = &local_result;
+
+        size_t num = clip_complete_line(&complete, line.c_str(), line.length(), table, 8, result);
+        std::vector<std::string> texts;
+        for (size_t i = 0; i < num; i++) {
+            if (table[i].text != nullptr) {
+                texts.push_back(table[i].text);
+            } else {
+                texts.push_back(std::string("<") + table[i].arg->name + ">");
+            }
+        }
+        return texts;
+    }
+};
+
+TEST_F(ClipCompleteTest, clip_complete_init)
+{
+    EXPECT_EQ(ranges[0].first, 0U);
+    EXPECT_EQ(ranges[0].num, 4U);
+    EXPECT_EQ(names[0], &cmd_adc);
+    EXPECT_EQ(names[1], &cmd_go);
+    EXPECT_EQ(names[2], &cmd_gpio);
+    EXPECT_EQ(names[3], &cmd_led);
+
+    size_t gpio = clip_index_get_id(&index, &cmd_gpio);
+    EXPECT_EQ(ranges[gpio].num, 2U);
+    EXPECT_EQ(names[ranges[gpio].first], &cmd_gpio_get);
+    EXPECT_EQ(names[ranges[gpio].first + 1], &cmd_gpio_set);
+    EXPECT_EQ(ranges[clip_index_get_id(&index, &cmd_go)].num, 0U);
+
+    // too small tables
+    EXPECT_FALSE(clip_complete_init(&complete, &index, names, 7, ranges, 16));
+    EXPECT_FALSE(clip_complete_init(&complete, &index, names, 16, ranges, 3));
+}
+
+TEST_F(ClipCompleteTest, clip_complete_init__sharedList)
+{
+    // the same subcommands list under two parents is sorted once
+    cmd_adc.commands = gpio_commands;
+    ASSERT_TRUE(clip_index_init(&index, &clip, entries, 32));
+    ASSERT_TRUE(clip_complete_init(&complete, &index, names, 8, ranges, 16));
+
+    size_t gpio = clip_index_get_id(&index, &cmd_gpio);
+    size_t adc = clip_index_get_id(&index, &cmd_adc);
+    EXPECT_EQ(ranges[adc].first, ranges[gpio].first);
+    EXPECT_EQ(ranges[adc].num, 2U);
+    EXPECT_EQ(candidates("adc "), std::vector<std::string>({"get", "set"}));
+    EXPECT_EQ(candidates("gpio s"), std::vector<std::string>({"set"}));
+}
+
+TEST_F(ClipCompleteTest, clip_complete_init__sharedCommand)
+{
+    // "led strip" command (with subcommands) shared by root and "adc" is sorted once: 4 + 2 + 1 + 2 names
+    const struct clip_command *adc_commands[2] = {&cmd_led, nullptr};
+    cmd_adc.commands = adc_commands;
+    ASSERT_TRUE(clip_index_init(&index, &clip, entries, 32));
+    ASSERT_TRUE(clip_complete_init(&complete, &index, names, 9, ranges, 16));
+    EXPECT_EQ(candidates("adc \"led strip\" o"), std::vector<std::string>({"off", "on"}));
+
+    // different list starting with the same command is sorted separately
+    const struct clip_command *set_commands[2] = {&cmd_gpio_set, nullptr};
+    cmd_adc.commands = set_commands;
+    ASSERT_TRUE(clip_index_init(&index, &clip, entries, 32));
+    ASSERT_TRUE(clip_complete_init(&complete, &index, names, 16, ranges, 16));
+    EXPECT_EQ(candidates("adc "), std::vector<std::string>({"set"}));
+    EXPECT_EQ(candidates("gpio "), std::vector<std::string>({"get", "set"}));
+}
+
+TEST_F(ClipCompleteTest, clip_complete_line__commands)
+{
+    struct clip_completion result;
+
+    EXPECT_EQ(candidates("", &result), std::vector<std::string>({"adc", "go", "gpio", "led strip"}));
+    EXPECT_EQ(result.num, 4U);
+    EXPECT_EQ(result.common, 0U);
+
+    EXPECT_EQ(candidates("  g", &result), std::vector<std::string>({"go", "gpio"}));
+    EXPECT_EQ(result.token, 2U);
+    EXPECT_EQ(result.prefix_len, 1U);
+    EXPECT_EQ(result.common, 1U);
+
+    EXPECT_EQ(candidates("gp", &result), std::vector<std::string>({"gpio"}));
+    EXPECT_EQ(result.common, 4U);
+
+    EXPECT_EQ(candidates("gpio ", &result), std::vector<std::string>({"get", "set"}));
+    EXPECT_EQ(result.token, 5U);
+    EXPECT_EQ(candidates("gpio  s"), std::vector<std::string>({"set"}));
+    EXPECT_EQ(candidates("x"), std::vector<std::string>({}));
+    EXPECT_EQ(candidates("gpiox "), std::vector<std::string>({}));
+    EXPECT_EQ(candidates("go "), std::vector<std::string>({}));
+}
+
+TEST_F(ClipCompleteTest, clip_complete_line__quoted)
+{
+    struct clip_completion result;
+
+    EXPECT_EQ(candidates("\"led s", &result), std::vector<std::string>({"led strip"}));
+    EXPECT_TRUE(result.quoted);
+    EXPECT_EQ(result.prefix_len, 5U);
+    EXPECT_EQ(candidates("\"led strip\" o"), std::vector<std::string>({"off", "on"}));
+    EXPECT_EQ(candidates("led\\ "), std::vector<std::string>({}));
+}
+
+TEST_F(ClipCompleteTest, clip_complete_line__arguments)
+{
+    struct clip_completion result;
+
+    EXPECT_EQ(candidates("gpio set ", &result), std::vector<std::string>({"<pin>"}));
+    EXPECT_EQ(result.num, 1U);
+    EXPECT_EQ(result.common, 0U);
+    EXPECT_EQ(candidates("gpio set 12 "), std::vector<std::string>({"0", "1"}));
+    EXPECT_EQ(candidates("gpio set 12 1"), std::vector<std::string>({"1"}));
+    EXPECT_EQ(candidates("gpio set 12 \"1 2\" "), std::vector<std::string>({}));
+    EXPECT_EQ(candidates("gpio get 1 "), std::vector<std::string>({}));
+}
+
+TEST_F(ClipCompleteTest, clip_complete_line__bigList)
+{
+    std::vector<std::string> names_text;
+    std::vector<struct clip_command> commands(2000);
+    std::vector<const struct clip_command*> list;
+    for (size_t i = 0; i < commands.size(); i++)
+        names_text.push_back("cmd" + std::to_string((i * 7919) % commands.size()));
+    for (size_t i = 0; i < commands.size(); i++) {
+        commands[i].name = names_text[i].c_str();
+        list.push_back(&commands[i]);
+    }
+    list.push_back(nullptr);
+    clip.commands = list.data();
+
+    std::vector<struct clip_index_entry> big_entries(4096);
+    std::vector<const struct clip_command*> big_names(2000);
+    std::vector<struct clip_complete_range> big_ranges(2001);
+    ASSERT_TRUE(clip_index_init(&index, &clip, big_entries.data(), big_entries.size()));
+    ASSERT_TRUE(clip_complete_init(&complete, &index, big_names.data(), big_names.size(), big_ranges.data(), big_ranges.size()));
+
+    for (size_t i = 1; i < big_names.size(); i++)
+        EXPECT_LT(strcmp(big_names[i - 1]->name, big_names[i]->name), 0);
+
+    struct clip_completion result;
+    EXPECT_EQ(candidates("cmd123", &result), std::vector<std::string>({"cmd123", "cmd1230", "cmd1231", "cmd1232", "cmd1233", "cmd1234", "cmd1235", "cmd1236"}));
+    EXPECT_EQ(result.num, 11U);
+    EXPECT_EQ(result.common, 6U);
+    EXPECT_EQ(candidates("cmd1999"), std::vector<std::string>({"cmd1999"}));
+}
@@ -42,6 +42,7 @@ using ::testing::FloatEq;
 using ::testing::StrEq;
 using ::testing::Eq;
 using ::testing::AllOf;
+using ::testing::AnyNumber;
 
 class ClipE2ETest : public Test
 {
@@ -206,6 +207,7 @@ TEST_F(ClipE2ETest, e2e__cmdArgsParsing)
             IsCommand_Name(cmd_name),
             _,
             _,
+            _,
             callCtx)
         ).With(Args<3, 2>(ElementsAreArray(argsMatchers)));
 
@@ -417,6 +419,99 @@ TEST_F(ClipE2ETest, e2e__cmdArgsError)
     }
 }
 
+TEST_F(ClipE2ETest, e2e__result)
+{
+    char buf[128];
+    void *callCtx = (void*)12345678;
+
+    std::vector<std::tuple<std::string, clip_status_t, std::string, clip_arg_error_t, int, size_t>> testCases = {
+        {"cmd1 def", CLIP_STATUS_OK, "def", CLIP_ARG_ERROR_NO_ERROR, 0, 0},
+        {"cmd1 def", CLIP_STATUS_COMMAND_ERROR, "def", CLIP_ARG_ERROR_NO_ERROR, 7, 0},
+        {"cmd1 ?", CLIP_STATUS_HELP, "cmd1", CLIP_ARG_ERROR_NO_ERROR, 0, 5},
+        {"cmd1  abc  xx", CLIP_STATUS_COMMAND_NOT_FOUND, "abc", CLIP_ARG_ERROR_NO_ERROR, 0, 11},
+        {"cmd2 abc test 0 x", CLIP_STATUS_ARGUMENTS_ERROR, "abc", CLIP_ARG_ERROR_PARSE_INT, 0, 16},
+        {"cmd2 abc test 0 -1 2", CLIP_STATUS_ARGUMENTS_ERROR, "abc", CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS, 0, 20},
+    };
+
+    for (auto ts : testCases) {
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, _, _, callCtx))
+            .Times(AnyNumber());
+        EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, _, _, _, _, callCtx))
+            .WillRepeatedly(Return(std::get<4>(ts)));
+
+        struct clip_result result;
+        strcpy(buf, std::get<0>(ts).c_str());
+        EXPECT_EQ(clip_cmd_parse_line_ex(&g_clip, NULL, buf, nullptr, callCtx, &result), std::get<1>(ts));
+        EXPECT_EQ(result.status, std::get<1>(ts));
+        EXPECT_STREQ(result.cmd->name, std::get<2>(ts).c_str());
+        EXPECT_EQ(result.error, std::get<3>(ts));
+        EXPECT_EQ(result.code, std::get<4>(ts));
+        if (std::get<1>(ts) != CLIP_STATUS_OK && std::get<1>(ts) != CLIP_STATUS_COMMAND_ERROR) {
+            EXPECT_EQ(result.token, &buf[std::get<5>(ts)]);
+            EXPECT_EQ(result.offset, std::get<5>(ts));
+        } else {
+            EXPECT_EQ(result.token, nullptr);
+        }
+    }
+}
+
+TEST_F(ClipE2ETest, e2e__pending)
+{
+    char buf[128];
+    void *callCtx = (void*)12345678;
+    struct clip_pending token = {};
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, callCtx))
+        .Times(2);
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, _, 0, _, nullptr, callCtx))
+        .WillOnce(Invoke([&](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)->int {
+            EXPECT_STREQ(cmd->name, "def");
+            return clip_cmd_pend(&token, self, cmd, out, context);
+        }))
+        .WillOnce(Return(0));
+
+    struct clip_result result;
+    strcpy(buf, "cmd1 def");
+    EXPECT_EQ(clip_cmd_parse_line_ex(&g_clip, NULL, buf, nullptr, callCtx, &result), CLIP_STATUS_PENDING);
+    EXPECT_STREQ(result.cmd->name, "def");
+    EXPECT_TRUE(clip_cmd_is_pending(&token));
+
+    strcpy(buf, "cmd1 abc a2");
+    EXPECT_EQ(clip_cmd_parse_line_ex(&g_clip, NULL, buf, nullptr, callCtx, &result), CLIP_STATUS_OK);
+    EXPECT_TRUE(clip_cmd_is_pending(&token));
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(
+        &g_clip,
+        CLIP_EVENT_COMMAND_COMPLETE,
+        IsEqualClipEventArg_CommandComplete(token.cmd, -3),
+        callCtx)
+    );
+
+    clip_cmd_complete(&token, -3);
+    EXPECT_FALSE(clip_cmd_is_pending(&token));
+}
+
+TEST_F(ClipE2ETest, e2e__usage)
+{
+    char buf[128];
+    const struct clip_command *abc = ((const clip_command*)&g_cmd2)->commands[0];
+    const struct clip_command *xyz = ((const clip_command*)&g_cmd2)->commands[1];
+
+    EXPECT_EQ(abc->usage, nullptr);
+    clip_utils_arg_get_command_usage_string(buf, sizeof(buf), abc);
+    EXPECT_STREQ(buf, "abc <a:STRING> <b:BOOL> <c:INT> <d:UINT> <e:FLOAT> <f:HEXARRAY>");
+
+    EXPECT_STREQ(xyz->usage, "xyz <a:INT>");
+    clip_utils_arg_get_command_usage_string(buf, sizeof(buf), xyz);
+    EXPECT_STREQ(buf, "xyz <a:INT>");
+
+    // precomputed usage must be the same as generated one
+    struct clip_command generated = *xyz;
+    generated.usage = nullptr;
+    clip_utils_arg_get_command_usage_string(buf, sizeof(buf), &generated);
+    EXPECT_STREQ(buf, xyz->usage);
+}
+
 TEST_F(ClipE2ETest, e2e__context)
 {
     EXPECT_EQ(g_clip.context, (void*)11223344);
@@ -433,3 +528,121 @@ TEST_F(ClipE2ETest, e2e__eventCallback)
 {
     EXPECT_EQ(g_clip.event_callback, test_clip_event_callback);
 }
+
+TEST_F(ClipE2ETest, e2e__bindInvoke)
+{
+    char buf[128];
+    void *callCtx = (void*)12345678;
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(
+        &g_clip,
+        CLIP_EVENT_CALL_COMMAND_CALLBACK,
+        IsEventArg_CallCommandCallback("xyz", "-7 tail"),
+        callCtx)
+    );
+
+    strcpy(buf, "cmd2 xyz -7 tail");
+    struct clip_bound_command bound = {};
+    struct clip_result result = {};
+    EXPECT_EQ(clip_cmd_bind(&g_clip, NULL, buf, NULL, callCtx, &bound, &result), CLIP_STATUS_BOUND);
+    EXPECT_EQ(result.status, CLIP_STATUS_BOUND);
+    EXPECT_STREQ(result.cmd->name, "xyz");
+    EXPECT_EQ(bound.argc, 2U);
+
+    // command callback is called only on invoke, possibly much later
+    std::vector<IsArgMatcherP<CmdArg>> argsMatchers = { IsArg(CmdArg {(int32_t)-7}), IsArg(CmdArg {"tail"}) };
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(
+        &g_clip,
+        IsCommand_Name("xyz"),
+        _,
+        _,
+        _,
+        callCtx)
+    ).With(Args<3, 2>(ElementsAreArray(argsMatchers))).WillOnce(Return(-2));
+
+    EXPECT_EQ(clip_cmd_invoke(&bound, NULL), -2);
+}
+
+TEST_F(ClipE2ETest, e2e__bindNotFound)
+{
+    char buf[128];
+    void *callCtx = (void*)12345678;
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_COMMAND_NOT_FOUND, _, callCtx));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(_, _, _, _, _, _)).Times(0);
+
+    strcpy(buf, "cmd2 nope");
+    struct clip_bound_command bound = {};
+    EXPECT_EQ(clip_cmd_bind(&g_clip, NULL, buf, NULL, callCtx, &bound, NULL), CLIP_STATUS_COMMAND_NOT_FOUND);
+}
+
+struct PipelineOutput {
+    std::string data;
+    size_t flushes;
+};
+
+static void test_clip_e2e_pipeline_sink(struct clip_out *self, const char *data, size_t size)
+{
+    auto output = static_cast<PipelineOutput*>(self->context);
+    output->data.append(data, size);
+    output->flushes++;
+}
+
+TEST_F(ClipE2ETest, e2e__pipeline)
+{
+    void *callCtx = (void*)12345678;
+    std::vector<std::tuple<clip_pipeline_policy_t, std::vector<std::string>, clip_status_t, size_t>> testCases = {
+        {CLIP_PIPELINE_STOP_ON_ERROR, {"xyz", "def"}, CLIP_STATUS_ARGUMENTS_ERROR, 38},
+        {CLIP_PIPELINE_CONTINUE, {"xyz", "def", "a2"}, CLIP_STATUS_ARGUMENTS_ERROR, 38},
+    };
+
+    for (auto ts : testCases) {
+        char buf[128] = "cmd2 xyz 1;;cmd1 def \"a;b\" ; cmd2 xyz x; cmd1 abc a2 ";
+        char out_buf[64];
+        struct clip_out out;
+        PipelineOutput output = {};
+        clip_out_init(&out, out_buf, sizeof(out_buf), test_clip_e2e_pipeline_sink, &output);
+
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, _, _, callCtx)).Times(AnyNumber());
+        for (auto &name : std::get<1>(ts)) {
+            EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name(name.c_str()), _, _, &out, callCtx))
+                .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context) {
+                    clip_out_put_str(out, cmd->name);
+                    clip_out_put_str(out, "\n");
+                    return 0;
+                }));
+        }
+
+        struct clip_result result = {};
+        EXPECT_EQ(clip_cmd_parse_pipeline(&g_clip, buf, &out, callCtx, std::get<0>(ts), &result), std::get<2>(ts));
+        EXPECT_EQ(result.status, CLIP_STATUS_ARGUMENTS_ERROR);
+        EXPECT_STREQ(result.cmd->name, "xyz");
+        EXPECT_STREQ(result.token, "x");
+        EXPECT_EQ(result.offset, std::get<3>(ts));
+
+        // all responses are flushed together
+        std::string expected;
+        for (auto &name : std::get<1>(ts))
+            expected += name + "\n";
+        EXPECT_EQ(output.data, expected);
+        EXPECT_EQ(output.flushes, 1U);
+
+        ::testing::Mock::VerifyAndClearExpectations(ClipCommandCallback_Mock::get());
+        ::testing::Mock::VerifyAndClearExpectations(ClipEventCallback_Mock::get());
+    }
+}
+
+TEST_F(ClipE2ETest, e2e__pipeline__noErrors)
+{
+    void *callCtx = (void*)12345678;
+    char buf[128] = "cmd1 def; cmd1 abc a3";
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, _, _, callCtx)).Times(AnyNumber());
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("def"), _, _, _, callCtx));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("a3"), _, _, _, callCtx))
+        .WillOnce(Return(CLIP_COMMAND_PENDING));
+
+    struct clip_result result = {};
+    EXPECT_EQ(clip_cmd_parse_pipeline(&g_clip, buf, NULL, callCtx, CLIP_PIPELINE_STOP_ON_ERROR, &result), CLIP_STATUS_PENDING);
+    EXPECT_STREQ(result.cmd->name, "a3");
+}
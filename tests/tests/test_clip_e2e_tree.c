@@ -25,7 +25,7 @@ SOFTWARE.
 #include "clip.h"
 
 extern void test_clip_event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context);
-extern void test_clip_command_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], void *context);
+extern int test_clip_command_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
 
 CLIP_DEF_ROOT_COMMAND(g_cmd1, "cmd1", "cmd2 description", NULL)
     CLIP_DEF_COMMAND("abc", "abc command", test_clip_command_callback)
@@ -52,7 +52,7 @@ CLIP_DEF_ROOT_COMMAND(g_cmd2, "cmd2", "cmd2 description", NULL)
         CLIP_DEF_ARGUMENT("e", "e argument", CLIP_ARG_TYPE_FLOAT)
         CLIP_DEF_ARGUMENT("f", "f argument", CLIP_ARG_TYPE_HEXARRAY)
     CLIP_DEF_COMMAND_END_WITH_ARGS()
-    CLIP_DEF_COMMAND("xyz", "xyz command", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+    CLIP_DEF_COMMAND_WITH_USAGE("xyz", "xyz command", test_clip_command_callback, CLIP_USAGE_ARG("a", INT)) CLIP_DEF_WITH_ARGS()
         CLIP_DEF_ARGUMENT("a", "a argument", CLIP_ARG_TYPE_INT)
     CLIP_DEF_COMMAND_END_WITH_ARGS()
 CLIP_DEF_ROOT_COMMAND_END()
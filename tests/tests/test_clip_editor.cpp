@@ -0,0 +1,234 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "clip.h"
+
+#include "mock_clip_cmd_parse.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+
+#define KEY_UP      "\x1B[A"
+#define KEY_DOWN    "\x1B[B"
+#define KEY_RIGHT   "\x1B[C"
+#define KEY_LEFT    "\x1B[D"
+#define KEY_HOME    "\x1B[H"
+#define KEY_END     "\x1B[4~"
+#define KEY_DELETE  "\x1B[3~"
+
+static void test_string_sink(struct clip_out *self, const char *data, size_t size)
+{
+    ((std::string*)self->context)->append(data, size);
+}
+
+class ClipEditorTest : public Test
+{
+protected:
+    char buf[16];
+    char history_buf[32];
+    std::string echo_text;
+    struct clip_out echo;
+    struct clip_history history;
+    struct clip_reader reader;
+
+    virtual void SetUp()
+    {
+        ClipCmdParse_Mock::create();
+
+        clip_out_init(&echo, nullptr, 0, test_string_sink, &echo_text);
+        clip_history_init(&history, history_buf, sizeof(history_buf));
+        clip_reader_init(&reader, buf, sizeof(buf), &echo);
+        clip_reader_set_history(&reader, &history);
+    }
+
+    virtual void TearDown()
+    {
+        ClipCmdParse_Mock::destroy();
+    }
+
+    std::vector<std::string> put(const std::string &data)
+    {
+        std::vector<std::string> lines;
+        for (auto ch : data) {
+            char *line = clip_reader_put_char(&reader, ch);
+            if (line != nullptr)
+                lines.push_back(line);
+        }
+        return lines;
+    }
+};
+
+TEST_F(ClipEditorTest, clip_reader_put_char__insertAtCursor)
+{
+    EXPECT_EQ(put("abd" KEY_LEFT "c"), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "abd\bcd\b");
+    EXPECT_EQ(reader.cursor, 3U);
+
+    echo_text.clear();
+    EXPECT_EQ(put("\b\r\n"), std::vector<std::string>({"abd"}));
+    EXPECT_EQ(echo_text, "\bd \b\b\r\n");
+}
+
+TEST_F(ClipEditorTest, clip_reader_put_char__homeEndDelete)
+{
+    EXPECT_EQ(put("xbc" KEY_HOME KEY_DELETE "a" KEY_END "d\n"), std::vector<std::string>({"abcd"}));
+    EXPECT_EQ(echo_text, "xbc\b\b\bbc \b\b\babc\b\bbcd\r\n");
+
+    // long moves use escape sequence, unknown sequences and modifiers are ignored
+    echo_text.clear();
+    EXPECT_EQ(put("0123456" KEY_HOME "\x1B[1;5C" "\x1B[2~" "\x1BOF" "7\n"), std::vector<std::string>({"01234567"}));
+    EXPECT_EQ(echo_text, "0123456\x1B[7D" "0" "1234567\r\n");
+}
+
+TEST_F(ClipEditorTest, clip_reader_put_char__historyRecall)
+{
+    EXPECT_EQ(put("one\ntwo\n"), std::vector<std::string>({"one", "two"}));
+
+    echo_text.clear();
+    EXPECT_EQ(put(KEY_UP), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "two");
+    EXPECT_EQ(put(KEY_UP KEY_UP), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "two\b\b\bone");
+    EXPECT_EQ(put(KEY_DOWN KEY_DOWN), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "two\b\b\bone\b\b\btwo\b\b\b\x1B[K");
+
+    // accepted recalled line is not repeated in history
+    EXPECT_EQ(put(KEY_UP "\r"), std::vector<std::string>({"two"}));
+    EXPECT_EQ(history.lines, 2U);
+}
+
+TEST_F(ClipEditorTest, clip_reader_put_char__recallWithoutCopy)
+{
+    EXPECT_EQ(put("mem read 0 16\n"), std::vector<std::string>({"mem read 0 16"}));
+
+    // edited line is kept in buffer while history is browsed
+    EXPECT_EQ(put("gp" KEY_UP), std::vector<std::string>({}));
+    EXPECT_EQ(reader.len, 2U);
+    EXPECT_EQ(reader.recall, 1U);
+    EXPECT_EQ(put(KEY_DOWN "io\n"), std::vector<std::string>({"gpio"}));
+
+    // recalled line is copied when it's edited
+    echo_text.clear();
+    EXPECT_EQ(put(KEY_UP KEY_UP "\b" "32\n"), std::vector<std::string>({"mem read 0 132"}));
+    EXPECT_EQ(echo_text, "gpio\x1B[4D" "mem read 0 16\b \b32\r\n");
+
+    // the oldest line is overwritten
+    EXPECT_EQ(history.lines, 2U);
+    EXPECT_EQ(put(KEY_UP KEY_UP KEY_UP "\n"), std::vector<std::string>({"gpio"}));
+}
+
+TEST_F(ClipEditorTest, clip_reader_put_char__noHistory)
+{
+    clip_reader_set_history(&reader, nullptr);
+
+    EXPECT_EQ(put("ab" KEY_UP KEY_DOWN "c\n"), std::vector<std::string>({"abc"}));
+    EXPECT_EQ(echo_text, "abc\r\n");
+}
+
+class ClipEditorCompleteTest : public ClipEditorTest
+{
+protected:
+    struct clip_arg arg_pin = {};
+    const struct clip_arg *set_args[2] = {&arg_pin, nullptr};
+    struct clip_command cmd_gpio = {};
+    struct clip_command cmd_gpio_set = {};
+    struct clip_command cmd_go = {};
+    struct clip_command cmd_led = {};
+    struct clip_command cmd_led_on = {};
+    struct clip_command cmd_led_off = {};
+    const struct clip_command *gpio_commands[2] = {&cmd_gpio_set, nullptr};
+    const struct clip_command *led_commands[3] = {&cmd_led_on, &cmd_led_off, nullptr};
+    const struct clip_command *root_commands[4] = {&cmd_gpio, &cmd_led, &cmd_go, nullptr};
+    struct clip clip = {};
+
+    struct clip_index_entry entries[16];
+    struct clip_index index;
+    const struct clip_command *names[8];
+    struct clip_complete_range ranges[8];
+    struct clip_complete complete;
+
+    virtual void SetUp()
+    {
+        ClipEditorTest::SetUp();
+
+        arg_pin.name = "pin";
+        arg_pin.type = CLIP_ARG_TYPE_UINT;
+        cmd_gpio.name = "gpio";
+        cmd_gpio_set.name = "set";
+        cmd_go.name = "go";
+        cmd_led.name = "led strip";
+        cmd_led_on.name = "on";
+        cmd_led_off.name = "off";
+        cmd_gpio.commands = gpio_commands;
+        cmd_gpio_set.args = set_args;
+        cmd_led.commands = led_commands;
+        clip.commands = root_commands;
+
+        ASSERT_TRUE(clip_index_init(&index, &clip, entries, 16));
+        ASSERT_TRUE(clip_complete_init(&complete, &index, names, 8, ranges, 8));
+        clip_reader_set_complete(&reader, &complete);
+        reader.prompt = "> ";
+    }
+};
+
+TEST_F(ClipEditorCompleteTest, clip_reader_put_char__completeSingle)
+{
+    EXPECT_EQ(put("gp\t"), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "gpio ");
+    EXPECT_EQ(put("s\t1\n"), std::vector<std::string>({"gpio set 1"}));
+}
+
+TEST_F(ClipEditorCompleteTest, clip_reader_put_char__completeList)
+{
+    EXPECT_EQ(put("g\t"), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "g\r\ngo  gpio  \r\n> g");
+
+    echo_text.clear();
+    EXPECT_EQ(put("pio set \t"), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "pio set \r\n<pin:UINT>  \r\n> gpio set ");
+
+    EXPECT_EQ(put("\n"), std::vector<std::string>({"gpio set "}));
+
+    // token before cursor is completed
+    EXPECT_EQ(put("gp set 1" KEY_HOME KEY_RIGHT KEY_RIGHT "\t\n"), std::vector<std::string>({"gpio  set 1"}));
+}
+
+TEST_F(ClipEditorCompleteTest, clip_reader_put_char__completeQuoted)
+{
+    EXPECT_EQ(put("le\t"), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "le\b \b\b \b\"led strip\" ");
+
+    echo_text.clear();
+    EXPECT_EQ(put("o\t"), std::vector<std::string>({}));
+    EXPECT_EQ(echo_text, "o\r\noff  on  \r\n> \"led strip\" o");
+    EXPECT_EQ(put("n\t\n"), std::vector<std::string>({"\"led strip\" on "}));
+
+    EXPECT_EQ(put("\"led s\t\n"), std::vector<std::string>({"\"led strip\" "}));
+}
@@ -0,0 +1,479 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "clip.h"
+
+#include "mock_clip_event_callback.hpp"
+#include "mock_clip_command_callback.hpp"
+#include "mock_clip_stream_callback.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::InSequence;
+
+extern "C" const struct clip g_clip;
+extern "C" const struct clip_command g_mem_cmd;
+
+MATCHER_P(IsCommand_Name, cmd_name, "Equality matcher for command name")
+{
+    return strcmp(arg->name, cmd_name) == 0;
+}
+
+static std::vector<std::vector<uint8_t>> g_frames;
+
+static void test_clip_frame_sink(struct clip_frame *self, const uint8_t *data, size_t size)
+{
+    g_frames.push_back(std::vector<uint8_t>(data, data + size));
+}
+
+static std::vector<uint8_t> encode(const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> frame(data.size() + CLIP_FRAME_COBS_OVERHEAD(data.size()));
+    frame.resize(clip_frame_cobs_encode(frame.data(), data.data(), data.size()));
+    frame.push_back(CLIP_FRAME_DELIMITER);
+    return frame;
+}
+
+static std::vector<uint8_t> decode(std::vector<uint8_t> frame)
+{
+    size_t len = 0;
+    EXPECT_EQ(frame.back(), CLIP_FRAME_DELIMITER);
+    frame.pop_back();
+    EXPECT_TRUE(clip_frame_cobs_decode(frame.data(), frame.size(), &len));
+    frame.resize(len);
+    return frame;
+}
+
+static void put_u32(std::vector<uint8_t> &data, uint32_t val)
+{
+    for (size_t i = 0; i < 4; i++)
+        data.push_back(val >> (i * 8));
+}
+
+static std::vector<uint8_t> request(uint8_t seq, uint16_t id)
+{
+    return {seq, (uint8_t)id, (uint8_t)(id >> 8)};
+}
+
+static void put_uint(std::vector<uint8_t> &data, uint32_t val)
+{
+    data.push_back(CLIP_ARG_TYPE_UINT);
+    put_u32(data, val);
+}
+
+static void put_hexarray(std::vector<uint8_t> &data, clip_arg_type_t type, const std::vector<uint8_t> &bytes)
+{
+    data.push_back(type);
+    if (bytes.size() < 0x80) {
+        data.push_back(bytes.size());
+    } else {
+        data.push_back(0x80 | 4);
+        put_u32(data, bytes.size());
+    }
+    data.insert(data.end(), bytes.begin(), bytes.end());
+}
+
+static size_t schema_get_str(const std::string &schema, size_t pos, std::string *str)
+{
+    size_t end = schema.find('\0', pos);
+    if (str != nullptr)
+        *str = schema.substr(pos, end - pos);
+    return end + 1;
+}
+
+static size_t schema_get_u16(const std::string &schema, size_t pos, uint16_t *val)
+{
+    *val = (uint8_t)schema[pos] | ((uint8_t)schema[pos + 1] << 8);
+    return pos + 2;
+}
+
+// walks binary schema commands list (layout from "clip_schema_put_binary") and finds ID of named command
+static size_t schema_find_id(const std::string &schema, size_t pos, const std::string &name, uint16_t *id)
+{
+    uint16_t commands_num;
+    pos = schema_get_u16(schema, pos, &commands_num);
+    for (uint16_t i = 0; i < commands_num; i++) {
+        uint16_t cmd_id, args_num;
+        std::string cmd_name;
+        pos = schema_get_u16(schema, pos, &cmd_id);
+        pos = schema_get_str(schema, pos, &cmd_name);
+        pos = schema_get_str(schema, pos, nullptr) + 1;
+        if (cmd_name == name)
+            *id = cmd_id;
+
+        pos = schema_get_u16(schema, pos, &args_num);
+        for (uint16_t a = 0; a < args_num; a++)
+            pos = schema_get_str(schema, schema_get_str(schema, pos, nullptr), nullptr) + 3;
+        pos = schema_find_id(schema, pos, name, id);
+    }
+    return pos;
+}
+
+class ClipFrameTest : public Test
+{
+protected:
+    struct clip_index_entry entries[16];
+    struct clip_index index;
+    const struct clip_command *commands[8];
+    uint8_t rx[600];
+    uint8_t tx[32];
+    struct clip_frame frame;
+
+    virtual void SetUp()
+    {
+        ClipEventCallback_Mock::create();
+        ClipCommandCallback_Mock::create();
+        ClipStreamCallback_Mock::create();
+
+        g_frames.clear();
+        ASSERT_TRUE(clip_index_init(&index, &g_clip, entries, sizeof(entries) / sizeof(entries[0])));
+        ASSERT_TRUE(clip_frame_init(&frame, &g_clip, &index, commands, sizeof(commands) / sizeof(commands[0]), rx, sizeof(rx), tx, sizeof(tx), test_clip_frame_sink, (void*)12345678));
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, _, _, (void*)12345678))
+            .Times(::testing::AnyNumber());
+    }
+
+    virtual void TearDown()
+    {
+        ClipEventCallback_Mock::destroy();
+        ClipCommandCallback_Mock::destroy();
+        ClipStreamCallback_Mock::destroy();
+    }
+
+    size_t feed(const std::vector<uint8_t> &data)
+    {
+        std::vector<uint8_t> encoded = encode(data);
+        return clip_frame_feed(&frame, encoded.data(), encoded.size());
+    }
+};
+
+TEST_F(ClipFrameTest, cobs_roundtrip)
+{
+    std::vector<std::vector<uint8_t>> test_cases = {
+        {},
+        {0x00},
+        {0x00, 0x00},
+        {0x11, 0x22, 0x00, 0x33},
+        {0x11, 0x00},
+        std::vector<uint8_t>(253, 0x01),
+        std::vector<uint8_t>(254, 0x01),
+        std::vector<uint8_t>(255, 0x01),
+        std::vector<uint8_t>(600, 0xAA),
+    };
+    std::vector<uint8_t> mixed;
+    for (size_t i = 0; i < 1000; i++)
+        mixed.push_back(i % 300);
+    test_cases.push_back(mixed);
+
+    for (auto &t : test_cases) {
+        std::vector<uint8_t> encoded = encode(t);
+        EXPECT_LE(encoded.size(), t.size() + CLIP_FRAME_COBS_OVERHEAD(t.size()) + 1);
+        for (size_t i = 0; i + 1 < encoded.size(); i++)
+            ASSERT_NE(encoded[i], 0);
+        EXPECT_EQ(decode(encoded), t);
+    }
+}
+
+TEST_F(ClipFrameTest, cobs_encode_in_place)
+{
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < 700; i++)
+        data.push_back((i % 257 == 0) ? 0 : (i & 0xFF) | 1);
+
+    size_t reserve = CLIP_FRAME_COBS_OVERHEAD(data.size()) + 1;
+    std::vector<uint8_t> buf(reserve);
+    buf.insert(buf.end(), data.begin(), data.end());
+    size_t size = clip_frame_cobs_encode(buf.data(), &buf[reserve], data.size());
+    buf.resize(size);
+    buf.push_back(CLIP_FRAME_DELIMITER);
+
+    EXPECT_EQ(decode(buf), data);
+}
+
+TEST_F(ClipFrameTest, cobs_decode_broken)
+{
+    std::vector<std::vector<uint8_t>> test_cases = {
+        {0x00},
+        {0x03, 0x11},
+        {0x02, 0x11, 0x00},
+        {0xFF, 0x01},
+    };
+
+    for (auto &t : test_cases) {
+        size_t len = 0;
+        EXPECT_FALSE(clip_frame_cobs_decode(t.data(), t.size(), &len));
+    }
+}
+
+TEST_F(ClipFrameTest, init_too_small)
+{
+    const struct clip_command *small[2];
+    uint8_t small_tx[4];
+
+    EXPECT_FALSE(clip_frame_init(&frame, &g_clip, &index, small, sizeof(small) / sizeof(small[0]), rx, sizeof(rx), tx, sizeof(tx), test_clip_frame_sink, nullptr));
+    EXPECT_FALSE(clip_frame_init(&frame, &g_clip, &index, commands, sizeof(commands) / sizeof(commands[0]), rx, sizeof(rx), small_tx, sizeof(small_tx), test_clip_frame_sink, nullptr));
+}
+
+TEST_F(ClipFrameTest, call_command)
+{
+    std::vector<uint8_t> req = request(0x42, clip_index_get_id(&index, g_mem_cmd.commands[1]));
+    put_uint(req, 0x08001000);
+    put_uint(req, 16);
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context) {
+            EXPECT_EQ(argv[0].type, CLIP_ARG_TYPE_UINT);
+            EXPECT_EQ(argv[0].val_uint, 0x08001000);
+            EXPECT_EQ(argv[1].val_uint, 16);
+            clip_out_put_str(out, "ok");
+            return 0;
+        }));
+
+    EXPECT_EQ(feed(req), 1);
+    ASSERT_EQ(g_frames.size(), 1);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{0x42, CLIP_STATUS_OK, 'o', 'k'}));
+    EXPECT_EQ(frame.dropped, 0);
+}
+
+TEST_F(ClipFrameTest, schema_id)
+{
+    // host takes command ID from schema, not from "clip_index_get_id"
+    std::string schema;
+    char schema_buf[16];
+    struct clip_out schema_out;
+    clip_out_init(&schema_out, schema_buf, sizeof(schema_buf), [](struct clip_out *self, const char *data, size_t size) {
+        static_cast<std::string*>(self->context)->append(data, size);
+    }, &schema);
+    clip_schema_put_binary(&schema_out, &index);
+    clip_out_flush(&schema_out);
+
+    uint16_t id = 0;
+    schema_find_id(schema, schema_get_str(schema, 5, nullptr), "read", &id);
+    ASSERT_NE(id, 0);
+
+    std::vector<uint8_t> req = request(0x24, id);
+    put_uint(req, 0x100);
+    put_uint(req, 4);
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678))
+        .WillOnce(Return(0));
+
+    EXPECT_EQ(feed(req), 1);
+    ASSERT_EQ(g_frames.size(), 1);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{0x24, CLIP_STATUS_OK}));
+}
+
+TEST_F(ClipFrameTest, command_error)
+{
+    std::vector<uint8_t> req = request(7, clip_index_get_id(&index, g_mem_cmd.commands[1]));
+    put_uint(req, 0);
+    put_uint(req, 1);
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678))
+        .WillOnce(Return(-5));
+
+    EXPECT_EQ(feed(req), 1);
+    ASSERT_EQ(g_frames.size(), 1);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{7, CLIP_STATUS_COMMAND_ERROR}));
+}
+
+TEST_F(ClipFrameTest, checked_hexarray)
+{
+    std::vector<uint8_t> data = {0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02};
+    uint32_t crc = clip_utils_crc_calc(CLIP_ARG_CHECK_CRC16, data.data(), data.size());
+    uint16_t id = clip_index_get_id(&index, g_mem_cmd.commands[2]);
+
+    std::vector<uint8_t> req = request(1, id);
+    put_uint(req, 0x100);
+    put_hexarray(req, CLIP_ARG_TYPE_HEXARRAY, data);
+    put_uint(req, crc);
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("write"), 3, _, _, (void*)12345678))
+        .WillOnce(Invoke([data](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context) {
+            uint8_t *bytes = nullptr;
+            size_t size = clip_utils_arg_unpack_hexarray(&bytes, argv[1].val_hexarray);
+            EXPECT_EQ(argv[1].type, CLIP_ARG_TYPE_HEXARRAY);
+            EXPECT_EQ(std::vector<uint8_t>(bytes, bytes + size), data);
+            return 0;
+        }));
+    EXPECT_EQ(feed(req), 1);
+
+    req = request(2, id);
+    put_uint(req, 0x100);
+    put_hexarray(req, CLIP_ARG_TYPE_HEXARRAY, data);
+    put_uint(req, crc ^ 1);
+    EXPECT_EQ(feed(req), 1);
+
+    ASSERT_EQ(g_frames.size(), 2);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{1, CLIP_STATUS_OK}));
+    EXPECT_EQ(decode(g_frames[1]), (std::vector<uint8_t>{2, CLIP_STATUS_ARGUMENTS_ERROR, 2, CLIP_ARG_ERROR_CHECKSUM}));
+}
+
+TEST_F(ClipFrameTest, invalid_checksum_layout)
+{
+    std::vector<uint8_t> data = {0xDE, 0xAD, 0xBE, 0xEF};
+
+    for (auto cmd : {g_mem_cmd.commands[4], g_mem_cmd.commands[5]}) {
+        std::vector<uint8_t> req = request(1, clip_index_get_id(&index, cmd));
+        put_hexarray(req, CLIP_ARG_TYPE_HEXARRAY, data);
+        EXPECT_DEATH(feed(req), "clip_utils_arg_has_checksum") << cmd->name;
+    }
+}
+
+TEST_F(ClipFrameTest, arguments_errors)
+{
+    uint16_t id = clip_index_get_id(&index, g_mem_cmd.commands[1]);
+    std::vector<std::tuple<std::vector<uint8_t>, std::vector<uint8_t>>> test_cases = {
+        {{CLIP_ARG_TYPE_UINT, 1, 0, 0, 0}, {1, CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS}},
+        {{CLIP_ARG_TYPE_UINT, 1, 0, 0, 0, CLIP_ARG_TYPE_INT, 1, 0, 0, 0}, {1, CLIP_ARG_ERROR_TYPE_MISMATCH}},
+        {{CLIP_ARG_TYPE_UINT, 1, 0, 0, 0, CLIP_ARG_TYPE_UINT, 1, 0}, {1, CLIP_ARG_ERROR_PARSE_UINT}},
+        {{CLIP_ARG_TYPE_STRING, '1', 0}, {0, CLIP_ARG_ERROR_TYPE_MISMATCH}},
+    };
+
+    for (auto &t : test_cases) {
+        std::vector<uint8_t> req = request(9, id);
+        req.insert(req.end(), std::get<0>(t).begin(), std::get<0>(t).end());
+        std::vector<uint8_t> expected = {9, CLIP_STATUS_ARGUMENTS_ERROR};
+        expected.insert(expected.end(), std::get<1>(t).begin(), std::get<1>(t).end());
+
+        g_frames.clear();
+        EXPECT_EQ(feed(req), 1);
+        ASSERT_EQ(g_frames.size(), 1);
+        EXPECT_EQ(decode(g_frames[0]), expected);
+    }
+}
+
+TEST_F(ClipFrameTest, extra_arguments)
+{
+    std::vector<uint8_t> req = request(3, clip_index_get_id(&index, g_mem_cmd.commands[1]));
+    put_uint(req, 1);
+    put_uint(req, 2);
+    req.insert(req.end(), {CLIP_ARG_TYPE_BOOL, 1, CLIP_ARG_TYPE_STRING, 'a', 'b'});
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 4, _, _, (void*)12345678))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context) {
+            EXPECT_EQ(argv[2].type, CLIP_ARG_TYPE_BOOL);
+            EXPECT_TRUE(argv[2].val_bool);
+            EXPECT_EQ(argv[3].type, CLIP_ARG_TYPE_STRING);
+            EXPECT_STREQ(argv[3].val_str, "ab");
+            return 0;
+        }));
+
+    EXPECT_EQ(feed(req), 1);
+    ASSERT_EQ(g_frames.size(), 1);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{3, CLIP_STATUS_OK}));
+}
+
+TEST_F(ClipFrameTest, command_not_found)
+{
+    EXPECT_EQ(feed(request(1, 0)), 1);
+    EXPECT_EQ(feed(request(2, clip_index_get_id(&index, &g_mem_cmd))), 1);
+    EXPECT_EQ(feed(request(3, 1000)), 1);
+
+    ASSERT_EQ(g_frames.size(), 3);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{1, CLIP_STATUS_COMMAND_NOT_FOUND}));
+    EXPECT_EQ(decode(g_frames[1]), (std::vector<uint8_t>{2, CLIP_STATUS_COMMAND_NOT_FOUND}));
+    EXPECT_EQ(decode(g_frames[2]), (std::vector<uint8_t>{3, CLIP_STATUS_COMMAND_NOT_FOUND}));
+}
+
+TEST_F(ClipFrameTest, stream_argument)
+{
+    std::vector<uint8_t> data(300);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = i;
+
+    std::vector<uint8_t> req = request(5, clip_index_get_id(&index, g_mem_cmd.commands[0]));
+    put_uint(req, 0x2000);
+    put_hexarray(req, CLIP_ARG_TYPE_HEXSTREAM, data);
+
+    InSequence s;
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, _, (void*)12345678))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context) {
+            EXPECT_EQ(argv[0].val_uint, 0x2000);
+        }));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), data, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 300, CLIP_ARG_ERROR_NO_ERROR, _, (void*)12345678));
+
+    EXPECT_EQ(feed(req), 1);
+    ASSERT_EQ(g_frames.size(), 1);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{5, CLIP_STATUS_OK}));
+}
+
+TEST_F(ClipFrameTest, long_response)
+{
+    std::vector<uint8_t> req = request(6, clip_index_get_id(&index, g_mem_cmd.commands[1]));
+    put_uint(req, 0);
+    put_uint(req, 40);
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context) {
+            for (uint32_t i = 0; i < argv[1].val_uint; i++)
+                clip_out_put_bytes(out, "0123456789" + (i % 10), 1);
+            return 0;
+        }));
+
+    EXPECT_EQ(feed(req), 1);
+    ASSERT_GE(g_frames.size(), 2);
+
+    std::string response;
+    for (size_t i = 0; i < g_frames.size(); i++) {
+        std::vector<uint8_t> f = decode(g_frames[i]);
+        ASSERT_GE(f.size(), 2);
+        EXPECT_EQ(f[0], 6);
+        EXPECT_EQ(f[1], (i + 1 < g_frames.size()) ? CLIP_FRAME_STATUS_MORE : CLIP_STATUS_OK);
+        EXPECT_LE(g_frames[i].size(), sizeof(tx));
+        response.append(f.begin() + 2, f.end());
+    }
+    EXPECT_EQ(response, "0123456789012345678901234567890123456789");
+}
+
+TEST_F(ClipFrameTest, broken_frames)
+{
+    std::vector<uint8_t> stream = {0x00, 0x00, 0x05, 0x11, 0x00, 0x02, 0x11, 0x00};
+    std::vector<uint8_t> long_frame(sizeof(rx) + 1, 0x55);
+    stream.insert(stream.end(), long_frame.begin(), long_frame.end());
+    stream.push_back(CLIP_FRAME_DELIMITER);
+
+    EXPECT_EQ(clip_frame_feed(&frame, stream.data(), stream.size()), 0);
+    EXPECT_EQ(frame.dropped, 3);
+    EXPECT_TRUE(g_frames.empty());
+
+    std::vector<uint8_t> req = request(8, clip_index_get_id(&index, g_mem_cmd.commands[1]));
+    put_uint(req, 0);
+    put_uint(req, 0);
+    std::vector<uint8_t> encoded = encode(req);
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678))
+        .WillOnce(Return(0));
+    for (auto b : encoded)
+        clip_frame_feed(&frame, &b, 1);
+    ASSERT_EQ(g_frames.size(), 1);
+    EXPECT_EQ(decode(g_frames[0]), (std::vector<uint8_t>{8, CLIP_STATUS_OK}));
+}
@@ -0,0 +1,120 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+using ::testing::Test;
+
+extern "C" const struct clip g_clip;
+extern "C" const struct clip_command g_gpio_cmd;
+extern "C" const struct clip_command g_echo_cmd;
+extern "C" const struct clip_command g_deep_cmd;
+
+class ClipHelpTest : public Test
+{
+protected:
+    std::string output;
+    struct clip_out out;
+    char out_buf[16];
+
+    virtual void SetUp()
+    {
+        // buffer smaller than help text, so it is streamed in many chunks
+        clip_out_init(&out, out_buf, sizeof(out_buf), [](struct clip_out *self, const char *data, size_t size) {
+            static_cast<std::string*>(self->context)->append(data, size);
+        }, &output);
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    std::string flush()
+    {
+        clip_out_flush(&out);
+        std::string ret = output;
+        output.clear();
+        return ret;
+    }
+};
+
+TEST_F(ClipHelpTest, clip_help_put_commands)
+{
+    clip_help_put_commands(&out, g_clip.commands, 1);
+    EXPECT_EQ(flush(),
+        "gpio - gpio commands\n"
+        "echo <text:STRING> - echo command\n"
+        "l1 - level 1\n");
+
+    clip_help_put_commands(&out, g_clip.commands, CLIP_HELP_DEPTH_ALL);
+    EXPECT_EQ(flush(),
+        "gpio - gpio commands\n"
+        "  get - get methods\n"
+        "    pin <pin:UINT> - get pin command\n"
+        "  set <pin:UINT> [state:UINT]\n"
+        "echo <text:STRING> - echo command\n"
+        "l1 - level 1\n"
+        "  l2 - level 2\n"
+        "    l3 - level 3\n"
+        "      ...\n");
+
+    clip_help_put_commands(&out, g_gpio_cmd.commands, 2);
+    EXPECT_EQ(flush(),
+        "get - get methods\n"
+        "  pin <pin:UINT> - get pin command\n"
+        "set <pin:UINT> [state:UINT]\n");
+
+    clip_help_put_commands(&out, g_clip.commands, 0);
+    clip_help_put_commands(&out, nullptr, 1);
+    EXPECT_EQ(flush(), "");
+
+    clip_help_put_commands(nullptr, g_clip.commands, 1);
+}
+
+TEST_F(ClipHelpTest, clip_help_put_command)
+{
+    clip_help_put_command(&out, &g_gpio_cmd, 0);
+    EXPECT_EQ(flush(), "gpio - gpio commands\n");
+
+    clip_help_put_command(&out, &g_gpio_cmd, 1);
+    EXPECT_EQ(flush(),
+        "gpio - gpio commands\n"
+        "  get - get methods\n"
+        "  set <pin:UINT> [state:UINT]\n");
+
+    clip_help_put_command(&out, &g_echo_cmd, CLIP_HELP_DEPTH_ALL);
+    EXPECT_EQ(flush(), "echo <text:STRING> - echo command\n");
+
+    // depth is limited by CLIP_CONFIG_HELP_MAX_DEPTH (3 in this test)
+    clip_help_put_command(&out, g_deep_cmd.commands[0], CLIP_HELP_DEPTH_ALL);
+    EXPECT_EQ(flush(),
+        "l2 - level 2\n"
+        "  l3 - level 3\n"
+        "    l4 - level 4\n");
+
+    clip_help_put_command(nullptr, &g_gpio_cmd, 1);
+}
@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "clip.h"
+
+using ::testing::_;
+using ::testing::Test;
+
+static void test_string_sink(struct clip_out *self, const char *data, size_t size)
+{
+    ((std::string*)self->context)->append(data, size);
+}
+
+class ClipHistoryTest : public Test
+{
+protected:
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    void add(struct clip_history *history, const std::string &line)
+    {
+        clip_history_add(history, line.c_str(), line.length());
+    }
+
+    std::vector<std::string> lines(struct clip_history *history)
+    {
+        std::vector<std::string> result;
+        size_t pos;
+        size_t len;
+        for (size_t back = 1; clip_history_find(history, back, &pos, &len); back++) {
+            char buf[32];
+            EXPECT_EQ(clip_history_copy(history, pos, len, buf, sizeof(buf)), len);
+            result.push_back(buf);
+        }
+        return result;
+    }
+};
+
+TEST_F(ClipHistoryTest, clip_history_add__newestFirst)
+{
+    char buf[32];
+    struct clip_history history;
+    clip_history_init(&history, buf, sizeof(buf));
+
+    EXPECT_EQ(lines(&history), std::vector<std::string>({}));
+
+    add(&history, "mem read 0 16");
+    add(&history, "");
+    add(&history, "gpio set 1 1");
+    add(&history, "gpio set 1 1");
+
+    EXPECT_EQ(lines(&history), std::vector<std::string>({"gpio set 1 1", "mem read 0 16"}));
+    EXPECT_EQ(history.lines, 2U);
+    EXPECT_EQ(history.used, 27U);
+}
+
+TEST_F(ClipHistoryTest, clip_history_add__overwriteOldest)
+{
+    char buf[16];
+    struct clip_history history;
+    clip_history_init(&history, buf, sizeof(buf));
+
+    add(&history, "aaaaa");
+    add(&history, "bbbb");
+    add(&history, "ccc");
+    EXPECT_EQ(lines(&history), std::vector<std::string>({"ccc", "bbbb", "aaaaa"}));
+
+    // line wraps around ring end, the oldest line is overwritten
+    add(&history, "dddddd");
+    EXPECT_EQ(lines(&history), std::vector<std::string>({"dddddd", "ccc", "bbbb"}));
+    EXPECT_EQ(history.used, 16U);
+
+    // line bigger than ring is not stored
+    add(&history, "0123456789abcdef");
+    EXPECT_EQ(lines(&history), std::vector<std::string>({"dddddd", "ccc", "bbbb"}));
+
+    add(&history, "0123456789abcde");
+    EXPECT_EQ(lines(&history), std::vector<std::string>({"0123456789abcde"}));
+}
+
+TEST_F(ClipHistoryTest, clip_history_copy__truncate)
+{
+    char buf[16];
+    struct clip_history history;
+    clip_history_init(&history, buf, sizeof(buf));
+
+    add(&history, "0123456789");
+    add(&history, "abcdefgh");
+
+    size_t pos;
+    size_t len;
+    ASSERT_TRUE(clip_history_find(&history, 1, &pos, &len));
+    EXPECT_EQ(len, 8U);
+
+    char line[5];
+    EXPECT_EQ(clip_history_copy(&history, pos, len, line, sizeof(line)), 4U);
+    EXPECT_EQ(std::string(line), "abcd");
+}
+
+TEST_F(ClipHistoryTest, clip_history_put__wrapped)
+{
+    char buf[12];
+    struct clip_history history;
+    clip_history_init(&history, buf, sizeof(buf));
+
+    add(&history, "12345678");
+    add(&history, "abcdef");
+
+    std::string text;
+    struct clip_out out;
+    clip_out_init(&out, nullptr, 0, test_string_sink, &text);
+
+    size_t pos;
+    size_t len;
+    ASSERT_TRUE(clip_history_find(&history, 1, &pos, &len));
+    EXPECT_EQ(pos, 9U);
+    clip_history_put(&history, pos, len, &out);
+    EXPECT_EQ(text, "abcdef");
+    EXPECT_FALSE(clip_history_find(&history, 2, &pos, &len));
+}
@@ -0,0 +1,286 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "clip.hpp"
+
+#include "mock_clip_command_callback.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+
+MATCHER_P(IsCommand_Name, cmd_name, "Equality matcher for command name")
+{
+    return strcmp(arg->name, cmd_name) == 0;
+}
+
+static const struct clip_arg_stream g_stream = {};
+
+static constexpr auto g_tree_def = clip_cpp::root(
+    clip_cpp::command("mem", "memory commands", nullptr,
+        clip_cpp::command("write", "write command", test_clip_command_callback,
+            clip_cpp::arg("address", "address argument", CLIP_ARG_TYPE_UINT),
+            clip_cpp::checked_arg("data", "data argument", CLIP_ARG_TYPE_HEXARRAY, CLIP_ARG_CHECK_CRC16),
+            clip_cpp::arg("crc", "checksum argument", CLIP_ARG_TYPE_UINT)),
+        clip_cpp::command("flash", "flash command", nullptr,
+            clip_cpp::arg("address", "address argument", CLIP_ARG_TYPE_UINT),
+            clip_cpp::stream_arg("data", "data argument", &g_stream)),
+        clip_cpp::command("read", "read command", test_clip_command_callback,
+            clip_cpp::arg("address", "address argument", CLIP_ARG_TYPE_UINT),
+            clip_cpp::opt_arg("size", "size argument", CLIP_ARG_TYPE_UINT))),
+    clip_cpp::command("zeta", "last command", test_clip_command_callback),
+    clip_cpp::command("adc", "adc commands", nullptr,
+        clip_cpp::command("read", "read command", test_clip_command_callback,
+            clip_cpp::arg("channel", "channel argument", CLIP_ARG_TYPE_UINT))),
+    clip_cpp::command("beta", "beta command", test_clip_command_callback)
+);
+
+using g_tree = clip_cpp::tree<g_tree_def>;
+
+static const struct clip g_clip = g_tree::root((void*)11223344);
+
+static_assert(g_tree::max_argc == 3);
+static_assert(g_tree::commands_num == 4);
+
+static constexpr auto g_duplicated_def = clip_cpp::root(
+    clip_cpp::command("gpio", nullptr, nullptr,
+        clip_cpp::command("set", nullptr, nullptr),
+        clip_cpp::command("set", nullptr, nullptr)));
+static_assert(clip_cpp::detail::names_valid(g_tree_def.commands));
+static_assert(!clip_cpp::detail::names_valid(g_duplicated_def.commands));
+static_assert(!clip_cpp::detail::names_valid(clip_cpp::root(clip_cpp::command(CLIP_CONFIG_HELP_COMMAND, nullptr, nullptr)).commands));
+
+static constexpr auto g_unordered_def = clip_cpp::root(
+    clip_cpp::command("set", nullptr, nullptr,
+        clip_cpp::opt_arg("pin", nullptr, CLIP_ARG_TYPE_UINT),
+        clip_cpp::arg("state", nullptr, CLIP_ARG_TYPE_BOOL)));
+static_assert(clip_cpp::detail::tree_args_ordered(g_tree_def.commands));
+static_assert(!clip_cpp::detail::tree_args_ordered(g_unordered_def.commands));
+
+static_assert(clip_cpp::detail::tree_args_checked(g_tree_def.commands));
+static_assert(!clip_cpp::detail::tree_args_checked(clip_cpp::root(clip_cpp::command("load", nullptr, nullptr,
+    clip_cpp::checked_arg("data", nullptr, CLIP_ARG_TYPE_HEXARRAY, CLIP_ARG_CHECK_CRC16))).commands));
+static_assert(!clip_cpp::detail::tree_args_checked(clip_cpp::root(clip_cpp::command("store", nullptr, nullptr,
+    clip_cpp::checked_arg("data", nullptr, CLIP_ARG_TYPE_HEXARRAY, CLIP_ARG_CHECK_CRC16),
+    clip_cpp::opt_arg("crc", nullptr, CLIP_ARG_TYPE_UINT))).commands));
+static_assert(!clip_cpp::detail::tree_args_checked(clip_cpp::root(clip_cpp::command("dump", nullptr, nullptr,
+    clip_cpp::checked_arg("data", nullptr, CLIP_ARG_TYPE_HEXARRAY, CLIP_ARG_CHECK_CRC16),
+    clip_cpp::arg("crc", nullptr, CLIP_ARG_TYPE_STRING))).commands));
+
+class ClipHppTest : public Test
+{
+protected:
+    virtual void SetUp()
+    {
+        ClipCommandCallback_Mock::create();
+    }
+
+    virtual void TearDown()
+    {
+        ClipCommandCallback_Mock::destroy();
+    }
+};
+
+static std::vector<std::string> names(const struct clip_command **commands)
+{
+    std::vector<std::string> result;
+    while (*commands != nullptr)
+        result.push_back((*commands++)->name);
+    return result;
+}
+
+TEST_F(ClipHppTest, layout)
+{
+    EXPECT_EQ(g_clip.context, (void*)11223344);
+    EXPECT_EQ(g_clip.commands_num, 4);
+    EXPECT_EQ(names(g_clip.commands), (std::vector<std::string>{"adc", "beta", "mem", "zeta"}));
+
+    const struct clip_command *mem = g_clip.commands[2];
+    EXPECT_STREQ(mem->description, "memory commands");
+    EXPECT_EQ(mem->callback, nullptr);
+    EXPECT_EQ(mem->args, nullptr);
+    EXPECT_EQ(mem->commands_num, 3);
+    EXPECT_EQ(names(mem->commands), (std::vector<std::string>{"flash", "read", "write"}));
+
+    const struct clip_command *write = mem->commands[2];
+    EXPECT_EQ(write->callback, test_clip_command_callback);
+    EXPECT_EQ(write->commands, nullptr);
+    EXPECT_EQ(write->commands_num, 0);
+    ASSERT_NE(write->args, nullptr);
+    EXPECT_STREQ(write->args[0]->name, "address");
+    EXPECT_EQ(write->args[1]->type, CLIP_ARG_TYPE_HEXARRAY);
+    EXPECT_EQ(write->args[1]->check, CLIP_ARG_CHECK_CRC16);
+    EXPECT_EQ(write->args[2]->type, CLIP_ARG_TYPE_UINT);
+    EXPECT_EQ(write->args[3], nullptr);
+
+    const struct clip_command *flash = mem->commands[0];
+    EXPECT_EQ(flash->args[1]->type, CLIP_ARG_TYPE_HEXSTREAM);
+    EXPECT_EQ(flash->args[1]->stream, &g_stream);
+
+    const struct clip_command *read = mem->commands[1];
+    EXPECT_FALSE(read->args[0]->optional);
+    EXPECT_TRUE(read->args[1]->optional);
+}
+
+TEST_F(ClipHppTest, dispatch_sorted)
+{
+    std::vector<std::tuple<std::string, std::optional<std::string>, clip_status_t>> test_cases = {
+        {"adc read 1", "read", CLIP_STATUS_OK},
+        {"beta", "beta", CLIP_STATUS_OK},
+        {"zeta", "zeta", CLIP_STATUS_OK},
+        {"mem read 0x100 4", "read", CLIP_STATUS_OK},
+        {"mem write 1 01 0xF1D1", "write", CLIP_STATUS_OK},
+        {"aaa", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"bet", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"betaa", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"zz", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"mem erase", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"mem", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+    };
+
+    for (auto &t : test_cases) {
+        char line[64];
+        struct clip_result result = {};
+        strcpy(line, std::get<0>(t).c_str());
+
+        if (std::get<1>(t).has_value()) {
+            EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name(std::get<1>(t).value().c_str()), _, _, _, nullptr))
+                .WillOnce(Return(0));
+        }
+        EXPECT_EQ(clip_cmd_parse_line_ex(&g_clip, nullptr, line, nullptr, nullptr, &result), std::get<2>(t)) << std::get<0>(t);
+        ::testing::Mock::VerifyAndClearExpectations(ClipCommandCallback_Mock::get());
+    }
+}
+
+static std::vector<std::string> g_calls;
+
+static void gpio_set(uint32_t pin, bool state)
+{
+    g_calls.push_back("gpio_set " + std::to_string(pin) + " " + std::to_string(state));
+}
+
+static int mem_write(struct clip_out *out, uint32_t address, clip_cpp::bytes data, uint32_t crc)
+{
+    clip_out_put_str(out, "written ");
+    clip_out_put_u32(out, (uint32_t)data.size);
+    g_calls.push_back("mem_write " + std::to_string(address) + " " + std::string(data.begin(), data.end()));
+    return (address == 0) ? -1 : 0;
+}
+
+static int adc_read(const clip_cpp::call &call, int16_t channel, std::optional<float> gain, std::optional<std::string_view> label)
+{
+    std::string text = "adc_read " + std::string(call.cmd->name) + " " + std::to_string(channel);
+    if (gain.has_value())
+        text += " " + std::to_string(gain.value());
+    if (label.has_value())
+        text += " " + std::string(label.value());
+    g_calls.push_back(text);
+    return 0;
+}
+
+static void reset() noexcept
+{
+    g_calls.push_back("reset");
+}
+
+static constexpr auto g_typed_def = clip_cpp::root(
+    clip_cpp::command("gpio", "gpio commands", nullptr,
+        clip_cpp::command<&gpio_set>("set", "set pin state", clip_cpp::param("pin", "pin number"), clip_cpp::param("state", "pin state"))),
+    clip_cpp::command<&mem_write>("write", "write memory",
+        clip_cpp::param("address"), clip_cpp::param("data", "data to write", CLIP_ARG_CHECK_CRC16), clip_cpp::param("crc")),
+    clip_cpp::command<&adc_read>("adc", "read adc", clip_cpp::param("channel"), clip_cpp::param("gain"), clip_cpp::param("label")),
+    clip_cpp::command<&reset>("reset", "reset device")
+);
+
+using g_typed_tree = clip_cpp::tree<g_typed_def>;
+
+static const struct clip g_typed_clip = g_typed_tree::root();
+
+static_assert(g_typed_tree::max_argc == 3);
+static_assert(clip_cpp::detail::tree_args_ordered(g_typed_def.commands));
+
+TEST_F(ClipHppTest, typed_layout)
+{
+    EXPECT_EQ(names(g_typed_clip.commands), (std::vector<std::string>{"adc", "gpio", "reset", "write"}));
+
+    const struct clip_command *adc = g_typed_clip.commands[0];
+    EXPECT_EQ(adc->args[0]->type, CLIP_ARG_TYPE_INT);
+    EXPECT_FALSE(adc->args[0]->optional);
+    EXPECT_EQ(adc->args[1]->type, CLIP_ARG_TYPE_FLOAT);
+    EXPECT_TRUE(adc->args[1]->optional);
+    EXPECT_EQ(adc->args[2]->type, CLIP_ARG_TYPE_STRING);
+    EXPECT_TRUE(adc->args[2]->optional);
+    EXPECT_EQ(adc->args[3], nullptr);
+
+    const struct clip_command *set = g_typed_clip.commands[1]->commands[0];
+    EXPECT_STREQ(set->args[0]->name, "pin");
+    EXPECT_STREQ(set->args[0]->description, "pin number");
+    EXPECT_EQ(set->args[0]->type, CLIP_ARG_TYPE_UINT);
+    EXPECT_EQ(set->args[1]->type, CLIP_ARG_TYPE_BOOL);
+
+    const struct clip_command *write = g_typed_clip.commands[3];
+    EXPECT_EQ(write->args[1]->type, CLIP_ARG_TYPE_HEXARRAY);
+    EXPECT_EQ(write->args[1]->check, CLIP_ARG_CHECK_CRC16);
+
+    EXPECT_EQ(g_typed_clip.commands[2]->args, nullptr);
+}
+
+TEST_F(ClipHppTest, typed_dispatch)
+{
+    std::vector<std::tuple<std::string, clip_status_t, std::string, std::string>> test_cases = {
+        {"gpio set 3 1", CLIP_STATUS_OK, "gpio_set 3 1", ""},
+        {"gpio set 3", CLIP_STATUS_ARGUMENTS_ERROR, "", ""},
+        {"gpio set 3 x", CLIP_STATUS_ARGUMENTS_ERROR, "", ""},
+        {"write 16 4142 0x4B74", CLIP_STATUS_OK, "mem_write 16 AB", "written 2"},
+        {"write 0 4142 0x4B74", CLIP_STATUS_COMMAND_ERROR, "mem_write 0 AB", "written 2"},
+        {"write 16 4142 0x4B75", CLIP_STATUS_ARGUMENTS_ERROR, "", ""},
+        {"adc -2", CLIP_STATUS_OK, "adc_read adc -2", ""},
+        {"adc 5 0.5", CLIP_STATUS_OK, "adc_read adc 5 0.500000", ""},
+        {"adc 5 2 \"in 1\"", CLIP_STATUS_OK, "adc_read adc 5 2.000000 in 1", ""},
+        {"reset", CLIP_STATUS_OK, "reset", ""},
+    };
+
+    for (auto &t : test_cases) {
+        char line[64];
+        char buf[32];
+        std::string output;
+        struct clip_out out;
+        clip_out_init(&out, buf, sizeof(buf), [](struct clip_out *self, const char *data, size_t size) {
+            static_cast<std::string*>(self->context)->append(data, size);
+        }, &output);
+
+        g_calls.clear();
+        strcpy(line, std::get<0>(t).c_str());
+        EXPECT_EQ(clip_cmd_parse_line_ex(&g_typed_clip, nullptr, line, &out, nullptr, nullptr), std::get<1>(t)) << std::get<0>(t);
+        EXPECT_EQ(g_calls, std::get<2>(t).empty() ? std::vector<std::string>{} : std::vector<std::string>{std::get<2>(t)}) << std::get<0>(t);
+        EXPECT_EQ(output, std::get<3>(t)) << std::get<0>(t);
+    }
+}
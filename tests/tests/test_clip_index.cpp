@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+using ::testing::Test;
+
+class ClipIndexTest : public Test
+{
+protected:
+    struct clip_command cmd_a = {};
+    struct clip_command cmd_a1 = {};
+    struct clip_command cmd_a2 = {};
+    struct clip_command cmd_b = {};
+    const struct clip_command *a_commands[3] = {&cmd_a1, &cmd_a2, nullptr};
+    const struct clip_command *root_commands[3] = {&cmd_a, &cmd_b, nullptr};
+    struct clip clip = {};
+    struct clip_index_entry entries[16];
+    struct clip_index index;
+
+    virtual void SetUp()
+    {
+        cmd_a.commands = a_commands;
+        clip.commands = root_commands;
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+TEST_F(ClipIndexTest, clip_index_init)
+{
+    EXPECT_TRUE(clip_index_init(&index, &clip, entries, 16));
+    EXPECT_EQ(index.clip, &clip);
+    EXPECT_EQ(index.entries, entries);
+    EXPECT_EQ(index.size, 16);
+    EXPECT_EQ(index.count, 5);
+}
+
+TEST_F(ClipIndexTest, clip_index_init__tooSmall)
+{
+    EXPECT_TRUE(clip_index_init(&index, &clip, entries, 5));
+    EXPECT_FALSE(clip_index_init(&index, &clip, entries, 4));
+    EXPECT_FALSE(clip_index_init(&index, &clip, entries, 1));
+}
+
+TEST_F(ClipIndexTest, clip_index_get_id)
+{
+    for (size_t size : {5, 7, 16}) {
+        clip_index_init(&index, &clip, entries, size);
+
+        EXPECT_EQ(clip_index_get_id(&index, nullptr), 0);
+        EXPECT_EQ(clip_index_get_id(&index, &cmd_a), 1);
+        EXPECT_EQ(clip_index_get_id(&index, &cmd_a1), 2);
+        EXPECT_EQ(clip_index_get_id(&index, &cmd_a2), 3);
+        EXPECT_EQ(clip_index_get_id(&index, &cmd_b), 4);
+        EXPECT_EQ(clip_index_get_id(&index, (struct clip_command*)&clip), CLIP_INDEX_INVALID_ID);
+    }
+}
+
+TEST_F(ClipIndexTest, clip_index_get_command)
+{
+    clip_index_init(&index, &clip, entries, 16);
+
+    EXPECT_EQ(clip_index_get_command(&index, 0), nullptr);
+    EXPECT_EQ(clip_index_get_command(&index, 1), &cmd_a);
+    EXPECT_EQ(clip_index_get_command(&index, 2), &cmd_a1);
+    EXPECT_EQ(clip_index_get_command(&index, 3), &cmd_a2);
+    EXPECT_EQ(clip_index_get_command(&index, 4), &cmd_b);
+    EXPECT_EQ(clip_index_get_command(&index, 5), nullptr);
+}
+
+TEST_F(ClipIndexTest, clip_index_walk)
+{
+    std::vector<std::tuple<const struct clip_command*, const struct clip_command*, size_t>> visited;
+
+    clip_index_init(&index, &clip, entries, 16);
+    clip_index_walk(&index, [](const struct clip_index *index, const struct clip_path *path, size_t id, void *context) {
+        auto v = (std::vector<std::tuple<const struct clip_command*, const struct clip_command*, size_t>>*)context;
+        v->push_back({path->cmd, (path->parent != nullptr) ? path->parent->cmd : nullptr, id});
+    }, &visited);
+
+    EXPECT_EQ(visited, (std::vector<std::tuple<const struct clip_command*, const struct clip_command*, size_t>>{
+        {nullptr, nullptr, 0},
+        {&cmd_a, nullptr, 1},
+        {&cmd_a1, &cmd_a, 2},
+        {&cmd_a2, &cmd_a, 3},
+        {&cmd_b, nullptr, 4},
+    }));
+}
@@ -28,11 +28,13 @@ SOFTWARE.
 #include "clip.h"
 
 #include "mock_clip_event_callback.hpp"
+#include "mock_clip_event_handlers.hpp"
 
 using ::testing::_;
 using ::testing::Test;
 using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::StrEq;
 
 class ClipNotifyTest : public Test
 {
@@ -40,10 +42,12 @@ protected:
     virtual void SetUp()
     {
         ClipEventCallback_Mock::create();
+        ClipEventHandlers_Mock::create();
     }
 
     virtual void TearDown()
     {
+        ClipEventHandlers_Mock::destroy();
         ClipEventCallback_Mock::destroy();
     }
 };
@@ -108,6 +112,21 @@ TEST_F(ClipNotifyTest, clip_notify_event_call_command_callback)
     clip_notify_event_call_command_callback(&self, (void*)123, (struct clip_command*)456, "test");
 }
 
+TEST_F(ClipNotifyTest, clip_notify_event_command_complete)
+{
+    struct clip self = {};
+    self.event_callback = test_clip_event_callback;
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(
+        &self,
+        CLIP_EVENT_COMMAND_COMPLETE,
+        IsEqualClipEventArg_CommandComplete((struct clip_command*)456, 111),
+        (void*)123)
+    );
+
+    clip_notify_event_command_complete(&self, (void*)123, (struct clip_command*)456, 111);
+}
+
 TEST_F(ClipNotifyTest, clip_notify_event_help__null)
 {
     struct clip self = {};
@@ -135,3 +154,86 @@ TEST_F(ClipNotifyTest, clip_notify_event_call_command_callback__null)
 
     clip_notify_event_call_command_callback(&self, (void*)123, (struct clip_command*)456, "test");
 }
+
+TEST_F(ClipNotifyTest, clip_notify_event_command_complete__null)
+{
+    struct clip self = {};
+
+    clip_notify_event_command_complete(&self, (void*)123, (struct clip_command*)456, 111);
+}
+
+TEST_F(ClipNotifyTest, clip_notify_event__masked)
+{
+    struct clip self = {};
+    self.event_callback = test_clip_event_callback;
+    self.event_mask = CLIP_EVENT_MASK(CLIP_EVENT_HELP) |
+        CLIP_EVENT_MASK(CLIP_EVENT_COMMAND_NOT_FOUND) |
+        CLIP_EVENT_MASK(CLIP_EVENT_CALL_COMMAND_CALLBACK) |
+        CLIP_EVENT_MASK(CLIP_EVENT_COMMAND_COMPLETE);
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(
+        &self,
+        CLIP_EVENT_ARGUMENTS_ERROR,
+        IsEqualClipEventArg_ArgumentsError((struct clip_command*)456, (clip_arg_error_t)111),
+        (void*)123)
+    );
+
+    clip_notify_event_help(&self, (void*)123, (struct clip_command*)456, (const struct clip_command **)789);
+    clip_notify_event_command_not_found(&self, (void*)123, (struct clip_command*)456, "test");
+    clip_notify_event_arguments_error(&self, (void*)123, (struct clip_command*)456, (clip_arg_error_t)111);
+    clip_notify_event_call_command_callback(&self, (void*)123, (struct clip_command*)456, "test");
+    clip_notify_event_command_complete(&self, (void*)123, (struct clip_command*)456, 111);
+}
+
+TEST_F(ClipNotifyTest, clip_notify_event__handlers)
+{
+    const struct clip_event_handlers handlers = {
+        test_clip_event_help,
+        test_clip_event_command_not_found,
+        test_clip_event_arguments_error,
+        test_clip_event_call_command_callback,
+        test_clip_event_command_complete,
+    };
+    struct clip self = {};
+    self.event_callback = test_clip_event_callback;
+    self.event_handlers = &handlers;
+
+    EXPECT_CALL(*ClipEventHandlers_Mock::get(), clip_event_help(&self, (struct clip_command*)456, (const struct clip_command **)789, (void*)123));
+    EXPECT_CALL(*ClipEventHandlers_Mock::get(), clip_event_command_not_found(&self, (struct clip_command*)456, StrEq("test"), (void*)123));
+    EXPECT_CALL(*ClipEventHandlers_Mock::get(), clip_event_arguments_error(&self, (struct clip_command*)456, (clip_arg_error_t)111, (void*)123));
+    EXPECT_CALL(*ClipEventHandlers_Mock::get(), clip_event_call_command_callback(&self, (struct clip_command*)456, StrEq("test"), (void*)123));
+    EXPECT_CALL(*ClipEventHandlers_Mock::get(), clip_event_command_complete(&self, (struct clip_command*)456, 111, (void*)123));
+
+    clip_notify_event_help(&self, (void*)123, (struct clip_command*)456, (const struct clip_command **)789);
+    clip_notify_event_command_not_found(&self, (void*)123, (struct clip_command*)456, "test");
+    clip_notify_event_arguments_error(&self, (void*)123, (struct clip_command*)456, (clip_arg_error_t)111);
+    clip_notify_event_call_command_callback(&self, (void*)123, (struct clip_command*)456, "test");
+    clip_notify_event_command_complete(&self, (void*)123, (struct clip_command*)456, 111);
+}
+
+TEST_F(ClipNotifyTest, clip_notify_event__handlersFallback)
+{
+    const struct clip_event_handlers handlers = {
+        NULL,
+        NULL,
+        test_clip_event_arguments_error,
+        NULL,
+        NULL,
+    };
+    struct clip self = {};
+    self.event_callback = test_clip_event_callback;
+    self.event_handlers = &handlers;
+    self.event_mask = CLIP_EVENT_MASK(CLIP_EVENT_CALL_COMMAND_CALLBACK);
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(
+        &self,
+        CLIP_EVENT_HELP,
+        IsEqualClipEventArg_Help((struct clip_command*)456, (struct clip_command **)789),
+        (void*)123)
+    );
+    EXPECT_CALL(*ClipEventHandlers_Mock::get(), clip_event_arguments_error(&self, (struct clip_command*)456, (clip_arg_error_t)111, (void*)123));
+
+    clip_notify_event_help(&self, (void*)123, (struct clip_command*)456, (const struct clip_command **)789);
+    clip_notify_event_arguments_error(&self, (void*)123, (struct clip_command*)456, (clip_arg_error_t)111);
+    clip_notify_event_call_command_callback(&self, (void*)123, (struct clip_command*)456, "test");
+}
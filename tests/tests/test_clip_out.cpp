@@ -0,0 +1,173 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock_clip_utils_hex.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::InSequence;
+
+class ClipOutTest : public Test
+{
+protected:
+    struct clip_out out;
+    char buf[8];
+
+    virtual void SetUp()
+    {
+        ClipUtilsHex_Mock::create();
+        ClipOutSink_Mock::create();
+
+        clip_out_init(&out, buf, sizeof(buf), test_clip_out_sink, (void*)123);
+    }
+
+    virtual void TearDown()
+    {
+        ClipUtilsHex_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+};
+
+TEST_F(ClipOutTest, clip_out_init)
+{
+    EXPECT_EQ(out.buf, buf);
+    EXPECT_EQ(out.buf_size, sizeof(buf));
+    EXPECT_EQ(out.len, 0U);
+    EXPECT_EQ(out.sink, test_clip_out_sink);
+    EXPECT_EQ(out.context, (void*)123);
+}
+
+TEST_F(ClipOutTest, clip_out_flush__once)
+{
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "ab12"));
+
+    clip_out_put_str(&out, "ab");
+    clip_out_put_u32(&out, 12);
+    clip_out_flush(&out);
+    clip_out_flush(&out);
+}
+
+TEST_F(ClipOutTest, clip_out_put_bytes__autoFlush)
+{
+    InSequence seq;
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "abcdef"));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "ghi"));
+
+    clip_out_put_str(&out, "abcdef");
+    clip_out_put_str(&out, "ghi");
+    clip_out_flush(&out);
+}
+
+TEST_F(ClipOutTest, clip_out_put_bytes__biggerThanBuffer)
+{
+    InSequence seq;
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "ab"));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "0123456789"));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "cd"));
+
+    clip_out_put_str(&out, "ab");
+    clip_out_put_str(&out, "0123456789");
+    clip_out_put_str(&out, "cd");
+    clip_out_flush(&out);
+}
+
+TEST_F(ClipOutTest, clip_out_put_u32)
+{
+    std::vector<std::tuple<uint32_t, std::string>> test_cases = {
+        {0, "0"},
+        {7, "7"},
+        {10, "10"},
+        {12345, "12345"},
+        {4294967295U, "4294967295"},
+    };
+
+    for (auto t : test_cases) {
+        EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, std::get<1>(t)));
+
+        clip_out_put_u32(&out, std::get<0>(t));
+        clip_out_flush(&out);
+    }
+}
+
+TEST_F(ClipOutTest, clip_out_put_hex)
+{
+    EXPECT_CALL(*ClipUtilsHex_Mock::get(), clip_utils_hex_from_buf(_, _, _))
+        .WillRepeatedly(Invoke([](char *hex, const uint8_t *buf, size_t buf_size)->bool {
+            while (buf_size-- > 0) {
+                snprintf(hex, 3, "%02X", *buf++);
+                hex += 2;
+            }
+            return true;
+        }));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "DEADBEEF0102"));
+
+    const uint8_t data[] = {0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02};
+    clip_out_init(&out, nullptr, 0, test_clip_out_sink, nullptr);
+    clip_out_put_hex(&out, data, sizeof(data));
+}
+
+TEST_F(ClipOutTest, clip_out_put_path)
+{
+    struct clip_command cmd_a = {};
+    struct clip_command cmd_b = {};
+    cmd_a.name = "abc";
+    cmd_b.name = "x";
+    const struct clip_path root = {nullptr, nullptr};
+    const struct clip_path path_a = {&cmd_a, nullptr};
+    const struct clip_path path_b = {&cmd_b, &path_a};
+
+    std::vector<std::tuple<const struct clip_path*, std::string>> test_cases = {
+        {&root, "."},
+        {&path_a, "abc"},
+        {&path_b, "abc x"},
+    };
+
+    for (auto t : test_cases) {
+        EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, std::get<1>(t)));
+
+        clip_out_put_path(&out, std::get<0>(t));
+        clip_out_flush(&out);
+    }
+}
+
+TEST_F(ClipOutTest, clip_out__null)
+{
+    const uint8_t data[] = {0x01};
+
+    clip_out_put_str(nullptr, "abc");
+    clip_out_put_u32(nullptr, 1);
+    clip_out_put_hex(nullptr, data, sizeof(data));
+    clip_out_put_bytes(nullptr, data, sizeof(data));
+    clip_out_flush(nullptr);
+}
@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock_clip_event_callback.hpp"
+#include "mock_clip_command_callback.hpp"
+#include "mock_clip_stream_callback.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::InSequence;
+
+extern "C" const struct clip g_clip;
+
+MATCHER_P(IsCommand_Name, cmd_name, "Equality matcher for command name")
+{
+    return strcmp(arg->name, cmd_name) == 0;
+}
+
+static int put_command_name(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    clip_out_put_str(out, cmd->name);
+    clip_out_put_str(out, ";");
+    return 0;
+}
+
+class ClipPipelineTest : public Test
+{
+protected:
+    char out_buf[64];
+    struct clip_out out;
+
+    virtual void SetUp()
+    {
+        ClipEventCallback_Mock::create();
+        ClipCommandCallback_Mock::create();
+        ClipStreamCallback_Mock::create();
+        ClipOutSink_Mock::create();
+
+        clip_out_init(&out, out_buf, sizeof(out_buf), test_clip_out_sink, nullptr);
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678))
+            .Times(::testing::AnyNumber());
+    }
+
+    virtual void TearDown()
+    {
+        ClipEventCallback_Mock::destroy();
+        ClipCommandCallback_Mock::destroy();
+        ClipStreamCallback_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+};
+
+TEST_F(ClipPipelineTest, clip_stream_feed__pipelinedLine)
+{
+    struct clip_stream stream;
+    char buf[64];
+    uint8_t chunk[4];
+    clip_stream_init(&stream, &g_clip, buf, sizeof(buf), chunk, sizeof(chunk));
+    stream.out = &out;
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    // streamed argument of not first command is passed in line (stream callbacks are called after line)
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, &out, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), std::vector<uint8_t>{0xAA, 0xBB}, &out, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 2, CLIP_ARG_ERROR_NO_ERROR, &out, (void*)12345678));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;read;"));
+
+    const char *line = "mem read 1 2;mem flash 1 AABB; mem read 3 4\n";
+    clip_stream_feed(&stream, line, strlen(line), (void*)12345678);
+}
+
+TEST_F(ClipPipelineTest, clip_poll__stopOnError)
+{
+    char queue_buf[2 * 64];
+    struct clip_queue queue;
+    clip_queue_init(&queue, queue_buf, 64, 2);
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_ARGUMENTS_ERROR, _, (void*)12345678));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke(put_command_name));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read;"));
+
+    const char *lines = "mem read 1 2; mem read x 2; mem read 3 4\nmem read 5 6\n";
+    clip_queue_push(&queue, lines, strlen(lines));
+    EXPECT_EQ(clip_poll(&g_clip, &queue, &out, (void*)12345678), 2U);
+}
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock_clip_event_callback.hpp"
+#include "mock_clip_command_callback.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Return;
+using ::testing::AnyNumber;
+
+extern "C" const struct clip g_clip;
+extern "C" const struct clip_command g_gpio_cmd;
+extern "C" struct clip_profile g_profile;
+
+static uint32_t g_time;
+static uint32_t g_time_step;
+
+extern "C" uint32_t test_clip_profile_time(void *context)
+{
+    EXPECT_EQ(context, (void*)123);
+    g_time += g_time_step;
+    return g_time;
+}
+
+class ClipProfileTest : public Test
+{
+protected:
+    struct clip_index_entry index_entries[16];
+    struct clip_index index;
+    struct clip_profile_entry entries[8];
+    struct clip_out out;
+    char out_buf[512];
+
+    virtual void SetUp()
+    {
+        ClipEventCallback_Mock::create();
+        ClipCommandCallback_Mock::create();
+        ClipOutSink_Mock::create();
+
+        g_time = 0;
+        g_time_step = 3;
+
+        ASSERT_TRUE(clip_index_init(&index, &g_clip, index_entries, 16));
+        ASSERT_EQ(index.count, 6);
+        clip_profile_init(&g_profile, &index, entries, index.count, test_clip_profile_time, (void*)123);
+        clip_out_init(&out, out_buf, sizeof(out_buf), test_clip_out_sink, nullptr);
+    }
+
+    virtual void TearDown()
+    {
+        ClipEventCallback_Mock::destroy();
+        ClipCommandCallback_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+
+    void parse(const char *line)
+    {
+        char buf[128];
+        strcpy(buf, line);
+        clip_cmd_parse_line_ex(&g_clip, NULL, buf, nullptr, nullptr, nullptr);
+    }
+};
+
+TEST_F(ClipProfileTest, clip_profile_record)
+{
+    std::vector<std::tuple<uint32_t, size_t>> test_cases = {
+        {0, 0},
+        {1, 1},
+        {2, 2},
+        {3, 2},
+        {4, 3},
+        {1000, 10},
+        {32767, 15},
+        {32768, 15},
+        {UINT32_MAX, 15},
+    };
+
+    for (auto t : test_cases) {
+        clip_profile_reset(&g_profile);
+        clip_profile_record(&g_profile, &g_gpio_cmd, CLIP_PROFILE_STAGE_ARGS, std::get<0>(t));
+        for (size_t i = 0; i < CLIP_CONFIG_PROFILE_BUCKETS; i++)
+            EXPECT_EQ(entries[1].buckets[CLIP_PROFILE_STAGE_ARGS][i], (i == std::get<1>(t)) ? 1 : 0);
+    }
+}
+
+TEST_F(ClipProfileTest, clip_profile_record__saturated)
+{
+    entries[0].buckets[CLIP_PROFILE_STAGE_LOOKUP][1] = UINT32_MAX;
+    clip_profile_record(&g_profile, nullptr, CLIP_PROFILE_STAGE_LOOKUP, 1);
+    EXPECT_EQ(entries[0].buckets[CLIP_PROFILE_STAGE_LOOKUP][1], UINT32_MAX);
+}
+
+TEST_F(ClipProfileTest, clip_profile_record__notProfiled)
+{
+    struct clip_profile_entry zero = {};
+
+    g_profile.entries_num = 1;
+    clip_profile_record(&g_profile, &g_gpio_cmd, CLIP_PROFILE_STAGE_ARGS, 1);
+    clip_profile_record(&g_profile, (struct clip_command*)&zero, CLIP_PROFILE_STAGE_ARGS, 1);
+
+    EXPECT_EQ(memcmp(&entries[1], &zero, sizeof(zero)), 0);
+}
+
+TEST_F(ClipProfileTest, clip_profile_lap)
+{
+    EXPECT_EQ(clip_profile_now(&g_profile), 3);
+    EXPECT_EQ(clip_profile_lap(&g_profile, nullptr, CLIP_PROFILE_STAGE_TOKENIZE, 0), 6);
+    EXPECT_EQ(entries[0].buckets[CLIP_PROFILE_STAGE_TOKENIZE][3], 1);
+}
+
+TEST_F(ClipProfileTest, clip_profile_dump)
+{
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(_, _, _, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(_, _, _, _, _, _))
+        .WillRepeatedly(Return(0));
+
+    parse("gpio set 1 0");
+    parse("gpio set 2 1");
+    g_time_step = 0;
+    parse("gpio get pin x");
+    parse("abc");
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out,
+        ". tokenize: 0:2 2+:2\n"
+        ". lookup: 0:2 2+:2\n"
+        "gpio tokenize: 0:1 2+:2\n"
+        "gpio lookup: 0:1 2+:2\n"
+        "gpio get tokenize: 0:1\n"
+        "gpio get lookup: 0:1\n"
+        "gpio get pin args: 0:1\n"
+        "gpio set args: 2+:2\n"
+        "gpio set callback: 2+:2\n"
+    ));
+
+    clip_profile_dump(&g_profile, &out);
+    clip_out_flush(&out);
+}
+
+TEST_F(ClipProfileTest, clip_profile_dump__empty)
+{
+    clip_profile_dump(&g_profile, &out);
+    clip_out_flush(&out);
+}
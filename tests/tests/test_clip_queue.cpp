@@ -0,0 +1,222 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "clip.h"
+
+#include "mock_clip_cmd_parse.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::InSequence;
+using ::testing::Return;
+
+class ClipQueueTest : public Test
+{
+protected:
+    virtual void SetUp()
+    {
+        ClipCmdParse_Mock::create();
+    }
+
+    virtual void TearDown()
+    {
+        ClipCmdParse_Mock::destroy();
+    }
+
+    void push(struct clip_queue *queue, const std::string &data)
+    {
+        clip_queue_push(queue, data.c_str(), data.length());
+    }
+
+    std::vector<std::string> drain(struct clip_queue *queue)
+    {
+        std::vector<std::string> lines;
+        char *line;
+        while ((line = clip_queue_front(queue)) != nullptr) {
+            lines.push_back(line);
+            clip_queue_pop(queue);
+        }
+        return lines;
+    }
+};
+
+TEST_F(ClipQueueTest, clip_queue_push__lines)
+{
+    char buf[4 * 16];
+    struct clip_queue queue;
+    clip_queue_init(&queue, buf, 16, 4);
+
+    EXPECT_EQ(clip_queue_front(&queue), nullptr);
+
+    push(&queue, "abc\r\n\n\r\nde");
+    EXPECT_EQ(drain(&queue), std::vector<std::string>({"abc"}));
+
+    push(&queue, "f 1\nxyz\n");
+    EXPECT_EQ(drain(&queue), std::vector<std::string>({"def 1", "xyz"}));
+
+    EXPECT_EQ(queue.dropped_full, 0U);
+    EXPECT_EQ(queue.dropped_long, 0U);
+    EXPECT_EQ(queue.max_depth, 2U);
+    EXPECT_EQ(queue.max_len, 5U);
+}
+
+TEST_F(ClipQueueTest, clip_queue_push__tooLong)
+{
+    char buf[2 * 8];
+    struct clip_queue queue;
+    clip_queue_init(&queue, buf, 8, 2);
+
+    push(&queue, "1234567\n12345678\nok\n");
+    EXPECT_EQ(drain(&queue), std::vector<std::string>({"1234567", "ok"}));
+
+    EXPECT_EQ(queue.dropped_long, 1U);
+    EXPECT_EQ(queue.dropped_full, 0U);
+    EXPECT_EQ(queue.max_len, 8U);
+}
+
+TEST_F(ClipQueueTest, clip_queue_push__full)
+{
+    char buf[2 * 8];
+    struct clip_queue queue;
+    clip_queue_init(&queue, buf, 8, 2);
+
+    push(&queue, "a\nb\nc");
+    EXPECT_EQ(clip_queue_front(&queue), std::string("a"));
+    clip_queue_pop(&queue);
+
+    // slot released in the middle of the line doesn't revive it
+    push(&queue, "cc\nd\n");
+    EXPECT_EQ(drain(&queue), std::vector<std::string>({"b", "d"}));
+
+    EXPECT_EQ(queue.dropped_full, 1U);
+    EXPECT_EQ(queue.dropped_long, 0U);
+    EXPECT_EQ(queue.max_depth, 2U);
+}
+
+TEST_F(ClipQueueTest, clip_queue__indexWrap)
+{
+    char buf[4 * 8];
+    struct clip_queue queue;
+    clip_queue_init(&queue, buf, 8, 4);
+
+    // indexes wrap from 0xFF to 0x100 (0x00 in single byte) while lines are waiting
+    queue.head = 0xFE;
+    queue.tail = 0xFE;
+
+    push(&queue, "a\nb\nc\nd\ne\n");
+    EXPECT_EQ(queue.head, 0x02);
+    EXPECT_EQ(queue.dropped_full, 1U);
+    EXPECT_EQ(queue.max_depth, 4U);
+    EXPECT_EQ(drain(&queue), std::vector<std::string>({"a", "b", "c", "d"}));
+    EXPECT_EQ(queue.tail, 0x02);
+    EXPECT_EQ(clip_queue_front(&queue), nullptr);
+
+    // many times around
+    for (size_t i = 0; i < 1000; i++) {
+        std::string line = std::to_string(i);
+        push(&queue, line + "\n");
+        ASSERT_EQ(drain(&queue), std::vector<std::string>({line}));
+    }
+    EXPECT_EQ(queue.dropped_full, 1U);
+}
+
+TEST_F(ClipQueueTest, clip_poll)
+{
+    char buf[4 * 16];
+    struct clip_queue queue;
+    clip_queue_init(&queue, buf, 16, 4);
+
+    push(&queue, "first\nsecond\nthi");
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipCmdParse_Mock::get(), clip_cmd_parse_line_ex((struct clip*)123, nullptr, _, (struct clip_out*)789, (void*)11223344, nullptr))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result) {
+            EXPECT_STREQ(cmd_line, "first");
+            return CLIP_STATUS_OK;
+        }));
+    EXPECT_CALL(*ClipCmdParse_Mock::get(), clip_cmd_parse_line_ex((struct clip*)123, nullptr, _, (struct clip_out*)789, (void*)11223344, nullptr))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, char *cmd_line, struct clip_out *out, void *context, struct clip_result *result) {
+            EXPECT_STREQ(cmd_line, "second");
+            return CLIP_STATUS_COMMAND_NOT_FOUND;
+        }));
+
+    EXPECT_EQ(clip_poll((struct clip*)123, &queue, (struct clip_out*)789, (void*)11223344), 2U);
+    EXPECT_EQ(clip_poll((struct clip*)123, &queue, (struct clip_out*)789, (void*)11223344), 0U);
+    EXPECT_EQ(clip_queue_front(&queue), nullptr);
+}
+
+TEST_F(ClipQueueTest, clip_queue__producerConsumer)
+{
+    const size_t lines_num = 100000;
+    char buf[8 * 16];
+    struct clip_queue queue;
+    clip_queue_init(&queue, buf, 16, 8);
+
+    std::thread producer([&]() {
+        for (size_t i = 0; i < lines_num; i++) {
+            std::string line = "line " + std::to_string(i) + "\n";
+            push(&queue, line);
+        }
+        // end marker must not be dropped
+        while ((clip_queue_index_t)(queue.head - queue.tail) >= 8)
+            std::this_thread::yield();
+        push(&queue, "end\n");
+    });
+
+    // every received line is complete and in order, missing lines are counted as dropped
+    size_t received = 0;
+    long last = -1;
+    bool end = false;
+    while (end == false) {
+        char *line = clip_queue_front(&queue);
+        if (line == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (std::string(line) == "end") {
+            end = true;
+        } else {
+            ASSERT_EQ(std::string(line, 5), "line ");
+            long index = std::stol(std::string(line + 5));
+            ASSERT_GT(index, last);
+            last = index;
+            received++;
+        }
+        clip_queue_pop(&queue);
+    }
+    producer.join();
+
+    EXPECT_EQ(received + queue.dropped_full, lines_num);
+    EXPECT_EQ(queue.dropped_long, 0U);
+    EXPECT_LE(queue.max_depth, 8U);
+}
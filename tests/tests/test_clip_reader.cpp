@@ -0,0 +1,131 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "clip.h"
+
+#include "mock_clip_cmd_parse.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::StrEq;
+
+class ClipReaderTest : public Test
+{
+protected:
+    virtual void SetUp()
+    {
+        ClipCmdParse_Mock::create();
+        ClipOutSink_Mock::create();
+    }
+
+    virtual void TearDown()
+    {
+        ClipCmdParse_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+
+    std::vector<std::string> put(struct clip_reader *reader, const std::string &data)
+    {
+        std::vector<std::string> lines;
+        for (auto ch : data) {
+            char *line = clip_reader_put_char(reader, ch);
+            if (line != nullptr)
+                lines.push_back(line);
+        }
+        return lines;
+    }
+};
+
+TEST_F(ClipReaderTest, clip_reader_put_char__lineEndings)
+{
+    char buf[16];
+    struct clip_reader reader;
+    clip_reader_init(&reader, buf, sizeof(buf), nullptr);
+
+    // empty lines are skipped
+    EXPECT_EQ(put(&reader, "abc\r\nd e\nf\r\rg\n\r\n"), std::vector<std::string>({"abc", "d e", "f", "g"}));
+    EXPECT_EQ(put(&reader, "h\ti"), std::vector<std::string>({}));
+    EXPECT_EQ(put(&reader, "\n"), std::vector<std::string>({"h\ti"}));
+}
+
+TEST_F(ClipReaderTest, clip_reader_put_char__backspace)
+{
+    char buf[16];
+    struct clip_reader reader;
+    clip_reader_init(&reader, buf, sizeof(buf), nullptr);
+
+    EXPECT_EQ(put(&reader, "\babx\b\x7F" "c\x1B\x01" "d\n"), std::vector<std::string>({"acd"}));
+}
+
+TEST_F(ClipReaderTest, clip_reader_put_char__tooLong)
+{
+    char buf[4];
+    struct clip_reader reader;
+    clip_reader_init(&reader, buf, sizeof(buf), nullptr);
+
+    EXPECT_EQ(put(&reader, "abc\nabcd\b\b\nab\n"), std::vector<std::string>({"abc", "ab"}));
+    EXPECT_EQ(reader.dropped_long, 1U);
+}
+
+TEST_F(ClipReaderTest, clip_reader_feed__echo)
+{
+    char buf[16];
+    char echo_buf[32];
+    struct clip_out echo;
+    struct clip_out out;
+    struct clip_reader reader;
+    clip_out_init(&echo, echo_buf, sizeof(echo_buf), test_clip_out_sink, nullptr);
+    clip_out_init(&out, nullptr, 0, nullptr, nullptr);
+    clip_reader_init(&reader, buf, sizeof(buf), &echo);
+
+    InSequence seq;
+
+    // echo is flushed before the line is dispatched, and at the end of data
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&echo, "ab\b \bc\r\n"));
+    EXPECT_CALL(*ClipCmdParse_Mock::get(), clip_cmd_parse_line_ex((const struct clip*)0x1234, nullptr, StrEq("ac"), &out, (void*)0x5678, nullptr))
+        .WillOnce(Return(CLIP_STATUS_OK));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&echo, "d"));
+
+    std::string data = "ab\bc\r\nd";
+    EXPECT_EQ(clip_reader_feed(&reader, (const struct clip*)0x1234, data.c_str(), data.length(), &out, (void*)0x5678), 1U);
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&echo, "\r\n"));
+    EXPECT_CALL(*ClipCmdParse_Mock::get(), clip_cmd_parse_line_ex((const struct clip*)0x1234, nullptr, StrEq("d"), &out, (void*)0x5678, nullptr))
+        .WillOnce(Return(CLIP_STATUS_OK));
+    // empty line is echoed, but it's not dispatched
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&echo, "\r\n"));
+
+    data = "\n\n";
+    EXPECT_EQ(clip_reader_feed(&reader, (const struct clip*)0x1234, data.c_str(), data.length(), &out, (void*)0x5678), 1U);
+}
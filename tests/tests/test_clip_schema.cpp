@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+using ::testing::Test;
+
+extern "C" const struct clip g_clip;
+extern "C" const struct clip g_shared_clip;
+
+extern "C" int test_clip_command_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    return 0;
+}
+
+class ClipSchemaTest : public Test
+{
+protected:
+    std::string output;
+    struct clip_out out;
+    char out_buf[8];
+    struct clip_index_entry entries[16];
+    struct clip_index index;
+
+    virtual void SetUp()
+    {
+        ASSERT_TRUE(clip_index_init(&index, &g_clip, entries, 16));
+        clip_out_init(&out, out_buf, sizeof(out_buf), [](struct clip_out *self, const char *data, size_t size) {
+            static_cast<std::string*>(self->context)->append(data, size);
+        }, &output);
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+TEST_F(ClipSchemaTest, clip_schema_put_json)
+{
+    clip_schema_put_json(&out, &index);
+    clip_out_flush(&out);
+
+    EXPECT_EQ(output,
+        "{\"version\":1,\"help\":\"?\",\"commands\":["
+            "{\"id\":1,\"name\":\"gpio\",\"description\":\"gpio commands\",\"commands\":["
+                "{\"id\":2,\"name\":\"set\",\"description\":\"set pin\",\"callable\":true,\"args\":["
+                    "{\"name\":\"pin\",\"description\":\"pin number\",\"type\":\"UINT\"},"
+                    "{\"name\":\"state\",\"type\":\"BOOL\",\"optional\":true}"
+                "]}"
+            "]},"
+            "{\"id\":3,\"name\":\"echo\",\"description\":\"say \\\"hi\\\"\\u000a\",\"callable\":true,\"args\":["
+                "{\"name\":\"data\",\"type\":\"HEXARRAY\",\"check\":\"CRC32\"},"
+                "{\"name\":\"crc\",\"type\":\"UINT\"}"
+            "]}"
+        "]}");
+
+    clip_schema_put_json(nullptr, &index);
+}
+
+TEST_F(ClipSchemaTest, clip_schema_put_binary)
+{
+    clip_schema_put_binary(&out, &index);
+    clip_out_flush(&out);
+
+    std::string expected = std::string("CLSC\x01?\0", 7) +
+        std::string("\x02\x00", 2) +
+            std::string("\x01\x00", 2) + std::string("gpio\0gpio commands\0\x00\x00\x00", 22) +
+            std::string("\x01\x00", 2) +
+                std::string("\x02\x00", 2) + std::string("set\0set pin\0\x01\x02\x00", 15) +
+                    std::string("pin\0pin number\0", 15) + std::string("\x03\x00\x00", 3) +
+                    std::string("state\0\0", 7) + std::string("\x01\x00\x01", 3) +
+                std::string("\x00\x00", 2) +
+            std::string("\x03\x00", 2) + std::string("echo\0say \"hi\"\n\0\x01\x02\x00", 18) +
+                std::string("data\0\0", 6) + std::string("\x05\x02\x00", 3) +
+                std::string("crc\0\0", 5) + std::string("\x03\x00\x00", 3) +
+            std::string("\x00\x00", 2);
+
+    EXPECT_EQ(output, expected);
+
+    clip_schema_put_binary(nullptr, &index);
+}
+
+TEST_F(ClipSchemaTest, clip_schema_sharedCommand)
+{
+    struct clip_index_entry shared_entries[8];
+    struct clip_index shared_index;
+    ASSERT_TRUE(clip_index_init(&shared_index, &g_shared_clip, shared_entries, 8));
+
+    // "ver" is written twice with the same ID, "ping" is the 4th written command, but has ID 3
+    clip_schema_put_json(&out, &shared_index);
+    clip_out_flush(&out);
+
+    EXPECT_EQ(output,
+        "{\"version\":1,\"help\":\"?\",\"commands\":["
+            "{\"id\":1,\"name\":\"ver\",\"callable\":true},"
+            "{\"id\":2,\"name\":\"alias\",\"commands\":["
+                "{\"id\":1,\"name\":\"ver\",\"callable\":true}"
+            "]},"
+            "{\"id\":3,\"name\":\"ping\",\"callable\":true}"
+        "]}");
+
+    output.clear();
+    clip_schema_put_binary(&out, &shared_index);
+    clip_out_flush(&out);
+
+    std::string expected = std::string("CLSC\x01?\0", 7) +
+        std::string("\x03\x00", 2) +
+            std::string("\x01\x00" "ver\0\0\x01\x00\x00\x00\x00", 12) +
+            std::string("\x02\x00" "alias\0\0\x00\x00\x00", 12) +
+            std::string("\x01\x00", 2) +
+                std::string("\x01\x00" "ver\0\0\x01\x00\x00\x00\x00", 12) +
+            std::string("\x03\x00" "ping\0\0\x01\x00\x00\x00\x00", 13);
+
+    EXPECT_EQ(output, expected);
+}
@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "clip.h"
+
+#include "mock_clip_command_callback.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+
+MATCHER_P(IsCommand_Name, cmd_name, "Equality matcher for command name")
+{
+    return strcmp(arg->name, cmd_name) == 0;
+}
+
+class ClipSectionTest : public Test
+{
+protected:
+    virtual void SetUp()
+    {
+        ClipCommandCallback_Mock::create();
+    }
+
+    virtual void TearDown()
+    {
+        ClipCommandCallback_Mock::destroy();
+    }
+};
+
+static std::vector<std::string> names(const struct clip_command **commands)
+{
+    std::vector<std::string> result;
+    while (*commands != nullptr)
+        result.push_back((*commands++)->name);
+    return result;
+}
+
+TEST_F(ClipSectionTest, init)
+{
+    struct clip clip = {};
+
+    EXPECT_TRUE(clip_section_init(&clip));
+    EXPECT_EQ(clip.commands_num, 4);
+    EXPECT_EQ(names(clip.commands), (std::vector<std::string>{"adc", "beta", "mem", "zeta"}));
+    EXPECT_EQ(clip.commands[4], nullptr);
+
+    EXPECT_TRUE(clip_section_init(&clip));
+    EXPECT_EQ(names(clip.commands), (std::vector<std::string>{"adc", "beta", "mem", "zeta"}));
+}
+
+TEST_F(ClipSectionTest, dispatch)
+{
+    struct clip clip = {};
+
+    ASSERT_TRUE(clip_section_init(&clip));
+
+    std::vector<std::tuple<std::string, std::optional<std::string>, clip_status_t>> test_cases = {
+        {"adc", "adc", CLIP_STATUS_OK},
+        {"beta", "beta", CLIP_STATUS_OK},
+        {"zeta", "zeta", CLIP_STATUS_OK},
+        {"mem read 0x100", "read", CLIP_STATUS_OK},
+        {"aaa", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"bet", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"zz", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+        {"mem write", std::nullopt, CLIP_STATUS_COMMAND_NOT_FOUND},
+    };
+
+    for (auto &t : test_cases) {
+        char line[64];
+        struct clip_result result = {};
+        strcpy(line, std::get<0>(t).c_str());
+
+        if (std::get<1>(t).has_value()) {
+            EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&clip, IsCommand_Name(std::get<1>(t).value().c_str()), _, _, _, nullptr))
+                .WillOnce(Return(0));
+        }
+        EXPECT_EQ(clip_cmd_parse_line_ex(&clip, nullptr, line, nullptr, nullptr, &result), std::get<2>(t)) << std::get<0>(t);
+        ::testing::Mock::VerifyAndClearExpectations(ClipCommandCallback_Mock::get());
+    }
+}
@@ -0,0 +1,46 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+extern int test_clip_command_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
+
+CLIP_DEF_ROOT_COMMAND(g_zeta_cmd, "zeta", "last command", test_clip_command_callback)
+CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_zeta_cmd)
+
+CLIP_DEF_ROOT_COMMAND(g_mem_cmd, "mem", "memory commands", NULL)
+    CLIP_DEF_COMMAND("read", "read command", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("address", "address argument", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_mem_cmd)
+
+CLIP_DEF_ROOT_COMMAND(g_adc_cmd, "adc", "adc commands", test_clip_command_callback)
+CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_adc_cmd)
+
+CLIP_DEF_ROOT_COMMAND(g_beta_cmd, "beta", "beta command", test_clip_command_callback)
+CLIP_DEF_ROOT_COMMAND_END()
+CLIP_REGISTER_ROOT_COMMAND(g_beta_cmd)
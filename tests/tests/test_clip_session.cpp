@@ -0,0 +1,193 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <string>
+
+#include "clip.h"
+
+using ::testing::Test;
+
+extern "C" const struct clip g_clip;
+
+struct SessionContext {
+    std::string output;
+    size_t calls;
+    size_t errors;
+};
+
+extern "C" void test_clip_session_event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context)
+{
+    if (event == CLIP_EVENT_COMMAND_NOT_FOUND || event == CLIP_EVENT_ARGUMENTS_ERROR)
+        static_cast<SessionContext*>(context)->errors++;
+}
+
+extern "C" int test_clip_session_add_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    static_cast<SessionContext*>(context)->calls++;
+    clip_out_put_u32(out, argv[0].val_uint + argv[1].val_uint);
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+extern "C" int test_clip_session_echo_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)
+{
+    static_cast<SessionContext*>(context)->calls++;
+    clip_out_put_str(out, argv[0].val_str);
+    clip_out_put_str(out, "\n");
+    return 0;
+}
+
+static void test_clip_session_sink(struct clip_out *self, const char *data, size_t size)
+{
+    static_cast<SessionContext*>(self->context)->output.append(data, size);
+}
+
+class ClipSessionTest : public Test
+{
+protected:
+    struct Session {
+        SessionContext ctx{};
+        char buf[64];
+        uint8_t chunk[8];
+        char out_buf[16];
+        struct clip_session session;
+
+        Session()
+        {
+            clip_session_init(&session, &g_clip, buf, sizeof(buf), chunk, sizeof(chunk), out_buf, sizeof(out_buf), test_clip_session_sink, &ctx);
+        }
+    };
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+TEST_F(ClipSessionTest, clip_session_init)
+{
+    Session s;
+
+    EXPECT_EQ(s.session.clip, &g_clip);
+    EXPECT_EQ(s.session.context, &s.ctx);
+    EXPECT_EQ(s.session.stream.clip, &g_clip);
+    EXPECT_EQ(s.session.stream.out, &s.session.out);
+    EXPECT_EQ(s.session.out.context, &s.ctx);
+    EXPECT_EQ(s.session.out.buf, s.out_buf);
+}
+
+TEST_F(ClipSessionTest, clip_session_dispatch)
+{
+    Session s;
+    char line[64];
+    struct clip_result result;
+
+    strcpy(line, "math add 2 3");
+    EXPECT_EQ(clip_session_dispatch(&s.session, line, &result), CLIP_STATUS_OK);
+    EXPECT_EQ(result.status, CLIP_STATUS_OK);
+    EXPECT_EQ(s.ctx.output, "5\n");
+
+    strcpy(line, "math sub 2 3");
+    EXPECT_EQ(clip_session_dispatch(&s.session, line, nullptr), CLIP_STATUS_COMMAND_NOT_FOUND);
+    EXPECT_EQ(s.ctx.errors, 1);
+    EXPECT_EQ(s.ctx.calls, 1);
+}
+
+TEST_F(ClipSessionTest, clip_session_feed)
+{
+    Session s;
+
+    clip_session_feed(&s.session, "echo \"hello world\"\nmath a", 25);
+    EXPECT_EQ(s.ctx.output, "hello world\n");
+    clip_session_feed(&s.session, "dd 10 20\r\n", 10);
+    EXPECT_EQ(s.ctx.output, "hello world\n30\n");
+    EXPECT_EQ(s.ctx.calls, 2);
+}
+
+TEST_F(ClipSessionTest, clip_session_concurrent)
+{
+    // many sessions share one const tree, every session is used by its own thread
+    // (this test is built with ThreadSanitizer when compiler supports it)
+    const size_t threads_num = 8;
+    const size_t lines_num = 2000;
+
+    std::vector<Session> sessions(threads_num);
+    std::vector<std::thread> threads;
+    std::vector<std::string> expected(threads_num);
+
+    for (size_t t = 0; t < threads_num; t++) {
+        threads.emplace_back([&, t]() {
+            Session &s = sessions[t];
+            std::string input;
+
+            for (size_t i = 0; i < lines_num; i++) {
+                std::string line;
+                switch (i % 4) {
+                case 0:
+                    line = "math add " + std::to_string(t) + " " + std::to_string(i);
+                    expected[t] += std::to_string(t + i) + "\n";
+                    break;
+                case 1:
+                    line = "echo t" + std::to_string(t) + "_" + std::to_string(i);
+                    expected[t] += "t" + std::to_string(t) + "_" + std::to_string(i) + "\n";
+                    break;
+                case 2:
+                    line = "math mul 1 2";
+                    break;
+                default:
+                    line = "math add x 1";
+                    break;
+                }
+
+                if (i & 1) {
+                    // part of lines is assembled by session stream reader, in thread-specific chunks
+                    input = line + "\n";
+                    for (size_t pos = 0; pos < input.size(); pos += t + 1)
+                        clip_session_feed(&s.session, &input[pos], std::min(t + 1, input.size() - pos));
+                } else {
+                    char buf[64];
+                    strcpy(buf, line.c_str());
+                    clip_session_dispatch(&s.session, buf, nullptr);
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < threads_num; t++) {
+        EXPECT_EQ(sessions[t].ctx.output, expected[t]);
+        EXPECT_EQ(sessions[t].ctx.calls, lines_num / 2);
+        EXPECT_EQ(sessions[t].ctx.errors, lines_num / 2);
+    }
+}
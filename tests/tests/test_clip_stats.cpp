@@ -0,0 +1,145 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock_clip_event_callback.hpp"
+#include "mock_clip_command_callback.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Return;
+using ::testing::AnyNumber;
+
+extern "C" const struct clip g_clip;
+extern "C" const struct clip_command g_gpio_cmd;
+extern "C" const struct clip_command g_echo_cmd;
+extern "C" struct clip_stats g_stats;
+
+class ClipStatsTest : public Test
+{
+protected:
+    struct clip_index_entry index_entries[16];
+    struct clip_index index;
+    struct clip_stats_entry entries[8];
+    struct clip_out out;
+    char out_buf[512];
+
+    virtual void SetUp()
+    {
+        ClipEventCallback_Mock::create();
+        ClipCommandCallback_Mock::create();
+        ClipOutSink_Mock::create();
+
+        ASSERT_TRUE(clip_index_init(&index, &g_clip, index_entries, 16));
+        clip_stats_init(&g_stats, &index, entries, index.count);
+        clip_out_init(&out, out_buf, sizeof(out_buf), test_clip_out_sink, nullptr);
+    }
+
+    virtual void TearDown()
+    {
+        ClipEventCallback_Mock::destroy();
+        ClipCommandCallback_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+
+    clip_status_t parse(const char *line)
+    {
+        char buf[128];
+        strcpy(buf, line);
+        return clip_cmd_parse_line_ex(&g_clip, NULL, buf, &out, nullptr, nullptr);
+    }
+};
+
+TEST_F(ClipStatsTest, clip_stats_inc)
+{
+    clip_stats_inc(&g_stats, &g_echo_cmd, CLIP_STATS_COUNTER_CALLS);
+    clip_stats_inc(&g_stats, &g_echo_cmd, CLIP_STATS_COUNTER_CALLS);
+    clip_stats_inc(&g_stats, nullptr, CLIP_STATS_COUNTER_NOT_FOUND);
+
+    const struct clip_stats_entry *entry = clip_stats_get(&g_stats, &g_echo_cmd);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->counters[CLIP_STATS_COUNTER_CALLS], 2);
+    EXPECT_EQ(entry->counters[CLIP_STATS_COUNTER_ARGUMENTS_ERRORS], 0);
+    EXPECT_EQ(entry->counters[CLIP_STATS_COUNTER_NOT_FOUND], 0);
+
+    entry = clip_stats_get(&g_stats, nullptr);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->counters[CLIP_STATS_COUNTER_NOT_FOUND], 1);
+
+    clip_stats_reset(&g_stats);
+    EXPECT_EQ(clip_stats_get(&g_stats, &g_echo_cmd)->counters[CLIP_STATS_COUNTER_CALLS], 0);
+}
+
+TEST_F(ClipStatsTest, clip_stats_inc__saturated)
+{
+    entries[0].counters[CLIP_STATS_COUNTER_NOT_FOUND] = UINT32_MAX;
+    clip_stats_inc(&g_stats, nullptr, CLIP_STATS_COUNTER_NOT_FOUND);
+    EXPECT_EQ(entries[0].counters[CLIP_STATS_COUNTER_NOT_FOUND], UINT32_MAX);
+}
+
+TEST_F(ClipStatsTest, clip_stats_inc__notCounted)
+{
+    g_stats.entries_num = 1;
+    clip_stats_inc(&g_stats, &g_echo_cmd, CLIP_STATS_COUNTER_CALLS);
+    clip_stats_inc(&g_stats, (struct clip_command*)&index, CLIP_STATS_COUNTER_CALLS);
+
+    EXPECT_EQ(clip_stats_get(&g_stats, &g_echo_cmd), nullptr);
+    EXPECT_EQ(entries[5].counters[CLIP_STATS_COUNTER_CALLS], 0);
+}
+
+TEST_F(ClipStatsTest, clip_stats__command)
+{
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(_, _, _, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(_, _, _, _, _, _))
+        .WillRepeatedly(Return(0));
+
+    EXPECT_EQ(parse("gpio set 1 0"), CLIP_STATUS_OK);
+    EXPECT_EQ(parse("gpio set 2 1"), CLIP_STATUS_OK);
+    EXPECT_EQ(parse("gpio set x"), CLIP_STATUS_ARGUMENTS_ERROR);
+    EXPECT_EQ(parse("gpio get pin 3"), CLIP_STATUS_OK);
+    EXPECT_EQ(parse("gpio xyz"), CLIP_STATUS_COMMAND_NOT_FOUND);
+    EXPECT_EQ(parse("abc"), CLIP_STATUS_COMMAND_NOT_FOUND);
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out,
+        ".: not_found=1\n"
+        "gpio: not_found=1\n"
+        "gpio get pin: calls=1\n"
+        "gpio set: calls=2 arg_errors=1\n"
+    ));
+
+    EXPECT_EQ(parse("stats"), CLIP_STATUS_OK);
+}
+
+TEST_F(ClipStatsTest, clip_stats__commandOnlyInRoot)
+{
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(_, CLIP_EVENT_COMMAND_NOT_FOUND, _, _));
+
+    EXPECT_EQ(parse("gpio stats"), CLIP_STATUS_COMMAND_NOT_FOUND);
+}
@@ -0,0 +1,310 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock_clip_event_callback.hpp"
+#include "mock_clip_command_callback.hpp"
+#include "mock_clip_stream_callback.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::InSequence;
+using ::testing::AnyNumber;
+
+extern "C" const struct clip g_clip;
+extern "C" const struct clip_command g_mem_cmd;
+
+MATCHER_P(IsCommand_Name, cmd_name, "Equality matcher for command name")
+{
+    return strcmp(arg->name, cmd_name) == 0;
+}
+
+class ClipStreamTest : public Test
+{
+protected:
+    struct clip_stream stream;
+    char buf[16];
+    uint8_t chunk[4];
+
+    virtual void SetUp()
+    {
+        ClipEventCallback_Mock::create();
+        ClipCommandCallback_Mock::create();
+        ClipStreamCallback_Mock::create();
+        ClipOutSink_Mock::create();
+
+        clip_stream_init(&stream, &g_clip, buf, sizeof(buf), chunk, sizeof(chunk));
+    }
+
+    virtual void TearDown()
+    {
+        ClipEventCallback_Mock::destroy();
+        ClipCommandCallback_Mock::destroy();
+        ClipStreamCallback_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+
+    void feed(const std::string &data, bool char_by_char)
+    {
+        if (char_by_char) {
+            for (auto ch : data)
+                clip_stream_feed(&stream, &ch, 1, (void*)12345678);
+        } else {
+            clip_stream_feed(&stream, data.c_str(), data.length(), (void*)12345678);
+        }
+    }
+};
+
+TEST_F(ClipStreamTest, clip_stream_feed__chunkedData)
+{
+    for (bool char_by_char : {false, true}) {
+        InSequence seq;
+
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, _, (void*)12345678))
+            .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context) {
+                EXPECT_EQ(argv[0].type, CLIP_ARG_TYPE_UINT);
+                EXPECT_EQ(argv[0].val_uint, 0x100U);
+            }));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), std::vector<uint8_t>{0x01, 0x02}, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 6, CLIP_ARG_ERROR_NO_ERROR, _, (void*)12345678));
+
+        feed("mem flash 0x100 DEADBEEF0102\r\n", char_by_char);
+    }
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__dataBiggerThanLineBuffer)
+{
+    std::string hex;
+    for (int i = 0; i < 64; i++)
+        hex += "A5";
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), std::vector<uint8_t>(4, 0xA5), _, (void*)12345678))
+        .Times(16);
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 64, CLIP_ARG_ERROR_NO_ERROR, _, (void*)12345678));
+
+    feed("mem flash 1 " + hex + " ignored tail\n", false);
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__regularLine)
+{
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678));
+
+    feed("mem read 1 2\n", true);
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__invalidData)
+{
+    {
+        InSequence seq;
+
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 0, CLIP_ARG_ERROR_PARSE_HEXARRAY, _, (void*)12345678));
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+        EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678));
+    }
+
+    feed("mem flash 1 DEADBEEX01\nmem read 1 2\n", false);
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__oddData)
+{
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 0, CLIP_ARG_ERROR_PARSE_HEXARRAY, _, (void*)12345678));
+
+    feed("mem flash 1 DEADBEE\n", false);
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__argumentsError)
+{
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_ARGUMENTS_ERROR, IsEqualClipEventArg_ArgumentsError(g_mem_cmd.commands[0], CLIP_ARG_ERROR_PARSE_UINT), (void*)12345678));
+
+    feed("mem flash x DEADBEEF\n", false);
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__tooLongLine)
+{
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, _, (void*)12345678));
+
+    feed("mem read 0x00000001 0x00000002\nmem read 1 2\n", false);
+}
+
+TEST_F(ClipStreamTest, clip_cmd_parse_line__wholeStreamedArgument)
+{
+    char line[64] = "mem flash 1 DEADBEEF0102";
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02}, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 6, CLIP_ARG_ERROR_NO_ERROR, _, (void*)12345678));
+
+    clip_cmd_parse_line(&g_clip, NULL, line, (void*)12345678);
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__checkedData)
+{
+    for (bool char_by_char : {false, true}) {
+        InSequence seq;
+
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("verify"), 0, _, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("verify"), std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("verify"), std::vector<uint8_t>{0x01, 0x02}, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("verify"), 6, CLIP_ARG_ERROR_NO_ERROR, _, (void*)12345678));
+
+        feed("mem verify DEADBEEF0102 0xB9477982\r\n", char_by_char);
+    }
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__repeatedSpaces)
+{
+    // spaces before data and before checksum are skipped, like in clip_cmd_parse_line
+    for (bool char_by_char : {false, true}) {
+        InSequence seq;
+
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), std::vector<uint8_t>{0xAB, 0xCD}, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 2, CLIP_ARG_ERROR_NO_ERROR, _, (void*)12345678));
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("verify"), 0, _, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("verify"), std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("verify"), std::vector<uint8_t>{0x01, 0x02}, _, (void*)12345678));
+        EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("verify"), 6, CLIP_ARG_ERROR_NO_ERROR, _, (void*)12345678));
+
+        feed("mem flash 100  ABCD\n", char_by_char);
+        feed("mem verify   DEADBEEF0102   0xB9477982\n", char_by_char);
+    }
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__checksumMismatch)
+{
+    InSequence seq;
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("verify"), 0, _, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("verify"), std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("verify"), 4, CLIP_ARG_ERROR_CHECKSUM, _, (void*)12345678));
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("verify"), 0, _, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("verify"), std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("verify"), 4, CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS, _, (void*)12345678));
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("verify"), 0, _, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("verify"), std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("verify"), 4, CLIP_ARG_ERROR_PARSE_UINT, _, (void*)12345678));
+
+    feed("mem verify DEADBEEF 0x12345678\n", false);
+    feed("mem verify DEADBEEF\n", false);
+    feed("mem verify DEADBEEF crc\n", false);
+}
+
+TEST_F(ClipStreamTest, clip_cmd_parse_line__checkedArgument)
+{
+    char line_ok[64] = "mem write 1 DEADBEEF 0x4097";
+    char line_bad[64] = "mem write 1 DEADBEEF 0x4098";
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("write"), 3, _, _, (void*)12345678));
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_ARGUMENTS_ERROR, IsEqualClipEventArg_ArgumentsError(g_mem_cmd.commands[2], CLIP_ARG_ERROR_CHECKSUM), (void*)12345678));
+
+    clip_cmd_parse_line(&g_clip, NULL, line_ok, (void*)12345678);
+    clip_cmd_parse_line(&g_clip, NULL, line_bad, (void*)12345678);
+}
+
+TEST_F(ClipStreamTest, clip_cmd_parse_line__missingChecksum)
+{
+    char line[64] = "mem write 1 DEADBEEF";
+    struct clip_result result = {};
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, _, _, (void*)12345678)).Times(AnyNumber());
+
+    EXPECT_EQ(clip_cmd_parse_line_ex(&g_clip, NULL, line, NULL, (void*)12345678, &result), CLIP_STATUS_ARGUMENTS_ERROR);
+    EXPECT_EQ(result.error, CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS);
+}
+
+TEST_F(ClipStreamTest, clip_cmd_parse_line__invalidChecksumLayout)
+{
+    // checked binary argument without required checksum argument is rejected (checksum could be omitted)
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, _, _, (void*)12345678)).Times(AnyNumber());
+
+    for (const char *cmd_line : {"mem store DEADBEEF 0x4097", "mem store DEADBEEF", "mem load DEADBEEF"}) {
+        char line[64];
+        strcpy(line, cmd_line);
+        EXPECT_DEATH(clip_cmd_parse_line(&g_clip, NULL, line, (void*)12345678), "clip_utils_arg_has_checksum") << cmd_line;
+    }
+}
+
+TEST_F(ClipStreamTest, clip_stream_feed__responseFlushedOnce)
+{
+    char out_buf[32];
+    struct clip_out out;
+    clip_out_init(&out, out_buf, sizeof(out_buf), test_clip_out_sink, nullptr);
+    stream.out = &out;
+
+    InSequence seq;
+
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(&g_clip, IsCommand_Name("read"), 2, _, &out, (void*)12345678))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context)->int {
+            clip_out_put_str(out, "read ");
+            clip_out_put_u32(out, argv[0].val_uint);
+            clip_out_put_str(out, "\n");
+            return 0;
+        }));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "read 1\n"));
+    EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(&g_clip, CLIP_EVENT_CALL_COMMAND_CALLBACK, _, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_begin_callback(&g_clip, IsCommand_Name("flash"), 1, _, &out, (void*)12345678));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_data_callback(&g_clip, IsCommand_Name("flash"), std::vector<uint8_t>{0xDE, 0xAD}, &out, (void*)12345678))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, std::vector<uint8_t> data, struct clip_out *out, void *context) {
+            clip_out_put_str(out, "data ");
+        }));
+    EXPECT_CALL(*ClipStreamCallback_Mock::get(), clip_stream_end_callback(&g_clip, IsCommand_Name("flash"), 2, CLIP_ARG_ERROR_NO_ERROR, &out, (void*)12345678))
+        .WillOnce(Invoke([](const struct clip *self, const struct clip_command *cmd, size_t size, clip_arg_error_t error, struct clip_out *out, void *context) {
+            clip_out_put_str(out, "end\n");
+        }));
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, "data end\n"));
+
+    feed("mem read 1 2\nmem flash 1 DEAD\n", false);
+}
@@ -0,0 +1,68 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "clip.h"
+
+extern void test_clip_event_callback(const struct clip *self, clip_event_t event, union clip_event_arg *event_arg, void *context);
+extern int test_clip_command_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
+extern void test_clip_stream_begin_callback(const struct clip *self, const struct clip_command *cmd, size_t argc, struct clip_arg_value argv[], struct clip_out *out, void *context);
+extern void test_clip_stream_data_callback(const struct clip *self, const struct clip_command *cmd, const uint8_t *data, size_t size, struct clip_out *out, void *context);
+extern void test_clip_stream_end_callback(const struct clip *self, const struct clip_command *cmd, size_t size, clip_arg_error_t error, struct clip_out *out, void *context);
+
+const struct clip_arg_stream g_stream = {
+    .begin = test_clip_stream_begin_callback,
+    .data = test_clip_stream_data_callback,
+    .end = test_clip_stream_end_callback,
+};
+
+CLIP_DEF_ROOT_COMMAND(g_mem_cmd, "mem", "memory commands", NULL)
+    CLIP_DEF_COMMAND("flash", "flash command", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("address", "address argument", CLIP_ARG_TYPE_UINT)
+        CLIP_DEF_STREAM_ARGUMENT("data", "data argument", &g_stream)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+    CLIP_DEF_COMMAND("read", "read command", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("address", "address argument", CLIP_ARG_TYPE_UINT)
+        CLIP_DEF_ARGUMENT("size", "size argument", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+    CLIP_DEF_COMMAND("write", "write command", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_ARGUMENT("address", "address argument", CLIP_ARG_TYPE_UINT)
+        CLIP_DEF_CHECKED_ARGUMENT("data", "data argument", CLIP_ARG_TYPE_HEXARRAY, CLIP_ARG_CHECK_CRC16)
+        CLIP_DEF_ARGUMENT("crc", "checksum argument", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+    CLIP_DEF_COMMAND("verify", "verify command", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_CHECKED_STREAM_ARGUMENT("data", "data argument", &g_stream, CLIP_ARG_CHECK_CRC32)
+        CLIP_DEF_ARGUMENT("crc", "checksum argument", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+    CLIP_DEF_COMMAND("store", "checksum may be omitted (invalid layout)", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_CHECKED_ARGUMENT("data", "data argument", CLIP_ARG_TYPE_HEXARRAY, CLIP_ARG_CHECK_CRC16)
+        CLIP_DEF_OPT_ARGUMENT("crc", "checksum argument", CLIP_ARG_TYPE_UINT)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+    CLIP_DEF_COMMAND("load", "no checksum argument (invalid layout)", test_clip_command_callback) CLIP_DEF_WITH_ARGS()
+        CLIP_DEF_CHECKED_ARGUMENT("data", "data argument", CLIP_ARG_TYPE_HEXARRAY, CLIP_ARG_CHECK_CRC16)
+    CLIP_DEF_COMMAND_END_WITH_ARGS()
+CLIP_DEF_ROOT_COMMAND_END()
+
+CLIP_DEF_ROOT(g_clip, (void*)11223344, test_clip_event_callback)
+    CLIP_DEF_ADD_ROOT_COMMAND(&g_mem_cmd)
+CLIP_DEF_ROOT_END()
@@ -0,0 +1,220 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+#include "mock_clip_event_callback.hpp"
+#include "mock_clip_command_callback.hpp"
+#include "mock_clip_out_sink.hpp"
+
+using ::testing::_;
+using ::testing::Test;
+using ::testing::Return;
+using ::testing::AnyNumber;
+
+extern "C" const struct clip g_clip;
+extern "C" const struct clip_command g_gpio_cmd;
+extern "C" const struct clip_command g_echo_cmd;
+extern "C" struct clip_trace g_trace;
+extern "C" const struct clip g_shared_clip;
+
+static uint32_t g_time;
+
+extern "C" uint32_t test_clip_trace_time(void *context)
+{
+    EXPECT_EQ(context, (void*)123);
+    return ++g_time;
+}
+
+MATCHER_P4(IsTraceRecord, timestamp, event, id, code, "Equality matcher for clip_trace_record")
+{
+    return std::tie(arg.timestamp, arg.event, arg.id, arg.code) == std::make_tuple((uint32_t)timestamp, (uint8_t)event, (uint16_t)id, (int32_t)code);
+}
+
+class ClipTraceTest : public Test
+{
+protected:
+    struct clip_index_entry index_entries[16];
+    struct clip_index index;
+    struct clip_trace_record records[8];
+    struct clip_out out;
+    char out_buf[512];
+
+    virtual void SetUp()
+    {
+        ClipEventCallback_Mock::create();
+        ClipCommandCallback_Mock::create();
+        ClipOutSink_Mock::create();
+
+        g_time = 0;
+
+        ASSERT_TRUE(clip_index_init(&index, &g_clip, index_entries, 16));
+        clip_trace_init(&g_trace, &index, records, 8, test_clip_trace_time, (void*)123);
+        clip_out_init(&out, out_buf, sizeof(out_buf), test_clip_out_sink, nullptr);
+
+        EXPECT_CALL(*ClipEventCallback_Mock::get(), clip_event_callback(_, _, _, _))
+            .Times(AnyNumber());
+    }
+
+    virtual void TearDown()
+    {
+        ClipEventCallback_Mock::destroy();
+        ClipCommandCallback_Mock::destroy();
+        ClipOutSink_Mock::destroy();
+    }
+
+    void parse(const char *line)
+    {
+        char buf[128];
+        strcpy(buf, line);
+        clip_cmd_parse_line_ex(&g_clip, NULL, buf, nullptr, nullptr, nullptr);
+    }
+
+    std::vector<struct clip_trace_record> read()
+    {
+        std::vector<struct clip_trace_record> v(8);
+        v.resize(clip_trace_read(&g_trace, v.data(), v.size()));
+        return v;
+    }
+};
+
+TEST_F(ClipTraceTest, clip_trace__dispatch)
+{
+    EXPECT_CALL(*ClipCommandCallback_Mock::get(), clip_command_callback(_, _, _, _, _, _))
+        .WillOnce(Return(-7));
+
+    parse("gpio set 1 0");
+
+    EXPECT_THAT(read(), testing::ElementsAre(
+        IsTraceRecord(1, CLIP_TRACE_EVENT_LINE, 0, 0),
+        IsTraceRecord(2, CLIP_TRACE_EVENT_LOOKUP, 1, 0),
+        IsTraceRecord(3, CLIP_TRACE_EVENT_LOOKUP, 4, 0),
+        IsTraceRecord(4, CLIP_TRACE_EVENT_ARGS, 4, CLIP_ARG_ERROR_NO_ERROR),
+        IsTraceRecord(5, CLIP_TRACE_EVENT_CALLBACK, 4, -7),
+        IsTraceRecord(6, CLIP_TRACE_EVENT_DONE, 4, CLIP_STATUS_COMMAND_ERROR)
+    ));
+}
+
+TEST_F(ClipTraceTest, clip_trace__errors)
+{
+    parse("gpio xyz");
+
+    EXPECT_THAT(read(), testing::ElementsAre(
+        IsTraceRecord(1, CLIP_TRACE_EVENT_LINE, 0, 0),
+        IsTraceRecord(2, CLIP_TRACE_EVENT_LOOKUP, 1, 0),
+        IsTraceRecord(3, CLIP_TRACE_EVENT_NOT_FOUND, 1, 0),
+        IsTraceRecord(4, CLIP_TRACE_EVENT_DONE, 1, CLIP_STATUS_COMMAND_NOT_FOUND)
+    ));
+
+    parse("gpio ?");
+    parse("echo");
+
+    // oldest records are overwritten
+    EXPECT_THAT(read(), testing::ElementsAre(
+        IsTraceRecord(5, CLIP_TRACE_EVENT_LINE, 0, 0),
+        IsTraceRecord(6, CLIP_TRACE_EVENT_LOOKUP, 1, 0),
+        IsTraceRecord(7, CLIP_TRACE_EVENT_HELP, 1, 0),
+        IsTraceRecord(8, CLIP_TRACE_EVENT_DONE, 1, CLIP_STATUS_HELP),
+        IsTraceRecord(9, CLIP_TRACE_EVENT_LINE, 0, 0),
+        IsTraceRecord(10, CLIP_TRACE_EVENT_LOOKUP, 5, 0),
+        IsTraceRecord(11, CLIP_TRACE_EVENT_ARGS, 5, CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS),
+        IsTraceRecord(12, CLIP_TRACE_EVENT_DONE, 5, CLIP_STATUS_ARGUMENTS_ERROR)
+    ));
+
+    std::vector<struct clip_trace_record> v(2);
+    v.resize(clip_trace_read(&g_trace, v.data(), v.size()));
+    EXPECT_THAT(v, testing::ElementsAre(
+        IsTraceRecord(11, CLIP_TRACE_EVENT_ARGS, 5, CLIP_ARG_ERROR_NOT_ENOUGH_ARGUMENTS),
+        IsTraceRecord(12, CLIP_TRACE_EVENT_DONE, 5, CLIP_STATUS_ARGUMENTS_ERROR)
+    ));
+}
+
+TEST_F(ClipTraceTest, clip_trace__complete)
+{
+    struct clip_pending token = {};
+
+    clip_cmd_pend(&token, &g_clip, &g_echo_cmd, nullptr, nullptr);
+    clip_cmd_complete(&token, 3);
+
+    EXPECT_THAT(read(), testing::ElementsAre(
+        IsTraceRecord(1, CLIP_TRACE_EVENT_COMPLETE, 5, 3)
+    ));
+}
+
+TEST_F(ClipTraceTest, clip_trace_dump)
+{
+    clip_trace_write(&g_trace, CLIP_TRACE_EVENT_CALLBACK, &g_gpio_cmd, -2);
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, std::string(
+        "CLTR" "\x01" "\x0C" "\x06\x00" "\x01\x00\x00\x00"
+        ".\0" "gpio\0" "gpio get\0" "gpio get pin\0" "gpio set\0" "echo\0"
+        "\x01\x00\x00\x00" "\xFE\xFF\xFF\xFF" "\x01\x00" "\x05" "\x00",
+        4 + 1 + 1 + 2 + 4 + 2 + 5 + 9 + 13 + 9 + 5 + 12
+    )));
+
+    clip_trace_dump(&g_trace, &out);
+    clip_out_flush(&out);
+}
+
+TEST_F(ClipTraceTest, clip_trace_dump__sharedCommand)
+{
+    struct clip_index_entry entries[8];
+    struct clip_index shared_index;
+    struct clip_trace trace;
+
+    ASSERT_TRUE(clip_index_init(&shared_index, &g_shared_clip, entries, 8));
+    clip_trace_init(&trace, &shared_index, records, 8, test_clip_trace_time, (void*)123);
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, std::string(
+        "CLTR" "\x01" "\x0C" "\x03\x00" "\x00\x00\x00\x00"
+        ".\0" "echo\0" "alias\0",
+        4 + 1 + 1 + 2 + 4 + 2 + 5 + 6
+    )));
+
+    clip_trace_dump(&trace, &out);
+    clip_out_flush(&out);
+}
+
+TEST_F(ClipTraceTest, clip_trace_dump__indexFull)
+{
+    struct clip_index_entry entries[4];
+    struct clip_index small_index;
+    struct clip_trace trace;
+
+    // only "gpio", "gpio get" and "gpio get pin" fit in index
+    EXPECT_FALSE(clip_index_init(&small_index, &g_clip, entries, 4));
+    clip_trace_init(&trace, &small_index, records, 8, test_clip_trace_time, (void*)123);
+
+    EXPECT_CALL(*ClipOutSink_Mock::get(), clip_out_sink(&out, std::string(
+        "CLTR" "\x01" "\x0C" "\x04\x00" "\x00\x00\x00\x00"
+        ".\0" "gpio\0" "gpio get\0" "gpio get pin\0",
+        4 + 1 + 1 + 2 + 4 + 2 + 5 + 9 + 13
+    )));
+
+    clip_trace_dump(&trace, &out);
+    clip_out_flush(&out);
+}
@@ -135,6 +135,32 @@ TEST_F(ClipUtilsArgTest, clip_utils_arg_get_first__withEscapeChar)
     }
 }
 
+TEST_F(ClipUtilsArgTest, clip_utils_arg_split_command)
+{
+    std::vector<std::tuple<std::string, std::string, std::optional<std::string>>> test_cases = {
+        {"test 123",                    "test 123",             std::nullopt},
+        {"",                            "",                     std::nullopt},
+        {"a 1;b 2",                     "a 1",                  "b 2"},
+        {"a 1; b 2; c",                 "a 1",                  " b 2; c"},
+        {";",                           "",                     ""},
+        {"echo \"x;y\";b",              "echo \"x;y\"",         "b"},
+        {"echo x\\;y;b",                "echo x\\;y",           "b"},
+        {"echo \"x\\\";y\";b",           "echo \"x\\\";y\"",      "b"},
+    };
+
+    for (auto t : test_cases) {
+        std::string line = std::get<0>(t);
+        char *next = clip_utils_arg_split_command(line.data());
+        EXPECT_STREQ(line.c_str(), std::get<1>(t).c_str());
+        if (std::get<2>(t).has_value()) {
+            ASSERT_NE(next, nullptr);
+            EXPECT_STREQ(next, std::get<2>(t).value().c_str());
+        } else {
+            EXPECT_EQ(next, nullptr);
+        }
+    }
+}
+
 TEST_F(ClipUtilsArgTest, clip_utils_arg_get_type_string)
 {
     EXPECT_STREQ(clip_utils_arg_get_type_string(CLIP_ARG_TYPE_STRING), "STRING");
@@ -143,7 +169,8 @@ TEST_F(ClipUtilsArgTest, clip_utils_arg_get_type_string)
     EXPECT_STREQ(clip_utils_arg_get_type_string(CLIP_ARG_TYPE_UINT), "UINT");
     EXPECT_STREQ(clip_utils_arg_get_type_string(CLIP_ARG_TYPE_FLOAT), "FLOAT");
     EXPECT_STREQ(clip_utils_arg_get_type_string(CLIP_ARG_TYPE_HEXARRAY), "HEXARRAY");
-    EXPECT_STREQ(clip_utils_arg_get_type_string((clip_arg_type_t)(CLIP_ARG_TYPE_HEXARRAY + 1)), "UNKNOWN");
+    EXPECT_STREQ(clip_utils_arg_get_type_string(CLIP_ARG_TYPE_HEXSTREAM), "HEXSTREAM");
+    EXPECT_STREQ(clip_utils_arg_get_type_string((clip_arg_type_t)(CLIP_ARG_TYPE_HEXSTREAM + 1)), "UNKNOWN");
 }
 
 TEST_F(ClipUtilsArgTest, clip_utils_arg_get_error_string)
@@ -155,7 +182,9 @@ TEST_F(ClipUtilsArgTest, clip_utils_arg_get_error_string)
     EXPECT_STREQ(clip_utils_arg_get_error_string(CLIP_ARG_ERROR_PARSE_UINT), "UNSIGNED INTEGER PARSING ERROR");
     EXPECT_STREQ(clip_utils_arg_get_error_string(CLIP_ARG_ERROR_PARSE_FLOAT), "FLOAT NUMBER PARSING ERROR");
     EXPECT_STREQ(clip_utils_arg_get_error_string(CLIP_ARG_ERROR_PARSE_HEXARRAY), "ASCII HEX ARRAY PARSING ERROR");
-    EXPECT_STREQ(clip_utils_arg_get_error_string((clip_arg_error_t)(CLIP_ARG_ERROR_PARSE_HEXARRAY + 1)), "UNKNOWN");
+    EXPECT_STREQ(clip_utils_arg_get_error_string(CLIP_ARG_ERROR_CHECKSUM), "CHECKSUM MISMATCH");
+    EXPECT_STREQ(clip_utils_arg_get_error_string(CLIP_ARG_ERROR_TYPE_MISMATCH), "TYPE MISMATCH");
+    EXPECT_STREQ(clip_utils_arg_get_error_string((clip_arg_error_t)(CLIP_ARG_ERROR_TYPE_MISMATCH + 1)), "UNKNOWN");
 }
 
 TEST_F(ClipUtilsArgTest, clip_utils_arg_update_buf)
@@ -186,12 +215,12 @@ TEST_F(ClipUtilsArgTest, clip_utils_arg_get_command_usage_string)
     char buf[256];
 
     std::array<const struct clip_arg, 6> args = {
-        clip_arg { "str", nullptr, CLIP_ARG_TYPE_STRING, false },
-        clip_arg { "bool", nullptr, CLIP_ARG_TYPE_BOOL, false },
-        clip_arg { "int", nullptr, CLIP_ARG_TYPE_INT, false },
-        clip_arg { "uint", nullptr, CLIP_ARG_TYPE_UINT, false },
-        clip_arg { "float", nullptr, CLIP_ARG_TYPE_FLOAT, true },
-        clip_arg { "hex", nullptr, CLIP_ARG_TYPE_HEXARRAY, true },
+        clip_arg { "str", nullptr, CLIP_ARG_TYPE_STRING, false, nullptr, CLIP_ARG_CHECK_NONE },
+        clip_arg { "bool", nullptr, CLIP_ARG_TYPE_BOOL, false, nullptr, CLIP_ARG_CHECK_NONE },
+        clip_arg { "int", nullptr, CLIP_ARG_TYPE_INT, false, nullptr, CLIP_ARG_CHECK_NONE },
+        clip_arg { "uint", nullptr, CLIP_ARG_TYPE_UINT, false, nullptr, CLIP_ARG_CHECK_NONE },
+        clip_arg { "float", nullptr, CLIP_ARG_TYPE_FLOAT, true, nullptr, CLIP_ARG_CHECK_NONE },
+        clip_arg { "hex", nullptr, CLIP_ARG_TYPE_HEXARRAY, true, nullptr, CLIP_ARG_CHECK_NONE },
         
     };
 
@@ -208,11 +237,83 @@ TEST_F(ClipUtilsArgTest, clip_utils_arg_get_command_usage_string)
             &args.at(4),
             &args.at(5),
             nullptr
-        }).data()
+        }).data(),
+        nullptr,
+        0
     };
 
     size_t size_out = clip_utils_arg_get_command_usage_string(buf, sizeof(buf), &cmd);
     EXPECT_EQ(std::string(buf, buf + size_out), "command <str:STRING> <bool:BOOL> <int:INT> <uint:UINT> [float:FLOAT] [hex:HEXARRAY]");
+    EXPECT_EQ(std::string(buf), "command <str:STRING> <bool:BOOL> <int:INT> <uint:UINT> [float:FLOAT] [hex:HEXARRAY]");
+
+    char small[12];
+    memset(small, 'x', sizeof(small));
+    size_out = clip_utils_arg_get_command_usage_string(small, sizeof(small), &cmd);
+    EXPECT_EQ(size_out, std::string("command <str:STRING> <bool:BOOL> <int:INT> <uint:UINT> [float:FLOAT] [hex:HEXARRAY]").length());
+    EXPECT_EQ(std::string(small), "command <st");
+
+    const struct clip_command cmd_no_args = { "command", nullptr, nullptr, nullptr, nullptr, nullptr, 0 };
+    size_out = clip_utils_arg_get_command_usage_string(buf, sizeof(buf), &cmd_no_args);
+    EXPECT_EQ(std::string(buf, buf + size_out), "command");
+
+    size_out = clip_utils_arg_get_command_usage_string(nullptr, 0, &cmd_no_args);
+    EXPECT_EQ(size_out, 7);
+}
+
+TEST_F(ClipUtilsArgTest, clip_utils_arg_get_command_usage_string_precomputed)
+{
+    char buf[256];
+
+    const struct clip_arg arg = { "a", nullptr, CLIP_ARG_TYPE_INT, false, nullptr, CLIP_ARG_CHECK_NONE };
+    const struct clip_command cmd = {
+        "command",
+        nullptr,
+        nullptr,
+        nullptr,
+        (const struct clip_arg**)(std::array<const struct clip_arg*, 2> {
+            &arg,
+            nullptr
+        }).data(),
+        "command <value:INT>",
+        0
+    };
+
+    // precomputed usage has priority over arguments descriptors
+    size_t size_out = clip_utils_arg_get_command_usage_string(buf, sizeof(buf), &cmd);
+    EXPECT_EQ(std::string(buf, buf + size_out), "command <value:INT>");
+}
+
+TEST_F(ClipUtilsArgTest, clip_utils_arg_put_command_usage)
+{
+    std::string output;
+    char buf[4];
+    struct clip_out out;
+
+    const struct clip_arg arg_a = { "a", nullptr, CLIP_ARG_TYPE_UINT, false, nullptr, CLIP_ARG_CHECK_NONE };
+    const struct clip_arg arg_b = { "b", nullptr, CLIP_ARG_TYPE_HEXSTREAM, true, nullptr, CLIP_ARG_CHECK_NONE };
+    const struct clip_command cmd = {
+        "command",
+        nullptr,
+        nullptr,
+        nullptr,
+        (const struct clip_arg**)(std::array<const struct clip_arg*, 3> {
+            &arg_a,
+            &arg_b,
+            nullptr
+        }).data(),
+        nullptr,
+        0
+    };
+
+    clip_out_init(&out, buf, sizeof(buf), [](struct clip_out *self, const char *data, size_t size) {
+        static_cast<std::string*>(self->context)->append(data, size);
+    }, &output);
+
+    clip_utils_arg_put_command_usage(&out, &cmd);
+    clip_out_flush(&out);
+    EXPECT_EQ(output, "command <a:UINT> [b:HEXSTREAM]");
+
+    clip_utils_arg_put_command_usage(nullptr, &cmd);
 }
 
 TEST_F(ClipUtilsArgTest, clip_utils_arg_unpack_hexarray)
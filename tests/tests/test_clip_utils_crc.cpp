@@ -0,0 +1,75 @@
+/*
+MIT License
+
+Copyright (c) 2024 Marcin Borowicz <marcinbor85@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "clip.h"
+
+using ::testing::_;
+using ::testing::Test;
+
+class ClipUtilsCrcTest : public Test
+{
+protected:
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+TEST_F(ClipUtilsCrcTest, clip_utils_crc_calc)
+{
+    const std::string check_str{"123456789"};
+    const uint8_t *check_data = (const uint8_t*)check_str.c_str();
+
+    std::vector<std::tuple<clip_arg_check_t, std::vector<uint8_t>, uint32_t>> test_cases = {
+        {CLIP_ARG_CHECK_NONE, std::vector<uint8_t>(check_data, check_data + check_str.length()), 0U},
+        {CLIP_ARG_CHECK_CRC16, std::vector<uint8_t>{}, 0xFFFFU},
+        {CLIP_ARG_CHECK_CRC16, std::vector<uint8_t>(check_data, check_data + check_str.length()), 0x29B1U},
+        {CLIP_ARG_CHECK_CRC16, std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}, 0x4097U},
+        {CLIP_ARG_CHECK_CRC32, std::vector<uint8_t>{}, 0x00000000U},
+        {CLIP_ARG_CHECK_CRC32, std::vector<uint8_t>(check_data, check_data + check_str.length()), 0xCBF43926U},
+        {CLIP_ARG_CHECK_CRC32, std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02}, 0xB9477982U},
+    };
+
+    for (auto t : test_cases) {
+        EXPECT_EQ(clip_utils_crc_calc(std::get<0>(t), std::get<1>(t).data(), std::get<1>(t).size()), std::get<2>(t));
+    }
+}
+
+TEST_F(ClipUtilsCrcTest, clip_utils_crc_update)
+{
+    const std::string check_str{"123456789"};
+
+    for (auto check : {CLIP_ARG_CHECK_CRC16, CLIP_ARG_CHECK_CRC32}) {
+        uint32_t crc = clip_utils_crc_init(check);
+        for (auto ch : check_str)
+            crc = clip_utils_crc_update(check, crc, (uint8_t)ch);
+        EXPECT_EQ(clip_utils_crc_final(check, crc), clip_utils_crc_calc(check, (const uint8_t*)check_str.c_str(), check_str.length()));
+    }
+}
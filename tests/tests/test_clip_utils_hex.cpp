@@ -171,3 +171,38 @@ TEST_F(ClipUtilsHexTest, clip_utils_hex_to_buf)
         }
     }
 }
+
+TEST_F(ClipUtilsHexTest, clip_utils_hex_decoder_feed)
+{
+    std::vector<std::tuple<std::string, std::optional<std::vector<uint8_t>>>> test_cases = {
+        {"", std::vector<uint8_t>{}},
+        {"0", std::vector<uint8_t>{}},
+        {"01", std::vector<uint8_t>{0x01}},
+        {"012", std::vector<uint8_t>{0x01}},
+        {"DEADBEEF", std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}},
+        {"deadbeef", std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF}},
+        {"DEADBEEG", std::nullopt},
+        {"X", std::nullopt},
+    };
+
+    for (auto t : test_cases) {
+        struct clip_hex_decoder decoder;
+        uint8_t buf[128] = {};
+        size_t buf_len = 0;
+        bool success = true;
+
+        clip_utils_hex_decoder_reset(&decoder);
+        for (auto ch : std::get<0>(t)) {
+            success = clip_utils_hex_decoder_feed(&decoder, buf, &buf_len, ch);
+            if (success == false)
+                break;
+        }
+        if (std::get<1>(t).has_value()) {
+            EXPECT_TRUE(success);
+            EXPECT_EQ(std::vector<uint8_t>(buf, buf + buf_len), std::get<1>(t).value());
+            EXPECT_EQ(decoder.half, (std::get<0>(t).length() & 1) != 0);
+        } else {
+            EXPECT_FALSE(success);
+        }
+    }
+}
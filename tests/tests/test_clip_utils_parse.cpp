@@ -28,6 +28,7 @@ SOFTWARE.
 #include "clip.h"
 
 #include "mock_clip_utils_hex.hpp"
+#include "mock_clip_utils_crc.hpp"
 
 using ::testing::_;
 using ::testing::Test;
@@ -40,10 +41,12 @@ protected:
     virtual void SetUp()
     {
         ClipUtilsHex_Mock::create();
+        ClipUtilsCrc_Mock::create();
     }
 
     virtual void TearDown()
     {
+        ClipUtilsCrc_Mock::destroy();
         ClipUtilsHex_Mock::destroy();
     }
 };
@@ -214,3 +217,53 @@ TEST_F(ClipUtilsParseTest, clip_utils_parse_hexarray)
         }
     }
 }
+
+TEST_F(ClipUtilsParseTest, clip_utils_parse_hexarray_crc)
+{
+    EXPECT_CALL(*ClipUtilsHex_Mock::get(), clip_utils_hex_to_buf(_, _, _)).
+        WillRepeatedly(Invoke([](uint8_t *buf, const char *hex, size_t hex_size)->bool {
+            while (hex_size > 0) {
+                if (!isxdigit(hex[0]) || !isxdigit(hex[1]))
+                    return false;
+                const std::string s{hex, hex + 2};
+                *buf++ = std::stoi(s.c_str(), 0, 16);
+                hex += 2;
+                hex_size -= 2;
+            }
+            return true;
+        }));
+    EXPECT_CALL(*ClipUtilsCrc_Mock::get(), clip_utils_crc_init(CLIP_ARG_CHECK_CRC32)).
+        WillRepeatedly(Return(0x100));
+    EXPECT_CALL(*ClipUtilsCrc_Mock::get(), clip_utils_crc_update(CLIP_ARG_CHECK_CRC32, _, _)).
+        WillRepeatedly(Invoke([](clip_arg_check_t check, uint32_t crc, const uint8_t byte)->uint32_t {
+            (void)check;
+            return (crc << 1) + byte;
+        }));
+    EXPECT_CALL(*ClipUtilsCrc_Mock::get(), clip_utils_crc_final(CLIP_ARG_CHECK_CRC32, _)).
+        WillRepeatedly(Invoke([](clip_arg_check_t check, uint32_t crc)->uint32_t {
+            (void)check;
+            return ~crc;
+        }));
+
+    std::vector<std::tuple<std::string, std::optional<uint32_t>>> test_cases = {
+        {"", ~0x100U},
+        {"0", std::nullopt},
+        {"01", ~0x201U},
+        {"0102", ~0x404U},
+        {"0102030405", ~0x2039U},
+        {"01020304G5", std::nullopt},
+    };
+
+    for (auto t : test_cases) {
+        clip_arg_value val {};
+        uint32_t crc = 0;
+        bool success = clip_utils_parse_hexarray_crc(&val, (char*)std::get<0>(t).c_str(), CLIP_ARG_CHECK_CRC32, &crc);
+        if (std::get<1>(t).has_value()) {
+            EXPECT_TRUE(success);
+            EXPECT_EQ(val.type, CLIP_ARG_TYPE_HEXARRAY);
+            EXPECT_EQ(crc, std::get<1>(t).value());
+        } else {
+            EXPECT_FALSE(success);
+        }
+    }
+}